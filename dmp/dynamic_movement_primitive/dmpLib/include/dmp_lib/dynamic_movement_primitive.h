@@ -579,6 +579,20 @@ public:
    */
   bool setThetas(const std::vector<Eigen::VectorXd>& thetas);
 
+  /*! Sets the activation below which the kernels of all transformation systems are truncated to zero.
+   * A cutoff of 0.0 disables truncation.
+   * @param kernel_cutoff
+   * @return True on success, otherwise False
+   * THIS FUNCTION IS NOT REAL-TIME FRIENDLY
+   */
+  bool setKernelCutoff(const double kernel_cutoff);
+
+  /*! Gets the kernel cutoff of each transformation system dimension
+   * @param kernel_cutoffs
+   * @return True on success, otherwise False
+   */
+  bool getKernelCutoffs(std::vector<double>& kernel_cutoffs) const;
+
   /*! Sets the basis functions provided the generated input vector using the current
    * parameters of the canonical system of length num_time_steps.
    * @param num_time_steps
@@ -689,6 +703,10 @@ protected:
    */
   std::vector<std::pair<int, int> > indices_;
 
+  /*! Feedback used when propagating without feedback (size equals number of dimensions)
+   */
+  Eigen::VectorXd zero_feedback_;
+
 private:
 
   /*!
@@ -723,8 +741,6 @@ private:
   bool logDebugTrajectory(Trajectory& debug_trajectory);
   std::vector<int> debug_dimensions_;
 
-  Eigen::VectorXd zero_feedback_;
-
 };
 
 /*! Abbreviation for convinience
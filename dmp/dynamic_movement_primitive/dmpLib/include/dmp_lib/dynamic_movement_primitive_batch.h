@@ -0,0 +1,131 @@
+/*********************************************************************
+ Computational Learning and Motor Control Lab
+ University of Southern California
+ Prof. Stefan Schaal
+ *********************************************************************
+ \remarks		...
+
+ \file		dynamic_movement_primitive_batch.h
+
+ \date		Oct 17, 2026
+
+ *********************************************************************/
+
+#ifndef DYNAMIC_MOVEMENT_PRIMITIVE_BATCH_H_
+#define DYNAMIC_MOVEMENT_PRIMITIVE_BATCH_H_
+
+// system includes
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <Eigen/Core>
+
+// local includes
+#include <dmp_lib/status.h>
+
+namespace dmp_lib
+{
+
+/*! Propagates many rollouts of the same DMP, each with its own thetas, start, goal and duration.
+ * The rollouts are distributed over a pool of threads (OpenMP), each thread owns a private copy
+ * of the DMP. Results are written into preallocated matrices instead of one Trajectory per rollout.
+ *
+ * The output matrices are of size (num_samples x (num_rollouts * num_dimensions)), the data of
+ * dimension d of rollout r is stored in column (r * num_dimensions + d). If a rollout finishes before
+ * num_samples samples have been generated, its remaining rows are set to zero.
+ *
+ * DMPType is either ICRA2009DynamicMovementPrimitive or NC2010DynamicMovementPrimitive.
+ */
+template<class DMPType>
+  class DynamicMovementPrimitiveBatch : public Status
+  {
+
+  public:
+
+    /*! Constructor
+     */
+    DynamicMovementPrimitiveBatch() :
+      num_dimensions_(0) {};
+
+    /*! Destructor
+     */
+    virtual ~DynamicMovementPrimitiveBatch() {};
+
+    /*! Creates a copy of the (learned) dmp for each thread
+     * @param dmp
+     * @param num_threads If 0, the number of available processors is used
+     * @return True on success, otherwise False
+     */
+    bool initialize(const DMPType& dmp,
+                    const int num_threads = 0);
+
+    /*! Propagates all rollouts.
+     * @param thetas (num_rollouts) thetas of each transformation system dimension
+     * @param starts (num_rollouts) start of each rollout
+     * @param goals (num_rollouts) goal of each rollout
+     * @param durations (num_rollouts) movement duration of each rollout
+     * @param num_samples Number of samples generated for each rollout
+     * @param positions Needs to be of size (num_samples x (num_rollouts * num_dimensions))
+     * @param velocities Needs to be of size (num_samples x (num_rollouts * num_dimensions))
+     * @param accelerations Needs to be of size (num_samples x (num_rollouts * num_dimensions))
+     * @return True on success, otherwise False
+     */
+    bool propagateFull(const std::vector<std::vector<Eigen::VectorXd> >& thetas,
+                       const std::vector<Eigen::VectorXd>& starts,
+                       const std::vector<Eigen::VectorXd>& goals,
+                       const std::vector<double>& durations,
+                       const int num_samples,
+                       Eigen::MatrixXd& positions,
+                       Eigen::MatrixXd& velocities,
+                       Eigen::MatrixXd& accelerations);
+
+    /*!
+     * @return Number of threads (and therefore dmp copies) used to propagate the rollouts
+     */
+    int getNumThreads() const
+    {
+      return static_cast<int> (dmps_.size());
+    }
+
+    /*!
+     * @return Number of dimensions of the dmp
+     */
+    int getNumDimensions() const
+    {
+      return num_dimensions_;
+    }
+
+  private:
+
+    /*!
+     */
+    int num_dimensions_;
+
+    /*! One dmp for each thread
+     */
+    std::vector<boost::shared_ptr<DMPType> > dmps_;
+
+    /*! Preallocated buffers, one for each thread
+     */
+    std::vector<Eigen::VectorXd> desired_positions_;
+    std::vector<Eigen::VectorXd> desired_velocities_;
+    std::vector<Eigen::VectorXd> desired_accelerations_;
+
+    /*! Propagates a single rollout using the dmp of thread thread_index
+     * @return True on success, otherwise False
+     */
+    bool propagateRollout(const int thread_index,
+                          const int rollout_index,
+                          const std::vector<Eigen::VectorXd>& thetas,
+                          const Eigen::VectorXd& start,
+                          const Eigen::VectorXd& goal,
+                          const double duration,
+                          const int num_samples,
+                          Eigen::MatrixXd& positions,
+                          Eigen::MatrixXd& velocities,
+                          Eigen::MatrixXd& accelerations);
+
+  };
+
+}
+
+#endif /* DYNAMIC_MOVEMENT_PRIMITIVE_BATCH_H_ */
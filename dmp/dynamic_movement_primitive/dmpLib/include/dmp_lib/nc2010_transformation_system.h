@@ -130,6 +130,35 @@ private:
    */
   std::vector<NC2010TSStatePtr> states_;
 
+  /*! Packed (structure-of-arrays) copy of the gains and states of all dimensions. The state objects
+   * remain the authoritative representation: they are gathered into these arrays at the beginning of
+   * integrate() and scattered back at the end, in between all dimensions are integrated at once.
+   */
+  Eigen::ArrayXd packed_k_gains_;
+  Eigen::ArrayXd packed_d_gains_;
+  Eigen::ArrayXd packed_goals_;
+  Eigen::ArrayXd packed_starts_;
+  Eigen::ArrayXd packed_x_;
+  Eigen::ArrayXd packed_xd_;
+  Eigen::ArrayXd packed_xdd_;
+  Eigen::ArrayXd packed_internal_xd_;
+  Eigen::ArrayXd packed_internal_xdd_;
+  Eigen::ArrayXd packed_f_;
+
+  /*! Allocates the packed arrays and copies the (constant) gains
+   */
+  void initializePackedStates();
+
+  /*! Gathers goal, start and current states of all dimensions into the packed arrays
+   * REAL-TIME REQUIREMENTS
+   */
+  void packStates();
+
+  /*! Scatters the packed arrays back into the states of all dimensions
+   * REAL-TIME REQUIREMENTS
+   */
+  void unpackStates();
+
 };
 
 /*! Abbreviation for convinience
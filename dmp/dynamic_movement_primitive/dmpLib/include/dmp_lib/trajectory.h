@@ -18,6 +18,7 @@
 // system include
 #include <string>
 #include <vector>
+#include <stdint.h>
 #include <boost/shared_ptr.hpp>
 #include <Eigen/Core>
 
@@ -50,7 +51,9 @@ public:
     trajectory_dimension_(0),
     index_to_last_trajectory_point_(0),
     sampling_frequency_(0.0),
-    trajectory_duration_(0.0) {};
+    trajectory_duration_(0.0),
+    fixed_capacity_(false),
+    max_num_extra_points_(0) {};
 
   /*! Destructor
    */
@@ -68,6 +71,31 @@ public:
                   const bool positions_only = false,
                   const int trajectory_length = MAX_TRAJECTORY_LENGTH);
 
+  /*! Reserves all memory needed by add, computeDerivatives, and crop such that subsequent calls of these
+   * functions do not allocate memory. In this mode, computeDerivatives operates on the contained samples and
+   * does not change the capacity of the trajectory. The mode is reset when the trajectory is (re-)initialized.
+   * @param max_num_extra_points Maximum number of extra points that will be passed to computeDerivatives
+   * @return True on success, otherwise False
+   * THIS FUNCTION IS NOT REAL-TIME FRIENDLY
+   */
+  bool reserveFixedCapacity(const int max_num_extra_points = 0);
+
+  /*!
+   * @return True if all memory has been reserved using reserveFixedCapacity, otherwise False
+   */
+  bool hasFixedCapacity() const;
+
+  /*! Function that returns the number of heap operations of the calling thread
+   * (e.g. rosrt::getThreadAllocInfo().total_ops)
+   */
+  typedef uint64_t (*AllocationCounter)();
+
+  /*! Debug hook: If set, the real-time functions (add, crop, and computeDerivatives in fixed
+   * capacity mode) assert that the number of heap operations did not change while they ran.
+   * @param allocation_counter Pass NULL to disable the check
+   */
+  static void setAllocationCounter(AllocationCounter allocation_counter);
+
   /*!
    * @param variable_names
    * @param sampling_frequency
@@ -223,6 +251,45 @@ public:
   bool writeToCLMCFile(const std::string& file_name,
                        const bool positions_only = false) const;
 
+  /*! Initializes the trajectory from the binary trajectory file pointed to by the provided file_name.
+   * The file is memory mapped and each requested column is copied with a single memcpy.
+   * @param file_name
+   * @param positions_only
+   * @return True on success, otherwise False
+   */
+  bool readFromBinaryFile(const std::string& file_name,
+                          const bool positions_only = false);
+
+  /*! Initializes the trajectory from the binary trajectory file pointed to by the provided file_name
+   * @param file_name
+   * @param variable_names
+   * @param positions_only
+   * @param use_variable_names If this is set to false, variable names parameter is ignored and ALL variable names are read from file
+   * @return True on success, otherwise False
+   */
+  bool readFromBinaryFile(const std::string& file_name,
+                          const std::vector<std::string>& variable_names,
+                          const bool positions_only = false,
+                          const bool use_variable_names = true);
+
+  /*! Writes the trajectory in the binary trajectory format: a header followed by a table of
+   * column names and units, followed by the data stored column-major in double precision.
+   * Velocity and acceleration columns are named like in CLMC files (<name>d and <name>dd).
+   * @param file_name
+   * @param positions_only
+   * @return True on success, otherwise False
+   */
+  bool writeToBinaryFile(const std::string& file_name,
+                         const bool positions_only = false) const;
+
+  /*! Converts a CLMC file into a binary trajectory file. All columns of the CLMC file are kept.
+   * @param clmc_file_name
+   * @param binary_file_name
+   * @return True on success, otherwise False
+   */
+  static bool convertCLMCFileToBinaryFile(const std::string& clmc_file_name,
+                                          const std::string& binary_file_name);
+
   /*!
    * @param other_trajectory
    * @param verbose
@@ -388,15 +455,38 @@ public:
   static bool blowUp(Trajectory& trajectory,
                      const int num_extra_points);
 
-  /*!
+  /*! Methods used to compute velocities and accelerations from positions
+   */
+  enum DerivativeMethod
+  {
+    FIVE_POINT_STENCIL,
+    SAVITZKY_GOLAY
+  };
+
+  /*! Computes velocities and accelerations using the five point stencil
    * @param num_extra_points
    * @return True on success, otherwise False
+   * REAL-TIME REQUIREMENTS (only in fixed capacity mode, see reserveFixedCapacity)
    */
   bool computeDerivatives(const int num_extra_points = 0);
 
+  /*!
+   * @param num_extra_points
+   * @param derivative_method
+   * @param savitzky_golay_half_window Number of samples on each side used to fit the polynomial (only used by SAVITZKY_GOLAY)
+   * @param num_threads Number of threads among which the variables are distributed (ignored in fixed capacity mode)
+   * @return True on success, otherwise False
+   * REAL-TIME REQUIREMENTS (only in fixed capacity mode, see reserveFixedCapacity)
+   */
+  bool computeDerivatives(const int num_extra_points,
+                          const DerivativeMethod derivative_method,
+                          const int savitzky_golay_half_window = 2,
+                          const int num_threads = 1);
+
   /*!
    * @param num_points Number of trajectory points which will be cropped at the beginning and ending
    * @return True on success, otherwise False
+   * REAL-TIME REQUIREMENTS
    */
   bool crop(const int num_trajectory_points);
 
@@ -405,6 +495,7 @@ public:
    * @param crop_the_end If true, trajectory points will be cropped at the end
    * otherwise, at the beginning.
    * @return True on success, otherwise False
+   * REAL-TIME REQUIREMENTS
    */
   bool crop(const int num_trajectory_points, bool crop_the_end);
 
@@ -508,6 +599,32 @@ private:
   Eigen::MatrixXd trajectory_velocities_;
   Eigen::MatrixXd trajectory_accelerations_;
 
+  /*! If true, all buffers are preallocated (see reserveFixedCapacity)
+   */
+  bool fixed_capacity_;
+  int max_num_extra_points_;
+
+  /*! Padded positions and velocities used by computeDerivatives
+   */
+  Eigen::MatrixXd padded_positions_;
+  Eigen::MatrixXd padded_velocities_;
+
+  /*! Initializes the trajectory from the content of a binary trajectory file
+   * @param file_name Only used for error messages
+   * @param buffer
+   * @param buffer_size
+   * @param variable_names
+   * @param positions_only
+   * @param use_variable_names
+   * @return True on success, otherwise False
+   */
+  bool readFromBinaryBuffer(const std::string& file_name,
+                            const char* buffer,
+                            const size_t buffer_size,
+                            const std::vector<std::string>& variable_names,
+                            const bool positions_only,
+                            const bool use_variable_names);
+
   /*!
    * @param trajectory_point
    * @return True on success, otherwise False
@@ -592,6 +709,10 @@ inline bool Trajectory::canHold(const int trajectory_length,
   }
   return true;
 }
+inline bool Trajectory::hasFixedCapacity() const
+{
+  return fixed_capacity_;
+}
 inline int Trajectory::getDimension() const
 {
   assert(initialized_);
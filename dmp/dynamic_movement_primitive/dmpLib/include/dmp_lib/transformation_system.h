@@ -19,6 +19,7 @@
 #include <vector>
 #include <string>
 #include <boost/shared_ptr.hpp>
+#include <Eigen/Core>
 
 // local include
 #include <dmp_lib/transformation_system_parameters.h>
@@ -46,7 +47,7 @@ public:
   /*! Constructor
    */
   TransformationSystem() :
-    integration_method_(NORMAL) {};
+    integration_method_(NORMAL), shared_basis_functions_(false) {};
 
   /*! Destructor
    */
@@ -338,6 +339,20 @@ public:
     return integration_method_;
   }
 
+  /*! Sets the activation below which the kernels of all dimensions are truncated to zero
+   * (0.0 disables truncation) and rebuilds the shared basis functions
+   * @param kernel_cutoff
+   * @return True on success, False otherwise
+   * THIS FUNCTION IS NOT REAL-TIME FRIENDLY
+   */
+  bool setKernelCutoff(const double kernel_cutoff);
+
+  /*! Gets the kernel cutoff of each dimension
+   * @param kernel_cutoffs
+   * @return True on success, False otherwise
+   */
+  bool getKernelCutoffs(std::vector<double>& kernel_cutoffs) const;
+
 protected:
 
   /*!
@@ -352,6 +367,36 @@ protected:
    */
   IntegrationMethod integration_method_;
 
+  /*! Computes the LWR prediction of all dimensions at x_query and stores them in predictions_.
+   * If all dimensions share the same receptive fields, the kernels are evaluated only once.
+   * @param x_query
+   * @return True on success, otherwise False
+   * REAL-TIME REQUIREMENTS
+   */
+  bool predict(const double x_query);
+
+  /*! Allocates predictions_ and basis_functions_ and determines whether all dimensions share
+   * the same receptive fields. Needs to be called whenever parameters_ or their receptive fields change.
+   * predict falls back to evaluating each dimension separately if the receptive fields changed since.
+   */
+  void initializeBasisFunctions();
+
+  /*! True if all lwr models have the same centers and widths
+   */
+  bool shared_basis_functions_;
+
+  /*! Preallocated (normalized) basis function vector, only used if shared_basis_functions_ is true
+   */
+  Eigen::VectorXd basis_functions_;
+
+  /*! Kernel revisions of the lwr models at the time shared_basis_functions_ was determined
+   */
+  std::vector<int> kernel_revisions_;
+
+  /*! Preallocated LWR predictions, one for each dimension
+   */
+  Eigen::VectorXd predictions_;
+
 };
 
 /*! Abbreviation for convinience
@@ -0,0 +1,47 @@
+/*********************************************************************
+ Computational Learning and Motor Control Lab
+ University of Southern California
+ Prof. Stefan Schaal
+ *********************************************************************
+ \remarks		Converts CLMC files into binary trajectory files.
+ Usage: convert_clmc_to_binary <clmc file> [<clmc file> ...]
+ Each file is written to <clmc file>.bin
+
+ \file		convert_clmc_to_binary.cpp
+
+ \date		Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <string>
+
+// local includes
+#include <dmp_lib/trajectory.h>
+#include <dmp_lib/logger.h>
+
+int main(int argc, char** argv)
+{
+  if (argc < 2)
+  {
+    dmp_lib::Logger::logPrintf("Usage: %s <clmc file> [<clmc file> ...]", dmp_lib::Logger::ERROR, argv[0]);
+    return -1;
+  }
+
+  int num_failures = 0;
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string clmc_file_name = argv[i];
+    const std::string binary_file_name = clmc_file_name + std::string(".bin");
+    if (!dmp_lib::Trajectory::convertCLMCFileToBinaryFile(clmc_file_name, binary_file_name))
+    {
+      dmp_lib::Logger::logPrintf("Could not convert >%s<.", dmp_lib::Logger::ERROR, clmc_file_name.c_str());
+      num_failures++;
+    }
+  }
+  if (num_failures > 0)
+  {
+    return -1;
+  }
+  return 0;
+}
@@ -226,8 +226,12 @@ bool DynamicMovementPrimitive::learnFromThetas(const std::vector<Eigen::VectorXd
   // set teaching duration to the duration of the trajectory
   parameters_->teaching_duration_ = initial_duration;
 
-  assert(state_->current_time_.setDeltaT(static_cast<double> (1.0) / static_cast<double> (sampling_frequency)));
-  assert(state_->current_time_.setTau(parameters_->teaching_duration_));
+  if (!state_->current_time_.setDeltaT(static_cast<double> (1.0) / static_cast<double> (sampling_frequency))
+      || !state_->current_time_.setTau(parameters_->teaching_duration_))
+  {
+    Logger::logPrintf("Could not set teaching duration when setting the theta vector.", Logger::ERROR);
+    return (state_->is_learned_ = false);
+  }
 
   parameters_->initial_time_ = state_->current_time_;
 
@@ -290,8 +294,12 @@ bool DynamicMovementPrimitive::learnFromTrajectory(const Trajectory& demo_trajec
   // set teaching duration to the duration of the trajectory
   parameters_->teaching_duration_ = static_cast<double> (trajectory.getNumContainedSamples()) / static_cast<double> (trajectory.getSamplingFrequency());
 
-  assert(state_->current_time_.setDeltaT(static_cast<double> (1.0) / static_cast<double> (trajectory.getSamplingFrequency())));
-  assert(state_->current_time_.setTau(parameters_->teaching_duration_));
+  if (!state_->current_time_.setDeltaT(static_cast<double> (1.0) / static_cast<double> (trajectory.getSamplingFrequency()))
+      || !state_->current_time_.setTau(parameters_->teaching_duration_))
+  {
+    Logger::logPrintf("Could not set teaching duration. Cannot learn DMP from trajectory.", Logger::ERROR);
+    return (state_->is_learned_ = false);
+  }
 
   parameters_->initial_time_ = state_->current_time_;
 
@@ -372,9 +380,13 @@ bool DynamicMovementPrimitive::learnFromTrajectory(const Trajectory& demo_trajec
       // get state
       for (int j = 0; j < transformation_systems_[i]->getNumDimensions(); ++j)
       {
-        assert(trajectory.getTrajectoryPosition(row_index, trajectory_index, t));
-        assert(trajectory.getTrajectoryVelocity(row_index, trajectory_index, td));
-        assert(trajectory.getTrajectoryAcceleration(row_index, trajectory_index, tdd));
+        if (!trajectory.getTrajectoryPosition(row_index, trajectory_index, t)
+            || !trajectory.getTrajectoryVelocity(row_index, trajectory_index, td)
+            || !trajectory.getTrajectoryAcceleration(row_index, trajectory_index, tdd))
+        {
+          Logger::logPrintf("Could not get trajectory point >%i<. Cannot learn DMP from trajectory.", Logger::ERROR, row_index);
+          return (state_->is_learned_ = false);
+        }
         target_states[i][j].set(t, td, tdd);
         trajectory_index++;
       }
@@ -412,7 +424,7 @@ bool DynamicMovementPrimitive::learnFromTrajectory(const Trajectory& demo_trajec
 
   if (debug_trajectory)
   {
-    assert(debug_trajectory->writeToCLMCFile("/tmp/learn_debug.clmc", true));
+    Logger::logPrintf(!debug_trajectory->writeToCLMCFile("/tmp/learn_debug.clmc", true), "Could not write debug trajectory.", Logger::WARN);
   }
 
   Logger::logPrintf("Done learning DMP from trajectory.", Logger::INFO);
@@ -662,8 +674,12 @@ bool DynamicMovementPrimitive::setup(const VectorXd& start,
     return (state_->is_setup_ = false);
   }
 
-  assert(state_->current_time_.setTau(movement_duration));
-  assert(state_->current_time_.setDeltaT(static_cast<double> (1.0) / static_cast<double> (sampling_frequency)));
+  if (!state_->current_time_.setTau(movement_duration)
+      || !state_->current_time_.setDeltaT(static_cast<double> (1.0) / static_cast<double> (sampling_frequency)))
+  {
+    Logger::logPrintf("Could not set movement duration >%f< and sampling frequency >%f<.", Logger::ERROR, movement_duration, sampling_frequency);
+    return (state_->is_setup_ = false);
+  }
 
   for (int i = 0; i < getNumDimensions(); ++i)
   {
@@ -701,7 +717,10 @@ bool DynamicMovementPrimitive::setupDuration(const VectorXd& start,
 {
   assert(initialized_);
   double initial_sampling_frequency = 0;
-  assert(getInitialSamplingFrequency(initial_sampling_frequency));
+  if (!getInitialSamplingFrequency(initial_sampling_frequency))
+  {
+    return (state_->is_setup_ = false);
+  }
   return setup(start, goal, movement_duration, initial_sampling_frequency);
 }
 
@@ -735,7 +754,10 @@ bool DynamicMovementPrimitive::setupDuration(const Eigen::VectorXd& goal,
   assert(initialized_);
   // setup dmp timings to the timings used during learning
   double initial_sampling_frequency = 0;
-  assert(getInitialSamplingFrequency(initial_sampling_frequency));
+  if (!getInitialSamplingFrequency(initial_sampling_frequency))
+  {
+    return (state_->is_setup_ = false);
+  }
   bool result = setup(goal, movement_duration, initial_sampling_frequency);
   // TODO: check whether this is neccessary
   state_->current_time_ = parameters_->initial_time_;
@@ -776,7 +798,10 @@ bool DynamicMovementPrimitive::setupDuration(const double movement_duration)
   }
   // setup dmp timings to the timings used during learning
   double initial_sampling_frequency = 0;
-  assert(getInitialSamplingFrequency(initial_sampling_frequency));
+  if (!getInitialSamplingFrequency(initial_sampling_frequency))
+  {
+    return (state_->is_setup_ = false);
+  }
   return setup(goal, movement_duration, initial_sampling_frequency);
 }
 
@@ -785,7 +810,10 @@ bool DynamicMovementPrimitive::setup(const VectorXd& goal)
   assert(initialized_);
   // setup dmp timings to the timings used during learning
   double initial_sampling_frequency = 0;
-  assert(getInitialSamplingFrequency(initial_sampling_frequency));
+  if (!getInitialSamplingFrequency(initial_sampling_frequency))
+  {
+    return (state_->is_setup_ = false);
+  }
   return setup(goal, parameters_->initial_time_.getTau(), initial_sampling_frequency);
 }
 
@@ -1196,6 +1224,31 @@ bool DynamicMovementPrimitive::setThetas(const vector<VectorXd>& thetas)
   return true;
 }
 
+bool DynamicMovementPrimitive::setKernelCutoff(const double kernel_cutoff)
+{
+  assert(initialized_);
+  for (int i = 0; i < (int)transformation_systems_.size(); ++i)
+  {
+    if (!transformation_systems_[i]->setKernelCutoff(kernel_cutoff))
+    {
+      Logger::logPrintf("Could not set kernel cutoff of transformation system >%i<.", Logger::ERROR, i);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DynamicMovementPrimitive::getKernelCutoffs(vector<double>& kernel_cutoffs) const
+{
+  assert(initialized_);
+  kernel_cutoffs.clear();
+  for (int i = 0; i < getNumDimensions(); ++i)
+  {
+    kernel_cutoffs.push_back(transformation_systems_[indices_[i].first]->parameters_[indices_[i].second]->lwr_model_->getKernelCutoff());
+  }
+  return true;
+}
+
 bool DynamicMovementPrimitive::generateBasisFunctionMatrix(const int num_time_steps, vector<MatrixXd>& basis_functions) const
 {
   assert(initialized_);
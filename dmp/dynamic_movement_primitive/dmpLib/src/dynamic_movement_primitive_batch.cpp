@@ -0,0 +1,190 @@
+/*********************************************************************
+ Computational Learning and Motor Control Lab
+ University of Southern California
+ Prof. Stefan Schaal
+ *********************************************************************
+ \remarks		...
+
+ \file		dynamic_movement_primitive_batch.cpp
+
+ \date		Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <stdio.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// local includes
+#include <dmp_lib/dynamic_movement_primitive_batch.h>
+#include <dmp_lib/icra2009_dynamic_movement_primitive.h>
+#include <dmp_lib/nc2010_dynamic_movement_primitive.h>
+#include <dmp_lib/logger.h>
+
+using namespace std;
+using namespace Eigen;
+
+namespace dmp_lib
+{
+
+template<class DMPType>
+  bool DynamicMovementPrimitiveBatch<DMPType>::initialize(const DMPType& dmp,
+                                                          const int num_threads)
+  {
+    if (!dmp.isInitialized())
+    {
+      Logger::logPrintf("Cannot initialize DMP batch from uninitialized DMP.", Logger::ERROR);
+      return (initialized_ = false);
+    }
+    if (num_threads < 0)
+    {
+      Logger::logPrintf("Number of threads >%i< is invalid. Cannot initialize DMP batch.", Logger::ERROR, num_threads);
+      return (initialized_ = false);
+    }
+    Logger::logPrintf(initialized_, "DMP batch already initialized. Re-initializing...", Logger::WARN);
+
+    int num_dmps = num_threads;
+    if (num_dmps == 0)
+    {
+#ifdef _OPENMP
+      num_dmps = omp_get_num_procs();
+#else
+      num_dmps = 1;
+#endif
+    }
+
+    num_dimensions_ = dmp.getNumDimensions();
+    dmps_.clear();
+    desired_positions_.clear();
+    desired_velocities_.clear();
+    desired_accelerations_.clear();
+    for (int i = 0; i < num_dmps; ++i)
+    {
+      // deep copy, operator= leaves the copy uninitialized if any of the members could not be assigned
+      boost::shared_ptr<DMPType> dmp_copy(new DMPType());
+      *dmp_copy = dmp;
+      if (!dmp_copy->isInitialized() || !(*dmp_copy == dmp))
+      {
+        Logger::logPrintf("Could not copy DMP for thread >%i<. Cannot initialize DMP batch.", Logger::ERROR, i);
+        dmps_.clear();
+        return (initialized_ = false);
+      }
+      dmps_.push_back(dmp_copy);
+      desired_positions_.push_back(VectorXd::Zero(num_dimensions_));
+      desired_velocities_.push_back(VectorXd::Zero(num_dimensions_));
+      desired_accelerations_.push_back(VectorXd::Zero(num_dimensions_));
+    }
+    return (initialized_ = true);
+  }
+
+template<class DMPType>
+  bool DynamicMovementPrimitiveBatch<DMPType>::propagateFull(const vector<vector<VectorXd> >& thetas,
+                                                             const vector<VectorXd>& starts,
+                                                             const vector<VectorXd>& goals,
+                                                             const vector<double>& durations,
+                                                             const int num_samples,
+                                                             MatrixXd& positions,
+                                                             MatrixXd& velocities,
+                                                             MatrixXd& accelerations)
+  {
+    if (!initialized_)
+    {
+      Logger::logPrintf("DMP batch is not initialized. Cannot propagate rollouts.", Logger::ERROR);
+      return false;
+    }
+    const int num_rollouts = static_cast<int> (thetas.size());
+    if (((int)starts.size() != num_rollouts) || ((int)goals.size() != num_rollouts) || ((int)durations.size() != num_rollouts))
+    {
+      Logger::logPrintf("Number of thetas >%i<, starts >%i<, goals >%i<, and durations >%i< must be equal. Cannot propagate rollouts.", Logger::ERROR,
+                        num_rollouts, (int)starts.size(), (int)goals.size(), (int)durations.size());
+      return false;
+    }
+    if (num_samples < 1)
+    {
+      Logger::logPrintf("Number of samples >%i< is invalid. Cannot propagate rollouts.", Logger::ERROR, num_samples);
+      return false;
+    }
+    const int num_columns = num_rollouts * num_dimensions_;
+    if ((positions.rows() != num_samples) || (positions.cols() != num_columns)
+        || (velocities.rows() != num_samples) || (velocities.cols() != num_columns)
+        || (accelerations.rows() != num_samples) || (accelerations.cols() != num_columns))
+    {
+      Logger::logPrintf("Size of provided matrices is incorrect, they should be of size (%i x %i). Cannot propagate rollouts.", Logger::ERROR,
+                        num_samples, num_columns);
+      return false;
+    }
+
+    bool success = true;
+    // each thread accumulates into its own copy of success, these are and-ed after the loop
+#pragma omp parallel for schedule(dynamic) num_threads(getNumThreads()) reduction(&&:success)
+    for (int r = 0; r < num_rollouts; ++r)
+    {
+      int thread_index = 0;
+#ifdef _OPENMP
+      thread_index = omp_get_thread_num();
+#endif
+      if (!propagateRollout(thread_index, r, thetas[r], starts[r], goals[r], durations[r], num_samples, positions, velocities, accelerations))
+      {
+        Logger::logPrintf("Could not propagate rollout >%i<.", Logger::ERROR, r);
+        success = false;
+      }
+    }
+    return success;
+  }
+
+template<class DMPType>
+  bool DynamicMovementPrimitiveBatch<DMPType>::propagateRollout(const int thread_index,
+                                                                const int rollout_index,
+                                                                const vector<VectorXd>& thetas,
+                                                                const VectorXd& start,
+                                                                const VectorXd& goal,
+                                                                const double duration,
+                                                                const int num_samples,
+                                                                MatrixXd& positions,
+                                                                MatrixXd& velocities,
+                                                                MatrixXd& accelerations)
+  {
+    DMPType& dmp = *dmps_[thread_index];
+    if (!dmp.setThetas(thetas))
+    {
+      return false;
+    }
+    if ((duration < 1e-10) || !dmp.setup(start, goal, duration, static_cast<double> (num_samples) / duration))
+    {
+      return false;
+    }
+
+    const int column = rollout_index * num_dimensions_;
+    bool movement_finished = false;
+    int num_valid_samples = 0;
+    for (; num_valid_samples < num_samples && !movement_finished; ++num_valid_samples)
+    {
+      const int i = num_valid_samples;
+      if (!dmp.propagateStep(desired_positions_[thread_index], desired_velocities_[thread_index], desired_accelerations_[thread_index],
+                             movement_finished, duration, num_samples))
+      {
+        return false;
+      }
+      positions.block(i, column, 1, num_dimensions_) = desired_positions_[thread_index].transpose();
+      velocities.block(i, column, 1, num_dimensions_) = desired_velocities_[thread_index].transpose();
+      accelerations.block(i, column, 1, num_dimensions_) = desired_accelerations_[thread_index].transpose();
+    }
+
+    // the movement finished early, clear the remaining rows such that no data of a previous call remains
+    const int num_remaining_samples = num_samples - num_valid_samples;
+    if (num_remaining_samples > 0)
+    {
+      positions.block(num_valid_samples, column, num_remaining_samples, num_dimensions_).setZero();
+      velocities.block(num_valid_samples, column, num_remaining_samples, num_dimensions_).setZero();
+      accelerations.block(num_valid_samples, column, num_remaining_samples, num_dimensions_).setZero();
+    }
+    return true;
+  }
+
+// explicit instantiations
+template class DynamicMovementPrimitiveBatch<ICRA2009DynamicMovementPrimitive>;
+template class DynamicMovementPrimitiveBatch<NC2010DynamicMovementPrimitive>;
+
+}
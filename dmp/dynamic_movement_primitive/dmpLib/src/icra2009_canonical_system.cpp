@@ -32,8 +32,13 @@ ICRA2009CanonicalSystem& ICRA2009CanonicalSystem::operator=(const ICRA2009Canoni
   Logger::logPrintf("ICRA2009CanonicalSystem assignment.", Logger::DEBUG);
 
   // first assign all memeber variables
-  assert(Utilities<ICRA2009CanonicalSystemParameters>::assign(parameters_, icra2009cs.parameters_));
-  assert(Utilities<ICRA2009CanonicalSystemState>::assign(state_, icra2009cs.state_));
+  if (!Utilities<ICRA2009CanonicalSystemParameters>::assign(parameters_, icra2009cs.parameters_)
+      || !Utilities<ICRA2009CanonicalSystemState>::assign(state_, icra2009cs.state_))
+  {
+    Logger::logPrintf("Could not assign ICRA2009CanonicalSystem.", Logger::FATAL);
+    initialized_ = false;
+    return *this;
+  }
 
   // then assign base class variables
   CanonicalSystem::parameters_ = parameters_;
@@ -49,8 +54,12 @@ bool ICRA2009CanonicalSystem::initialize(const ICRA2009CSParamPtr parameters,
   Logger::logPrintf("Initializing ICRA2009 canonical system.", Logger::DEBUG);
 
   // first set all memeber variables
-  assert(Utilities<ICRA2009CanonicalSystemParameters>::assign(parameters_, parameters));
-  assert(Utilities<ICRA2009CanonicalSystemState>::assign(state_, state));
+  if (!Utilities<ICRA2009CanonicalSystemParameters>::assign(parameters_, parameters)
+      || !Utilities<ICRA2009CanonicalSystemState>::assign(state_, state))
+  {
+    Logger::logPrintf("Could not initialize ICRA2009CanonicalSystem.", Logger::FATAL);
+    return (initialized_ = false);
+  }
 
   // then initialize base class variables
   return CanonicalSystem::initialize(parameters_, state_);
@@ -73,6 +82,7 @@ void ICRA2009CanonicalSystem::reset()
 {
   assert(initialized_);
   state_->setStateX(1.0);
+  state_->setCanX(1.0);
   state_->setTime(0.0);
   state_->setProgressTime(0.0);
 }
@@ -32,10 +32,15 @@ ICRA2009DynamicMovementPrimitive& ICRA2009DynamicMovementPrimitive::operator=(co
   Logger::logPrintf("ICRA2009DynamicMovementPrimitive assignment.", Logger::DEBUG);
 
   // first assign all member variables
-  assert(Utilities<ICRA2009DMPParam>::assign(parameters_, icra2009dmp.parameters_));
-  assert(Utilities<ICRA2009DMPState>::assign(state_, icra2009dmp.state_));
-  assert(Utilities<ICRA2009TS>::assign(transformation_systems_, icra2009dmp.transformation_systems_));
-  assert(Utilities<ICRA2009CS>::assign(canonical_system_, icra2009dmp.canonical_system_));
+  if (!Utilities<ICRA2009DMPParam>::assign(parameters_, icra2009dmp.parameters_)
+      || !Utilities<ICRA2009DMPState>::assign(state_, icra2009dmp.state_)
+      || !Utilities<ICRA2009TS>::assign(transformation_systems_, icra2009dmp.transformation_systems_)
+      || !Utilities<ICRA2009CS>::assign(canonical_system_, icra2009dmp.canonical_system_))
+  {
+    Logger::logPrintf("Could not assign ICRA2009DynamicMovementPrimitive.", Logger::FATAL);
+    initialized_ = false;
+    return *this;
+  }
 
   // then assign base class variables
   DynamicMovementPrimitive::parameters_ = parameters_;
@@ -48,6 +53,7 @@ ICRA2009DynamicMovementPrimitive& ICRA2009DynamicMovementPrimitive::operator=(co
   DynamicMovementPrimitive::canonical_system_ = canonical_system_;
 
   indices_ = icra2009dmp.indices_;
+  zero_feedback_ = icra2009dmp.zero_feedback_;
   initialized_ = icra2009dmp.initialized_;
   return *this;
 }
@@ -60,10 +66,14 @@ bool ICRA2009DynamicMovementPrimitive::initialize(ICRA2009DMPParamPtr& parameter
   // Logger::logPrintf(initialized_, "DMP already initialized. Re-initializing it...", Logger::WARN);
 
   // first set all member variables
-  assert(Utilities<ICRA2009DMPParam>::assign(parameters_, parameters));
-  assert(Utilities<ICRA2009DMPState>::assign(state_, state));
-  assert(Utilities<ICRA2009TS>::assign(transformation_systems_, transformation_systems));
-  assert(Utilities<ICRA2009CS>::assign(canonical_system_, canonical_system));
+  if (!Utilities<ICRA2009DMPParam>::assign(parameters_, parameters)
+      || !Utilities<ICRA2009DMPState>::assign(state_, state)
+      || !Utilities<ICRA2009TS>::assign(transformation_systems_, transformation_systems)
+      || !Utilities<ICRA2009CS>::assign(canonical_system_, canonical_system))
+  {
+    Logger::logPrintf("Could not initialize ICRA2009DynamicMovementPrimitive.", Logger::FATAL);
+    return (initialized_ = false);
+  }
 
   // then initialize base class variables
   vector<TSPtr> base_transformation_systems;
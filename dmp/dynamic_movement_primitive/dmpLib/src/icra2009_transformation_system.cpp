@@ -38,8 +38,13 @@ ICRA2009TransformationSystem& ICRA2009TransformationSystem::operator=(const ICRA
   Logger::logPrintf("ICRA2009TransformationSystem assignment.", Logger::DEBUG);
 
   // first assign all memeber variables
-  assert(Utilities<ICRA2009TSParam>::assign(parameters_, icra2009ts.parameters_));
-  assert(Utilities<ICRA2009TSState>::assign(states_, icra2009ts.states_));
+  if (!Utilities<ICRA2009TSParam>::assign(parameters_, icra2009ts.parameters_)
+      || !Utilities<ICRA2009TSState>::assign(states_, icra2009ts.states_))
+  {
+    Logger::logPrintf("Could not assign ICRA2009TransformationSystem.", Logger::FATAL);
+    initialized_ = false;
+    return *this;
+  }
 
   // then assign all base class variables
   TransformationSystem::parameters_.clear();
@@ -53,6 +58,7 @@ ICRA2009TransformationSystem& ICRA2009TransformationSystem::operator=(const ICRA
     TransformationSystem::states_.push_back(states_[i]);
   }
   integration_method_ = icra2009ts.integration_method_;
+  initializeBasisFunctions();
   initialized_ = icra2009ts.initialized_;
   return *this;
 }
@@ -75,8 +81,12 @@ bool ICRA2009TransformationSystem::initialize(const vector<ICRA2009TSParamPtr> p
   Logger::logPrintf("Initializing ICRA2009 transformation system.", Logger::DEBUG);
 
   // first initialize all memeber variables
-  assert(Utilities<ICRA2009TSParam>::assign(parameters_, parameters));
-  assert(Utilities<ICRA2009TSState>::assign(states_, states));
+  if (!Utilities<ICRA2009TSParam>::assign(parameters_, parameters)
+      || !Utilities<ICRA2009TSState>::assign(states_, states))
+  {
+    Logger::logPrintf("Could not initialize ICRA2009TransformationSystem.", Logger::FATAL);
+    return (initialized_ = false);
+  }
 
   // then initialize base class
   vector<TSParamPtr> ts_params;
@@ -325,6 +335,13 @@ bool ICRA2009TransformationSystem::integrate(const CSStatePtr canonical_system_s
   {
     case NORMAL:
     {
+      // compute nonlinearity of all dimensions using LWR (the canonical system does not change during the iterations)
+      if (!predict(canonical_system_state->getStateX()))
+      {
+        Logger::logPrintf("Could not predict output (Real-time violation).", Logger::ERROR);
+        return false;
+      }
+
       double dt = dmp_time.getDeltaT() / static_cast<double> (num_iterations);
       for (int i = 0; i < getNumDimensions(); ++i)
       {
@@ -333,15 +350,7 @@ bool ICRA2009TransformationSystem::integrate(const CSStatePtr canonical_system_s
           // for debugging only
           states_[i]->internal_.setX(feedback(i));
 
-          // compute nonlinearity using LWR
-          double prediction = 0;
-          if (!parameters_[i]->lwr_model_->predict(canonical_system_state->getStateX(), prediction))
-          {
-            Logger::logPrintf("Could not predict output (Real-time violation).", Logger::ERROR);
-            return false;
-          }
-
-          states_[i]->f_ = prediction * canonical_system_state->getCanX();
+          states_[i]->f_ = predictions_(i) * canonical_system_state->getCanX();
 
           // compute transformation system
           states_[i]->internal_.setXdd(((parameters_[i]->k_gain_ * (states_[i]->goal_ - states_[i]->current_.getX())
@@ -382,6 +391,13 @@ bool ICRA2009TransformationSystem::integrate(const CSStatePtr canonical_system_s
         states_[i]->internal_.setX(feedback(i));
       }
 
+      // compute nonlinearity using LWR (the canonical system does not change during the iterations)
+      if (!predict(canonical_system_state->getStateX()))
+      {
+        Logger::logPrintf("Could not predict output (Real-time violation).", Logger::ERROR);
+        return false;
+      }
+
       double dt = dmp_time.getDeltaT() / static_cast<double> (num_iterations);
       for (int n = 0; n < num_iterations; ++n)
       {
@@ -389,14 +405,7 @@ bool ICRA2009TransformationSystem::integrate(const CSStatePtr canonical_system_s
         Vector3d f;
         for (int i = 1; i < 4; ++i)
         {
-          // compute nonlinearity using LWR
-          double prediction = 0;
-          if (!parameters_[i]->lwr_model_->predict(canonical_system_state->getStateX(), prediction))
-          {
-            Logger::logPrintf("Could not predict output (Real-time violation).", Logger::ERROR);
-            return false;
-          }
-          f(i-1) = prediction * canonical_system_state->getCanX();
+          f(i-1) = predictions_(i) * canonical_system_state->getCanX();
         }
 
         Matrix3d K = Matrix3d::Zero();
@@ -32,8 +32,13 @@ NC2010CanonicalSystem& NC2010CanonicalSystem::operator=(const NC2010CanonicalSys
   Logger::logPrintf("NC2010CanonicalSystem assignment.", Logger::DEBUG);
 
   // first assign all memeber variables
-  assert(Utilities<NC2010CanonicalSystemParameters>::assign(parameters_, nc2010cs.parameters_));
-  assert(Utilities<NC2010CanonicalSystemState>::assign(state_, nc2010cs.state_));
+  if (!Utilities<NC2010CanonicalSystemParameters>::assign(parameters_, nc2010cs.parameters_)
+      || !Utilities<NC2010CanonicalSystemState>::assign(state_, nc2010cs.state_))
+  {
+    Logger::logPrintf("Could not assign NC2010CanonicalSystem.", Logger::FATAL);
+    initialized_ = false;
+    return *this;
+  }
 
   // then assign base class variables
   CanonicalSystem::parameters_ = parameters_;
@@ -49,8 +54,12 @@ bool NC2010CanonicalSystem::initialize(const NC2010CSParamPtr parameters,
   Logger::logPrintf("Initializing NC2010 canonical system.", Logger::DEBUG);
 
   // first set all memeber variables
-  assert(Utilities<NC2010CanonicalSystemParameters>::assign(parameters_, parameters));
-  assert(Utilities<NC2010CanonicalSystemState>::assign(state_, state));
+  if (!Utilities<NC2010CanonicalSystemParameters>::assign(parameters_, parameters)
+      || !Utilities<NC2010CanonicalSystemState>::assign(state_, state))
+  {
+    Logger::logPrintf("Could not initialize NC2010CanonicalSystem.", Logger::FATAL);
+    return (initialized_ = false);
+  }
 
   // then initialize base class variables
   return CanonicalSystem::initialize(parameters_, state_);
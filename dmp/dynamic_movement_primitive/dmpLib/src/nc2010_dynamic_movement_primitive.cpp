@@ -32,10 +32,15 @@ NC2010DynamicMovementPrimitive& NC2010DynamicMovementPrimitive::operator=(const
   Logger::logPrintf("NC2010DynamicMovementPrimitive assignment.", Logger::DEBUG);
 
   // first assign all member variables
-  assert(Utilities<NC2010DMPParam>::assign(parameters_, nc2010dmp.parameters_));
-  assert(Utilities<NC2010DMPState>::assign(state_, nc2010dmp.state_));
-  assert(Utilities<NC2010TS>::assign(transformation_systems_, nc2010dmp.transformation_systems_));
-  assert(Utilities<NC2010CS>::assign(canonical_system_, nc2010dmp.canonical_system_));
+  if (!Utilities<NC2010DMPParam>::assign(parameters_, nc2010dmp.parameters_)
+      || !Utilities<NC2010DMPState>::assign(state_, nc2010dmp.state_)
+      || !Utilities<NC2010TS>::assign(transformation_systems_, nc2010dmp.transformation_systems_)
+      || !Utilities<NC2010CS>::assign(canonical_system_, nc2010dmp.canonical_system_))
+  {
+    Logger::logPrintf("Could not assign NC2010DynamicMovementPrimitive.", Logger::FATAL);
+    initialized_ = false;
+    return *this;
+  }
 
   // then assign base class variables
   DynamicMovementPrimitive::parameters_ = parameters_;
@@ -48,6 +53,7 @@ NC2010DynamicMovementPrimitive& NC2010DynamicMovementPrimitive::operator=(const
   DynamicMovementPrimitive::canonical_system_ = canonical_system_;
 
   indices_ = nc2010dmp.indices_;
+  zero_feedback_ = nc2010dmp.zero_feedback_;
   initialized_ = nc2010dmp.initialized_;
   return *this;
 }
@@ -60,10 +66,14 @@ bool NC2010DynamicMovementPrimitive::initialize(NC2010DMPParamPtr& parameters,
   // Logger::logPrintf(initialized_, "DMP already initialized. Re-initializing it...", Logger::WARN);
 
   // first set all member variables
-  assert(Utilities<NC2010DMPParam>::assign(parameters_, parameters));
-  assert(Utilities<NC2010DMPState>::assign(state_, state));
-  assert(Utilities<NC2010TS>::assign(transformation_systems_, transformation_systems));
-  assert(Utilities<NC2010CS>::assign(canonical_system_, canonical_system));
+  if (!Utilities<NC2010DMPParam>::assign(parameters_, parameters)
+      || !Utilities<NC2010DMPState>::assign(state_, state)
+      || !Utilities<NC2010TS>::assign(transformation_systems_, transformation_systems)
+      || !Utilities<NC2010CS>::assign(canonical_system_, canonical_system))
+  {
+    Logger::logPrintf("Could not initialize NC2010DynamicMovementPrimitive.", Logger::FATAL);
+    return (initialized_ = false);
+  }
 
   // then initialize base class variables
   vector<TSPtr> base_transformation_systems;
@@ -38,8 +38,13 @@ NC2010TransformationSystem& NC2010TransformationSystem::operator=(const NC2010Tr
   Logger::logPrintf("NC2010TransformationSystem assignment.", Logger::DEBUG);
 
   // first assign all memeber variables
-  assert(Utilities<NC2010TSParam>::assign(parameters_, nc2010ts.parameters_));
-  assert(Utilities<NC2010TSState>::assign(states_, nc2010ts.states_));
+  if (!Utilities<NC2010TSParam>::assign(parameters_, nc2010ts.parameters_)
+      || !Utilities<NC2010TSState>::assign(states_, nc2010ts.states_))
+  {
+    Logger::logPrintf("Could not assign NC2010TransformationSystem.", Logger::FATAL);
+    initialized_ = false;
+    return *this;
+  }
 
   // then assign all base class variables
   TransformationSystem::parameters_.clear();
@@ -53,6 +58,8 @@ NC2010TransformationSystem& NC2010TransformationSystem::operator=(const NC2010Tr
     TransformationSystem::states_.push_back(states_[i]);
   }
   integration_method_ = nc2010ts.integration_method_;
+  initializeBasisFunctions();
+  initializePackedStates();
   initialized_ = nc2010ts.initialized_;
   return *this;
 }
@@ -75,8 +82,12 @@ bool NC2010TransformationSystem::initialize(const vector<NC2010TSParamPtr> param
   Logger::logPrintf("Initializing NC2010 transformation system.", Logger::DEBUG);
 
   // first initialize all memeber variables
-  assert(Utilities<NC2010TSParam>::assign(parameters_, parameters));
-  assert(Utilities<NC2010TSState>::assign(states_, states));
+  if (!Utilities<NC2010TSParam>::assign(parameters_, parameters)
+      || !Utilities<NC2010TSState>::assign(states_, states))
+  {
+    Logger::logPrintf("Could not initialize NC2010TransformationSystem.", Logger::FATAL);
+    return (initialized_ = false);
+  }
 
   // then initialize base class
   vector<TSParamPtr> ts_params;
@@ -89,7 +100,58 @@ bool NC2010TransformationSystem::initialize(const vector<NC2010TSParamPtr> param
   {
     ts_states.push_back(states_[i]);
   }
-  return TransformationSystem::initialize(ts_params, ts_states, integration_method);
+  if (!TransformationSystem::initialize(ts_params, ts_states, integration_method))
+  {
+    return false;
+  }
+  initializePackedStates();
+  return true;
+}
+
+void NC2010TransformationSystem::initializePackedStates()
+{
+  const int num_dimensions = static_cast<int> (parameters_.size());
+  packed_k_gains_ = ArrayXd::Zero(num_dimensions);
+  packed_d_gains_ = ArrayXd::Zero(num_dimensions);
+  for (int i = 0; i < num_dimensions; ++i)
+  {
+    packed_k_gains_(i) = parameters_[i]->k_gain_;
+    packed_d_gains_(i) = parameters_[i]->d_gain_;
+  }
+  packed_goals_ = ArrayXd::Zero(num_dimensions);
+  packed_starts_ = ArrayXd::Zero(num_dimensions);
+  packed_x_ = ArrayXd::Zero(num_dimensions);
+  packed_xd_ = ArrayXd::Zero(num_dimensions);
+  packed_xdd_ = ArrayXd::Zero(num_dimensions);
+  packed_internal_xd_ = ArrayXd::Zero(num_dimensions);
+  packed_internal_xdd_ = ArrayXd::Zero(num_dimensions);
+  packed_f_ = ArrayXd::Zero(num_dimensions);
+}
+
+// REAL-TIME REQUIREMENTS
+void NC2010TransformationSystem::packStates()
+{
+  for (int i = 0; i < packed_x_.size(); ++i)
+  {
+    packed_goals_(i) = states_[i]->goal_;
+    packed_starts_(i) = states_[i]->start_;
+    packed_x_(i) = states_[i]->current_.getX();
+    packed_internal_xd_(i) = states_[i]->internal_.getXd();
+  }
+}
+
+// REAL-TIME REQUIREMENTS
+void NC2010TransformationSystem::unpackStates()
+{
+  for (int i = 0; i < packed_x_.size(); ++i)
+  {
+    states_[i]->f_ = packed_f_(i);
+    states_[i]->current_.setX(packed_x_(i));
+    states_[i]->current_.setXd(packed_xd_(i));
+    states_[i]->current_.setXdd(packed_xdd_(i));
+    states_[i]->internal_.setXd(packed_internal_xd_(i));
+    states_[i]->internal_.setXdd(packed_internal_xdd_(i));
+  }
 }
 
 bool NC2010TransformationSystem::get(NC2010TSParamConstPtr& parameters,
@@ -293,41 +355,47 @@ bool NC2010TransformationSystem::integrate(const CSStatePtr canonical_system_sta
   {
     case NORMAL:
     {
-      double dt = dmp_time.getDeltaT() / static_cast<double> (num_iterations);
-      for (int i = 0; i < getNumDimensions(); ++i)
+      // compute nonlinearity of all dimensions using LWR (the canonical system does not change during the iterations)
+      if (!predict(canonical_system_state->getStateX()))
       {
-        for (int n = 0; n < num_iterations; ++n)
-        {
-          // compute nonlinearity using LWR
-          double prediction = 0;
-          if (!parameters_[i]->lwr_model_->predict(canonical_system_state->getStateX(), prediction))
-          {
-            Logger::logPrintf("Could not predict output (Real-time violation).", Logger::ERROR);
-            return false;
-          }
-
-          states_[i]->f_ = prediction * canonical_system_state->getStateX();
+        Logger::logPrintf("Could not predict output (Real-time violation).", Logger::ERROR);
+        return false;
+      }
 
-          // compute transformation system
-          states_[i]->internal_.setXdd( (parameters_[i]->k_gain_ * (states_[i]->goal_ - states_[i]->current_.getX())
-              - parameters_[i]->d_gain_ * states_[i]->internal_.getXd()
-              - parameters_[i]->k_gain_ * (states_[i]->goal_ - states_[i]->start_) * canonical_system_state->getStateX()
-              + parameters_[i]->k_gain_ * states_[i]->f_ ) / dmp_time.getTau() );
+      double dt = dmp_time.getDeltaT() / static_cast<double> (num_iterations);
+      double x = canonical_system_state->getStateX();
 
-          states_[i]->current_.setXd( states_[i]->internal_.getXd() / dmp_time.getTau() );
-          states_[i]->current_.setXdd( states_[i]->internal_.getXdd() / dmp_time.getTau() );
+      // integrate all dimensions at once on the packed arrays
+      packStates();
+      packed_f_ = predictions_.array() * x;
+      for (int n = 0; n < num_iterations; ++n)
+      {
+        // compute transformation system
+        packed_internal_xdd_ = (packed_k_gains_ * (packed_goals_ - packed_x_)
+            - packed_d_gains_ * packed_internal_xd_
+            - packed_k_gains_ * (packed_goals_ - packed_starts_) * x
+            + packed_k_gains_ * packed_f_) / dmp_time.getTau();
 
-          // integrate the system twice
-          states_[i]->internal_.addXd(states_[i]->internal_.getXdd() * dt);
-          states_[i]->current_.addX(states_[i]->current_.getXd() * dt);
+        packed_xd_ = packed_internal_xd_ / dmp_time.getTau();
+        packed_xdd_ = packed_internal_xdd_ / dmp_time.getTau();
 
-        }
+        // integrate the system twice
+        packed_internal_xd_ += packed_internal_xdd_ * dt;
+        packed_x_ += packed_xd_ * dt;
       }
+      unpackStates();
       break;
     }
     case QUATERNION:
     {
 
+      // compute nonlinearity using LWR (the canonical system does not change during the iterations)
+      if (!predict(canonical_system_state->getStateX()))
+      {
+        Logger::logPrintf("Could not predict output (Real-time violation).", Logger::ERROR);
+        return false;
+      }
+
       double dt = dmp_time.getDeltaT() / static_cast<double> (num_iterations);
       for (int n = 0; n < num_iterations; ++n)
       {
@@ -344,14 +412,7 @@ bool NC2010TransformationSystem::integrate(const CSStatePtr canonical_system_sta
         Vector3d f;
         for (int i = 1; i < 4; ++i)
         {
-          // compute nonlinearity using LWR
-          double prediction = 0;
-          if (!parameters_[i]->lwr_model_->predict(canonical_system_state->getStateX(), prediction))
-          {
-            Logger::logPrintf("Could not predict output (Real-time violation).", Logger::ERROR);
-            return false;
-          }
-          f(i-1) = prediction * canonical_system_state->getStateX();
+          f(i-1) = predictions_(i) * canonical_system_state->getStateX();
         }
 
         // Put k- and d-gain values in matrices, because all output dimensions will be computed at
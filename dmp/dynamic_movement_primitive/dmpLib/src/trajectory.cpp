@@ -19,6 +19,13 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 // local include
 #include <dmp_lib/trajectory.h>
@@ -48,6 +55,180 @@ static const int MAX_VARNAME_LENGTH = 20;
 static const char* DEFAULT_VARIABLE_NAME = "name";
 static const char* DEFAULT_VARIABLE_UNIT = "unit";
 
+// binary trajectory file format
+static const char BINARY_FILE_MAGIC[8] = {'D', 'M', 'P', 'T', 'R', 'A', 'J', '\0'};
+static const uint32_t BINARY_FILE_VERSION = 1;
+static const uint32_t BINARY_FILE_BYTE_ORDER = 0x01020304;
+static const char* BINARY_FILE_NO_UNIT = "-";
+
+/*! Header of the binary trajectory file. It is followed by a table containing the name and the unit of each
+ * column (as null terminated strings) and the data of all columns (column-major, double precision), which
+ * starts at data_offset.
+ */
+struct BinaryTrajectoryFileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t num_rows;
+  uint32_t num_cols;
+  double sampling_frequency;
+  uint64_t data_offset;
+};
+
+// number of points added at the beginning and ending of the trajectory when computing derivatives
+static const int ADD_POS_POINTS = 4;
+
+static Trajectory::AllocationCounter allocation_counter = NULL;
+
+// REAL-TIME REQUIREMENTS
+static inline uint64_t getNumAllocations()
+{
+  if (allocation_counter == NULL)
+  {
+    return 0;
+  }
+  return allocation_counter();
+}
+
+// REAL-TIME REQUIREMENTS
+static inline void checkNumAllocations(const uint64_t num_allocations,
+                                       const char* function_name)
+{
+  if ((allocation_counter != NULL) && (allocation_counter() != num_allocations))
+  {
+    Logger::logPrintf("Trajectory::%s() allocated memory (Real-time violation).", Logger::FATAL, function_name);
+    assert(false);
+  }
+}
+
+/*! Five point stencil derivative of x at x[2]
+ * REAL-TIME REQUIREMENTS
+ */
+static inline double computeFivePointStencil(const double* x,
+                                             const double sampling_frequency)
+{
+  return ((x[0] - (8.0 * x[1]) + (8.0 * x[3]) - x[4]) / 12.0) * sampling_frequency;
+}
+
+/*! Computes first and second derivative of x[offset, offset + num_samples) by fitting a quadratic polynomial
+ * to a window of 2 * half_window + 1 samples. Beyond its ends, x is continued with its first and last value.
+ * REAL-TIME REQUIREMENTS
+ */
+static void computeSavitzkyGolay(const double* x,
+                                 const int length,
+                                 const int offset,
+                                 const int num_samples,
+                                 const int half_window,
+                                 const double sampling_frequency,
+                                 double* first_derivatives,
+                                 double* second_derivatives)
+{
+  // first derivative weights are k / sum_k(k^2), second derivative weights are 2 (k^2 - mean) / sum_k((k^2 - mean)^2)
+  const double sum_of_squares = static_cast<double> (half_window * (half_window + 1) * (2 * half_window + 1)) / 3.0;
+  const double mean_of_squares = sum_of_squares / static_cast<double> (2 * half_window + 1);
+  double sum_of_squared_deviations = 0.0;
+  for (int k = -half_window; k <= half_window; ++k)
+  {
+    const double deviation = static_cast<double> (k * k) - mean_of_squares;
+    sum_of_squared_deviations += deviation * deviation;
+  }
+  const double first_scale = sampling_frequency / sum_of_squares;
+  const double second_scale = 2.0 * sampling_frequency * sampling_frequency / sum_of_squared_deviations;
+
+  for (int i = 0; i < num_samples; ++i)
+  {
+    double first = 0.0;
+    double second = 0.0;
+    for (int k = -half_window; k <= half_window; ++k)
+    {
+      int index = offset + i + k;
+      if (index < 0)
+      {
+        index = 0;
+      }
+      else if (index >= length)
+      {
+        index = length - 1;
+      }
+      first += static_cast<double> (k) * x[index];
+      second += (static_cast<double> (k * k) - mean_of_squares) * x[index];
+    }
+    first_derivatives[i] = first * first_scale;
+    second_derivatives[i] = second * second_scale;
+  }
+}
+
+/*! Copies num_samples positions into padded_positions (of size length) and continues them with their first and last value
+ * REAL-TIME REQUIREMENTS
+ */
+static void padPositions(const double* positions,
+                         const int num_samples,
+                         const int num_leading_points,
+                         const int length,
+                         double* padded_positions)
+{
+  std::fill(padded_positions, padded_positions + num_leading_points, positions[0]);
+  std::copy(positions, positions + num_samples, padded_positions + num_leading_points);
+  std::fill(padded_positions + num_leading_points + num_samples, padded_positions + length, positions[num_samples - 1]);
+}
+
+/*! Computes positions, velocities, and accelerations of a single dimension from its padded positions
+ * REAL-TIME REQUIREMENTS
+ */
+static void derivePositions(const double* padded_positions,
+                            const int pos_length,
+                            const int vel_length,
+                            const int num_samples,
+                            const Trajectory::DerivativeMethod derivative_method,
+                            const int savitzky_golay_half_window,
+                            const double sampling_frequency,
+                            double* padded_velocities,
+                            double* positions,
+                            double* velocities,
+                            double* accelerations)
+{
+  if (derivative_method == Trajectory::FIVE_POINT_STENCIL)
+  {
+    // derive the positions
+    for (int i = 0; i < vel_length; ++i)
+    {
+      padded_velocities[i] = computeFivePointStencil(padded_positions + i, sampling_frequency);
+    }
+    // derive the velocities
+    for (int i = 0; i < num_samples; ++i)
+    {
+      accelerations[i] = computeFivePointStencil(padded_velocities + i, sampling_frequency);
+    }
+    std::copy(padded_velocities + 2, padded_velocities + 2 + num_samples, velocities);
+  }
+  else
+  {
+    computeSavitzkyGolay(padded_positions, pos_length, ADD_POS_POINTS, num_samples, savitzky_golay_half_window,
+                         sampling_frequency, velocities, accelerations);
+  }
+  std::copy(padded_positions + ADD_POS_POINTS, padded_positions + ADD_POS_POINTS + num_samples, positions);
+}
+
+/*! Moves the rows [num_rows_to_skip, num_rows_to_skip + num_rows) of the matrix to the top
+ * REAL-TIME REQUIREMENTS
+ */
+static void shiftRowsUp(MatrixXd& matrix,
+                        const int num_rows_to_skip,
+                        const int num_rows)
+{
+  for (int j = 0; j < matrix.cols(); ++j)
+  {
+    double* column = matrix.col(j).data();
+    memmove(column, column + num_rows_to_skip, num_rows * sizeof(double));
+  }
+}
+
+void Trajectory::setAllocationCounter(AllocationCounter counter)
+{
+  allocation_counter = counter;
+}
+
 bool Trajectory::initialize(const std::vector<std::string>& variable_names,
                             const double sampling_frequency,
                             const bool positions_only,
@@ -92,9 +273,46 @@ bool Trajectory::initialize(const std::vector<std::string>& variable_names,
     trajectory_velocities_ = MatrixXd::Zero(trajectory_length_, trajectory_dimension_);
     trajectory_accelerations_ = MatrixXd::Zero(trajectory_length_, trajectory_dimension_);
   }
+  fixed_capacity_ = false;
+  max_num_extra_points_ = 0;
+  padded_positions_.resize(0, 0);
+  padded_velocities_.resize(0, 0);
   return (initialized_ = true);
 }
 
+bool Trajectory::reserveFixedCapacity(const int max_num_extra_points)
+{
+  if (!initialized_)
+  {
+    Logger::logPrintf("Trajectory is not initialized. Cannot reserve memory.", Logger::ERROR);
+    return false;
+  }
+  if (max_num_extra_points < 0)
+  {
+    Logger::logPrintf("Maximum number of extra points >%i< is invalid. Cannot reserve memory.", Logger::ERROR, max_num_extra_points);
+    return false;
+  }
+
+  // the velocities and accelerations are needed once the derivatives are computed
+  if (trajectory_velocities_.rows() != trajectory_length_ || trajectory_velocities_.cols() != trajectory_dimension_)
+  {
+    trajectory_velocities_ = MatrixXd::Zero(trajectory_length_, trajectory_dimension_);
+  }
+  if (trajectory_accelerations_.rows() != trajectory_length_ || trajectory_accelerations_.cols() != trajectory_dimension_)
+  {
+    trajectory_accelerations_ = MatrixXd::Zero(trajectory_length_, trajectory_dimension_);
+  }
+
+  // the derivatives of at most trajectory_length_ - 2 * max_num_extra_points samples can be computed
+  const int max_pos_length = ADD_POS_POINTS + trajectory_length_ + ADD_POS_POINTS;
+  padded_positions_ = MatrixXd::Zero(max_pos_length, trajectory_dimension_);
+  padded_velocities_ = MatrixXd::Zero(max_pos_length - 4, trajectory_dimension_);
+
+  max_num_extra_points_ = max_num_extra_points;
+  fixed_capacity_ = true;
+  return true;
+}
+
 bool Trajectory::initializeWithMinJerk(const std::vector<std::string> & variable_names,
                                        const double sampling_frequency,
                                        const Eigen::VectorXd& start,
@@ -455,75 +673,49 @@ bool Trajectory::readFromCLMCFile(const string& file_name,
     variable_names_list = file_variable_names;
   }
 
-  for (int i = 0; i < (int)variable_names_list.size(); ++i)
+  // the first column with the given name is used
+  map<string, int> file_variable_indices;
+  for (int j = 0; j < (int)file_variable_names.size(); ++j)
   {
-    bool variable_name_found = false;
-    for (int j = 0; j < (int)file_variable_names.size(); ++j)
-    {
-      if (variable_names_list[i].compare(file_variable_names[j]) == 0)
-      {
-        variable_name_found = true;
-        position_variable_indices.push_back(j);
-        variable_names_.push_back(file_variable_names[j]);
-        variable_units_.push_back(file_variable_units[j]);
-        Logger::logPrintf("Read %s [%s].", Logger::DEBUG, variable_names_.back().c_str(), variable_units_.back().c_str());
+    file_variable_indices.insert(make_pair(file_variable_names[j], j));
+  }
 
-        if (!positions_only)
-        {
-          string velocity_variable_name = variable_names_list[i] + "d";
-          bool velocity_variable_name_found = false;
-          for (int s = 0; s < (int)file_variable_names.size(); ++s)
-          {
-            if (velocity_variable_name.compare(file_variable_names[s]) == 0)
-            {
-              velocity_variable_name_found = true;
-            }
-          }
-          if(!velocity_variable_name_found)
-          {
-            Logger::logPrintf("Could not find variable >%s<. Maybe use position only option.", Logger::ERROR, velocity_variable_name.c_str());
-            return false;
-          }
-
-          string acceleration_variable_name = variable_names_list[i] + "dd";
-          bool acceleration_variable_name_found = false;
-          for (int s = 0; s < (int)file_variable_names.size(); ++s)
-          {
-            if (acceleration_variable_name.compare(file_variable_names[s]) == 0)
-            {
-              acceleration_variable_name_found = true;
-            }
-          }
-          if(!acceleration_variable_name_found)
-          {
-            Logger::logPrintf("Could not find variable >%s<. Maybe use position only option.", Logger::ERROR, acceleration_variable_name.c_str());
-            return false;
-          }
-
-          for (int m = 0; m < (int)file_variable_names.size(); ++m)
-          {
-            if (velocity_variable_name.compare(file_variable_names[m]) == 0)
-            {
-              velocity_variable_indices.push_back(m);
-            }
-            if (acceleration_variable_name.compare(file_variable_names[m]) == 0)
-            {
-              acceleration_variable_indices.push_back(m);
-            }
-          }
-        }
-        if (variable_name_found)
-        {
-          break;
-        }
-      }
-    }
-    if (!variable_name_found)
+  for (int i = 0; i < (int)variable_names_list.size(); ++i)
+  {
+    map<string, int>::const_iterator it = file_variable_indices.find(variable_names_list[i]);
+    if (it == file_variable_indices.end())
     {
       Logger::logPrintf("Could not find variable named >%s< in trajectory file >%s<.", Logger::ERROR, variable_names_list[i].c_str(), file_name.c_str());
       fclose(fp);
       return false;
     }
+    position_variable_indices.push_back(it->second);
+    variable_names_.push_back(file_variable_names[it->second]);
+    variable_units_.push_back(file_variable_units[it->second]);
+    Logger::logPrintf("Read %s [%s].", Logger::DEBUG, variable_names_.back().c_str(), variable_units_.back().c_str());
+
+    if (!positions_only)
+    {
+      string velocity_variable_name = variable_names_list[i] + "d";
+      it = file_variable_indices.find(velocity_variable_name);
+      if (it == file_variable_indices.end())
+      {
+        Logger::logPrintf("Could not find variable >%s<. Maybe use position only option.", Logger::ERROR, velocity_variable_name.c_str());
+        fclose(fp);
+        return false;
+      }
+      velocity_variable_indices.push_back(it->second);
+
+      string acceleration_variable_name = variable_names_list[i] + "dd";
+      it = file_variable_indices.find(acceleration_variable_name);
+      if (it == file_variable_indices.end())
+      {
+        Logger::logPrintf("Could not find variable >%s<. Maybe use position only option.", Logger::ERROR, acceleration_variable_name.c_str());
+        fclose(fp);
+        return false;
+      }
+      acceleration_variable_indices.push_back(it->second);
+    }
   }
 
   // there are two extra blank chars at the end of the block and a line return which we must account for
@@ -809,6 +1001,303 @@ bool Trajectory::writeToCLMCFile(const std::string& file_name,
   return true;
 }
 
+bool Trajectory::readFromBinaryFile(const string& file_name,
+                                    const bool positions_only)
+{
+  std::vector<std::string> empty;
+  return readFromBinaryFile(file_name, empty, positions_only, false);
+}
+
+bool Trajectory::readFromBinaryFile(const string& file_name,
+                                    const vector<string>& variable_names,
+                                    const bool positions_only,
+                                    const bool use_variable_names)
+{
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    Logger::logPrintf("Cannot open file >%s< : %s.", Logger::ERROR, file_name.c_str(), strerror(errno));
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0)
+  {
+    Logger::logPrintf("Cannot stat file >%s< : %s.", Logger::ERROR, file_name.c_str(), strerror(errno));
+    close(fd);
+    return false;
+  }
+  const size_t file_size = static_cast<size_t> (file_stat.st_size);
+  if (file_size < sizeof(BinaryTrajectoryFileHeader))
+  {
+    Logger::logPrintf("File >%s< is too small to be a binary trajectory file.", Logger::ERROR, file_name.c_str());
+    close(fd);
+    return false;
+  }
+  void* file_data = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (file_data == MAP_FAILED)
+  {
+    Logger::logPrintf("Cannot mmap file >%s< : %s.", Logger::ERROR, file_name.c_str(), strerror(errno));
+    return false;
+  }
+  bool success = readFromBinaryBuffer(file_name, static_cast<const char*> (file_data), file_size, variable_names, positions_only, use_variable_names);
+  munmap(file_data, file_size);
+  return success;
+}
+
+bool Trajectory::readFromBinaryBuffer(const string& file_name,
+                                      const char* buffer,
+                                      const size_t buffer_size,
+                                      const vector<string>& variable_names,
+                                      const bool positions_only,
+                                      const bool use_variable_names)
+{
+  BinaryTrajectoryFileHeader header;
+  memcpy(&header, buffer, sizeof(header));
+  if (memcmp(header.magic, BINARY_FILE_MAGIC, sizeof(BINARY_FILE_MAGIC)) != 0)
+  {
+    Logger::logPrintf("File >%s< is not a binary trajectory file.", Logger::ERROR, file_name.c_str());
+    return false;
+  }
+  if (header.byte_order != BINARY_FILE_BYTE_ORDER)
+  {
+    Logger::logPrintf("File >%s< has been written on a platform with different byte order.", Logger::ERROR, file_name.c_str());
+    return false;
+  }
+  if (header.version != BINARY_FILE_VERSION)
+  {
+    Logger::logPrintf("Version >%i< of file >%s< is not supported (expected version >%i<).", Logger::ERROR,
+                      (int)header.version, file_name.c_str(), (int)BINARY_FILE_VERSION);
+    return false;
+  }
+  const int num_rows = static_cast<int> (header.num_rows);
+  const int num_cols = static_cast<int> (header.num_cols);
+  if ((num_cols <= 0) || (num_rows <= 0) || (num_cols > ABSOLUTE_MAX_TRAJECTORY_DIMENSION) || (num_rows > ABSOLUTE_MAX_TRAJECTORY_LENGTH))
+  {
+    Logger::logPrintf("Values for number of columns >%i< and rows >%i< are out of bound (%i x %i).", Logger::ERROR, num_cols, num_rows,
+                      ABSOLUTE_MAX_TRAJECTORY_DIMENSION, ABSOLUTE_MAX_TRAJECTORY_LENGTH);
+    return false;
+  }
+  if (header.sampling_frequency <= 0)
+  {
+    Logger::logPrintf("Read implausible sampling frequency >%.1f<.", Logger::ERROR, header.sampling_frequency);
+    return false;
+  }
+  const size_t data_size = static_cast<size_t> (num_rows) * static_cast<size_t> (num_cols) * sizeof(double);
+  if ((header.data_offset < sizeof(header)) || (header.data_offset % sizeof(double) != 0)
+      || (header.data_offset > buffer_size) || (buffer_size - header.data_offset < data_size))
+  {
+    Logger::logPrintf("File >%s< is truncated or corrupted.", Logger::ERROR, file_name.c_str());
+    return false;
+  }
+
+  // read column names and units
+  vector<string> file_variable_names;
+  vector<string> file_variable_units;
+  map<string, int> file_variable_indices;
+  const char* entry = buffer + sizeof(header);
+  const char* table_end = buffer + header.data_offset;
+  for (int j = 0; j < num_cols; ++j)
+  {
+    const char* name_end = static_cast<const char*> (memchr(entry, '\0', table_end - entry));
+    const char* unit_end = NULL;
+    if (name_end != NULL)
+    {
+      unit_end = static_cast<const char*> (memchr(name_end + 1, '\0', table_end - name_end - 1));
+    }
+    if (unit_end == NULL)
+    {
+      Logger::logPrintf("Cannot read variable names and units.", Logger::ERROR);
+      return false;
+    }
+    file_variable_names.push_back(string(entry, name_end));
+    file_variable_units.push_back(string(name_end + 1, unit_end));
+    // the first column with the given name is used
+    file_variable_indices.insert(make_pair(file_variable_names.back(), j));
+    entry = unit_end + 1;
+  }
+
+  vector<string> variable_names_list = variable_names;
+  if (!use_variable_names)
+  {
+    // read ALL variables...
+    variable_names_list = file_variable_names;
+  }
+
+  vector<int> position_variable_indices;
+  vector<int> velocity_variable_indices;
+  vector<int> acceleration_variable_indices;
+  vector<string> variable_units;
+  for (int i = 0; i < (int)variable_names_list.size(); ++i)
+  {
+    map<string, int>::const_iterator it = file_variable_indices.find(variable_names_list[i]);
+    if (it == file_variable_indices.end())
+    {
+      Logger::logPrintf("Could not find variable named >%s< in trajectory file >%s<.", Logger::ERROR, variable_names_list[i].c_str(), file_name.c_str());
+      return false;
+    }
+    position_variable_indices.push_back(it->second);
+    variable_units.push_back(file_variable_units[it->second]);
+    if (!positions_only)
+    {
+      const string velocity_variable_name = variable_names_list[i] + "d";
+      it = file_variable_indices.find(velocity_variable_name);
+      if (it == file_variable_indices.end())
+      {
+        Logger::logPrintf("Could not find variable >%s<. Maybe use position only option.", Logger::ERROR, velocity_variable_name.c_str());
+        return false;
+      }
+      velocity_variable_indices.push_back(it->second);
+
+      const string acceleration_variable_name = variable_names_list[i] + "dd";
+      it = file_variable_indices.find(acceleration_variable_name);
+      if (it == file_variable_indices.end())
+      {
+        Logger::logPrintf("Could not find variable >%s<. Maybe use position only option.", Logger::ERROR, acceleration_variable_name.c_str());
+        return false;
+      }
+      acceleration_variable_indices.push_back(it->second);
+    }
+  }
+
+  // initialize trajectory and allocate memory to hold the trajectory
+  if (!initialize(variable_names_list, header.sampling_frequency, positions_only, num_rows))
+  {
+    Logger::logPrintf("Could not initialize trajectory. Reading from file failed.", Logger::ERROR);
+    return false;
+  }
+  variable_units_ = variable_units;
+
+  // each column is stored contiguously, both in the file and in the trajectory
+  const double* data = reinterpret_cast<const double*> (buffer + header.data_offset);
+  const size_t column_size = static_cast<size_t> (num_rows) * sizeof(double);
+  for (int j = 0; j < trajectory_dimension_; ++j)
+  {
+    memcpy(trajectory_positions_.col(j).data(), data + position_variable_indices[j] * num_rows, column_size);
+    if (!positions_only)
+    {
+      memcpy(trajectory_velocities_.col(j).data(), data + velocity_variable_indices[j] * num_rows, column_size);
+      memcpy(trajectory_accelerations_.col(j).data(), data + acceleration_variable_indices[j] * num_rows, column_size);
+    }
+  }
+  index_to_last_trajectory_point_ = trajectory_length_;
+  trajectory_duration_ = static_cast<double> (trajectory_length_) / sampling_frequency_;
+
+  Logger::logPrintf(positions_only, "Read position trajectory containing >%i< variables with each >%i< data points.", Logger::INFO, trajectory_dimension_,
+                    trajectory_length_);
+  Logger::logPrintf(!positions_only, "Read trajectory containing position, velocity, and acceleration of >%i< variables with each >%i< data points.",
+                    Logger::INFO, trajectory_dimension_, trajectory_length_);
+  return true;
+}
+
+bool Trajectory::writeToBinaryFile(const std::string& file_name,
+                                   const bool positions_only) const
+{
+  if (!positions_only && positions_only_)
+  {
+    Logger::logPrintf("Only positions are contained in trajectory, cannot write more into >%s<.", Logger::ERROR, file_name.c_str());
+    return false;
+  }
+  if (sampling_frequency_ <= 0.0)
+  {
+    Logger::logPrintf("Sampling frequency >%.1f< is invalid.", Logger::ERROR, sampling_frequency_);
+    return false;
+  }
+
+  // positions are followed by velocities and accelerations
+  int num_blocks = POS_VEL_ACC;
+  if (positions_only)
+  {
+    num_blocks = 1;
+  }
+  const char* suffixes[POS_VEL_ACC] = {"", "d", "dd"};
+  const char* unit_suffixes[POS_VEL_ACC] = {"", "/s", "/s^2"};
+  const MatrixXd* blocks[POS_VEL_ACC] = {&trajectory_positions_, &trajectory_velocities_, &trajectory_accelerations_};
+
+  string column_table;
+  for (int b = 0; b < num_blocks; ++b)
+  {
+    for (int i = 0; i < trajectory_dimension_; ++i)
+    {
+      string variable_name = variable_names_[i];
+      if (variable_name.empty())
+      {
+        Logger::logPrintf("Variable name is empty.", Logger::WARN);
+        char tmp[MAX_VARNAME_LENGTH];
+        sprintf(tmp, "%s_%d", DEFAULT_VARIABLE_NAME, i);
+        variable_name.assign(tmp);
+      }
+      column_table.append(variable_name + suffixes[b]);
+      column_table.push_back('\0');
+
+      string variable_unit = BINARY_FILE_NO_UNIT;
+      if (variable_units_.size() == variable_names_.size())
+      {
+        variable_unit = variable_units_[i] + unit_suffixes[b];
+      }
+      column_table.append(variable_unit);
+      column_table.push_back('\0');
+    }
+  }
+
+  BinaryTrajectoryFileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, BINARY_FILE_MAGIC, sizeof(BINARY_FILE_MAGIC));
+  header.version = BINARY_FILE_VERSION;
+  header.byte_order = BINARY_FILE_BYTE_ORDER;
+  header.num_rows = static_cast<uint32_t> (index_to_last_trajectory_point_);
+  header.num_cols = static_cast<uint32_t> (num_blocks * trajectory_dimension_);
+  header.sampling_frequency = sampling_frequency_;
+  // align data such that it can be accessed directly when memory mapped
+  const size_t table_end = sizeof(header) + column_table.size();
+  header.data_offset = ((table_end + sizeof(double) - 1) / sizeof(double)) * sizeof(double);
+  column_table.append(header.data_offset - table_end, '\0');
+
+  FILE *fp;
+  if ((fp = fopen(file_name.c_str(), "wb")) == NULL)
+  {
+    Logger::logPrintf("Cannot fopen file >%s< : %s.", Logger::ERROR, file_name.c_str(), strerror(errno));
+    return false;
+  }
+  if ((fwrite(&header, sizeof(header), 1, fp) != 1) || (fwrite(column_table.data(), 1, column_table.size(), fp) != column_table.size()))
+  {
+    Logger::logPrintf("Cannot fwrite header of >%s<.", Logger::ERROR, file_name.c_str());
+    fclose(fp);
+    return false;
+  }
+  for (int b = 0; b < num_blocks; ++b)
+  {
+    for (int j = 0; j < trajectory_dimension_; ++j)
+    {
+      if (fwrite(blocks[b]->col(j).data(), sizeof(double), index_to_last_trajectory_point_, fp) != (unsigned)index_to_last_trajectory_point_)
+      {
+        Logger::logPrintf("Cannot fwrite trajectory data.", Logger::ERROR);
+        fclose(fp);
+        return false;
+      }
+    }
+  }
+  if (fclose(fp) != 0)
+  {
+    Logger::logPrintf("Cannot close file >%s< : %s.", Logger::ERROR, file_name.c_str(), strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool Trajectory::convertCLMCFileToBinaryFile(const std::string& clmc_file_name,
+                                             const std::string& binary_file_name)
+{
+  // velocities and accelerations are stored as separate columns (named <name>d and <name>dd)
+  Trajectory trajectory;
+  if (!trajectory.readFromCLMCFile(clmc_file_name, true))
+  {
+    Logger::logPrintf("Could not read clmc file >%s<.", Logger::ERROR, clmc_file_name.c_str());
+    return false;
+  }
+  return trajectory.writeToBinaryFile(binary_file_name, true);
+}
+
 bool Trajectory::rearange(const vector<string>& variable_names_order)
 {
 
@@ -1048,90 +1537,131 @@ bool Trajectory::blowUp(Trajectory& trajectory, const int num_extra_points)
 
 bool Trajectory::computeDerivatives(const int num_extra_points)
 {
-  const int add_pos_points = 4;
-  const int pos_length = add_pos_points + num_extra_points + trajectory_length_ + num_extra_points + add_pos_points;
+  return computeDerivatives(num_extra_points, FIVE_POINT_STENCIL);
+}
+
+bool Trajectory::computeDerivatives(const int num_extra_points,
+                                    const DerivativeMethod derivative_method,
+                                    const int savitzky_golay_half_window,
+                                    const int num_threads)
+{
+  const uint64_t num_allocations = getNumAllocations();
+  if (num_extra_points < 0)
+  {
+    Logger::logPrintf("Number of extra points >%i< is invalid. Cannot compute derivatives.", Logger::ERROR, num_extra_points);
+    return false;
+  }
+  if ((derivative_method == SAVITZKY_GOLAY) && (savitzky_golay_half_window < 1))
+  {
+    Logger::logPrintf("Savitzky-Golay half window size >%i< is invalid. Cannot compute derivatives.", Logger::ERROR, savitzky_golay_half_window);
+    return false;
+  }
+  if (num_threads < 1)
+  {
+    Logger::logPrintf("Number of threads >%i< is invalid. Cannot compute derivatives.", Logger::ERROR, num_threads);
+    return false;
+  }
+
+  // in fixed capacity mode only the contained samples are used
+  int num_samples = trajectory_length_;
+  if (fixed_capacity_)
+  {
+    num_samples = index_to_last_trajectory_point_;
+  }
+  const int pos_length = ADD_POS_POINTS + num_extra_points + num_samples + num_extra_points + ADD_POS_POINTS;
   const int vel_length = - 2 + pos_length - 2;
-  const int acc_length = - 2 + vel_length - 2;
-  const int new_trajectory_length = num_extra_points + trajectory_length_ + num_extra_points;
+  const int new_trajectory_length = num_extra_points + num_samples + num_extra_points;
 
-  // add points at the beginning and ending
-  MatrixXd tmp_trajectory_pos = MatrixXd::Zero(pos_length, trajectory_dimension_);
-  for (int i = 0; i < pos_length; i++)
+  // threads are not spawned in fixed capacity mode
+  int num_used_threads = num_threads;
+  if (fixed_capacity_)
   {
-    for (int j = 0; j < trajectory_dimension_; j++)
+    num_used_threads = 1;
+    if (num_samples == 0)
     {
-      if (i < add_pos_points + num_extra_points)
-      {
-        tmp_trajectory_pos(i, j) = trajectory_positions_(0, j);
-      }
-      else if (i < add_pos_points + num_extra_points + trajectory_length_)
-      {
-        tmp_trajectory_pos(i, j) = trajectory_positions_(i - add_pos_points - num_extra_points, j);
-      }
-      else
-      {
-        tmp_trajectory_pos(i, j) = tmp_trajectory_pos(i - 1, j);
-      }
+      Logger::logPrintf("Trajectory does not contain any samples. Cannot compute derivatives.", Logger::ERROR);
+      return false;
     }
+    if (num_extra_points > max_num_extra_points_ || new_trajectory_length > trajectory_length_)
+    {
+      Logger::logPrintf("Trajectory with >%i< samples cannot hold >%i< extra points at each end (Real-time violation). Cannot compute derivatives.",
+                        Logger::ERROR, num_samples, num_extra_points);
+      return false;
+    }
+  }
+  else
+  {
+    padded_positions_.resize(pos_length, trajectory_dimension_);
+    padded_velocities_.resize(vel_length, trajectory_dimension_);
   }
 
-  // derive the positions
-  MatrixXd tmp_trajectory_vel = MatrixXd::Zero(vel_length, trajectory_dimension_);
-  for (int i = 0; i < vel_length; i++)
+  // add points at the beginning and ending
+  // (the parallel regions are only entered when threads are used since OpenMP allocates a team even for a single thread)
+  const int num_leading_points = ADD_POS_POINTS + num_extra_points;
+  if (num_used_threads > 1)
   {
-    for (int j = 0; j < trajectory_dimension_; j++)
+#pragma omp parallel for num_threads(num_used_threads)
+    for (int j = 0; j < trajectory_dimension_; ++j)
     {
-      tmp_trajectory_vel(i, j) = (tmp_trajectory_pos(i, j) - (static_cast<double> (8.0) * tmp_trajectory_pos(i + 1, j)) + (static_cast<double> (8.0)
-          * tmp_trajectory_pos(i + 3, j)) - tmp_trajectory_pos(i + 4, j)) / static_cast<double> (12.0);
-      tmp_trajectory_vel(i, j) *= sampling_frequency_;
+      padPositions(trajectory_positions_.col(j).data(), num_samples, num_leading_points, pos_length, padded_positions_.col(j).data());
     }
   }
-
-  // derive the velocities
-  MatrixXd tmp_trajectory_acc = MatrixXd::Zero(acc_length, trajectory_dimension_);
-  for (int i = 0; i < acc_length; i++)
+  else
   {
-    for (int j = 0; j < trajectory_dimension_; j++)
+    for (int j = 0; j < trajectory_dimension_; ++j)
     {
-      tmp_trajectory_acc(i, j) = (tmp_trajectory_vel(i, j) - (static_cast<double> (8.0) * tmp_trajectory_vel(i + 1, j)) + (static_cast<double> (8.0)
-          * tmp_trajectory_vel(i + 3, j)) - tmp_trajectory_vel(i + 4, j)) / static_cast<double> (12.0);
-      tmp_trajectory_acc(i, j) *= sampling_frequency_;
+      padPositions(trajectory_positions_.col(j).data(), num_samples, num_leading_points, pos_length, padded_positions_.col(j).data());
     }
   }
 
-  // zero out trajectory
-  clear();
-
-  // resize trajectory
-  trajectory_length_ = new_trajectory_length;
+  if (!fixed_capacity_)
+  {
+    // resize trajectory
+    trajectory_length_ = new_trajectory_length;
+    trajectory_positions_.resize(trajectory_length_, trajectory_dimension_);
+    trajectory_velocities_.resize(trajectory_length_, trajectory_dimension_);
+    trajectory_accelerations_.resize(trajectory_length_, trajectory_dimension_);
+  }
   positions_only_ = false;
-  trajectory_positions_ = MatrixXd::Zero(trajectory_length_, trajectory_dimension_);
-  trajectory_velocities_ = MatrixXd::Zero(trajectory_length_, trajectory_dimension_);
-  trajectory_accelerations_ = MatrixXd::Zero(trajectory_length_, trajectory_dimension_);
 
-  VectorXd trajectory_positions = VectorXd::Zero(trajectory_dimension_);
-  VectorXd trajectory_velocities = VectorXd::Zero(trajectory_dimension_);
-  VectorXd trajectory_accelerations = VectorXd::Zero(trajectory_dimension_);
-  for (int i = 0; i < acc_length; ++i)
+  if (num_used_threads > 1)
   {
+#pragma omp parallel for num_threads(num_used_threads)
     for (int j = 0; j < trajectory_dimension_; ++j)
     {
-      trajectory_positions(j) = tmp_trajectory_pos(i + 4, j);
-      trajectory_velocities(j) = tmp_trajectory_vel(i + 2, j);
-      trajectory_accelerations(j) = tmp_trajectory_acc(i + 0, j);
+      derivePositions(padded_positions_.col(j).data(), pos_length, vel_length, new_trajectory_length, derivative_method, savitzky_golay_half_window,
+                      sampling_frequency_, padded_velocities_.col(j).data(), trajectory_positions_.col(j).data(),
+                      trajectory_velocities_.col(j).data(), trajectory_accelerations_.col(j).data());
     }
-    if(!add(trajectory_positions, trajectory_velocities, trajectory_accelerations))
+  }
+  else
+  {
+    for (int j = 0; j < trajectory_dimension_; ++j)
     {
-      Logger::logPrintf("Could not add trajectory point.", Logger::ERROR);
-      return false;
+      derivePositions(padded_positions_.col(j).data(), pos_length, vel_length, new_trajectory_length, derivative_method, savitzky_golay_half_window,
+                      sampling_frequency_, padded_velocities_.col(j).data(), trajectory_positions_.col(j).data(),
+                      trajectory_velocities_.col(j).data(), trajectory_accelerations_.col(j).data());
     }
   }
 
+  index_to_last_trajectory_point_ = new_trajectory_length;
+  trajectory_duration_ = static_cast<double> (index_to_last_trajectory_point_) / sampling_frequency_;
+
+  if (fixed_capacity_)
+  {
+    checkNumAllocations(num_allocations, "computeDerivatives");
+  }
+  else
+  {
+    padded_positions_.resize(0, 0);
+    padded_velocities_.resize(0, 0);
+  }
   return true;
 }
 
 bool Trajectory::crop(const int num_trajectory_points, bool crop_the_end)
 {
+  const uint64_t num_allocations = getNumAllocations();
   if(num_trajectory_points<=0)
   {
     Logger::logPrintf("Cannot shrink the trajectory by >%i< trajectory points.", Logger::ERROR, num_trajectory_points);
@@ -1149,50 +1679,28 @@ bool Trajectory::crop(const int num_trajectory_points, bool crop_the_end)
     return false;
   }
 
-  // shrink
-  MatrixXd trajectory_data = MatrixXd::Zero(trajectory_length_, trajectory_dimension_);
-  if(crop_the_end)
+  // shrink in place
+  if(!crop_the_end)
   {
-    trajectory_data.setZero(trajectory_length_, trajectory_dimension_);
-    trajectory_data.block(0, 0, new_index_to_last_trajectory_point, trajectory_dimension_)
-        = trajectory_positions_.block(0, 0, new_index_to_last_trajectory_point, trajectory_dimension_);
-    trajectory_positions_ = trajectory_data;
+    shiftRowsUp(trajectory_positions_, num_trajectory_points, new_index_to_last_trajectory_point);
     if(!positions_only_)
     {
-      trajectory_data.setZero(trajectory_length_, trajectory_dimension_);
-      trajectory_data.block(0, 0, new_index_to_last_trajectory_point, trajectory_dimension_)
-          = trajectory_velocities_.block(0, 0, new_index_to_last_trajectory_point, trajectory_dimension_);
-      trajectory_velocities_ = trajectory_data;
-      trajectory_data.setZero(trajectory_length_, trajectory_dimension_);
-      trajectory_data.block(0, 0, new_index_to_last_trajectory_point, trajectory_dimension_)
-          = trajectory_accelerations_.block(0, 0, new_index_to_last_trajectory_point, trajectory_dimension_);
-      trajectory_accelerations_ = trajectory_data;
+      shiftRowsUp(trajectory_velocities_, num_trajectory_points, new_index_to_last_trajectory_point);
+      shiftRowsUp(trajectory_accelerations_, num_trajectory_points, new_index_to_last_trajectory_point);
     }
   }
-  else
+  trajectory_positions_.block(new_index_to_last_trajectory_point, 0, num_trajectory_points, trajectory_dimension_).setZero();
+  if(!positions_only_)
   {
-    trajectory_data.setZero(trajectory_length_, trajectory_dimension_);
-    trajectory_data.block(0, 0, new_index_to_last_trajectory_point, trajectory_dimension_)
-        = trajectory_positions_.block(num_trajectory_points, 0, new_index_to_last_trajectory_point, trajectory_dimension_);
-    trajectory_positions_ = trajectory_data;
-    if(!positions_only_)
-    {
-      trajectory_data.setZero(trajectory_length_, trajectory_dimension_);
-      trajectory_data.block(0, 0, new_index_to_last_trajectory_point, trajectory_dimension_)
-          = trajectory_velocities_.block(num_trajectory_points, 0, new_index_to_last_trajectory_point, trajectory_dimension_);
-      trajectory_velocities_ = trajectory_data;
-
-      trajectory_data.setZero(trajectory_length_, trajectory_dimension_);
-      trajectory_data.block(0, 0, new_index_to_last_trajectory_point, trajectory_dimension_)
-          = trajectory_accelerations_.block(num_trajectory_points, 0, new_index_to_last_trajectory_point, trajectory_dimension_);
-      trajectory_accelerations_ = trajectory_data;
-    }
+    trajectory_velocities_.block(new_index_to_last_trajectory_point, 0, num_trajectory_points, trajectory_dimension_).setZero();
+    trajectory_accelerations_.block(new_index_to_last_trajectory_point, 0, num_trajectory_points, trajectory_dimension_).setZero();
   }
 
   index_to_last_trajectory_point_ = new_index_to_last_trajectory_point;
 
   // compute new duration
   trajectory_duration_ = static_cast<double> (trajectory_length_) / sampling_frequency_;
+  checkNumAllocations(num_allocations, "crop");
   return true;
 }
 
@@ -1271,6 +1779,7 @@ bool Trajectory::add(const VectorXd& trajectory_positons,
     return add(trajectory_positons, true);
   }
 
+  const uint64_t num_allocations = getNumAllocations();
   assert(initialized_);
   assert(trajectory_positons.size() == trajectory_velocities.size());
   assert(trajectory_positons.size() == trajectory_accelerations.size());
@@ -1282,7 +1791,7 @@ bool Trajectory::add(const VectorXd& trajectory_positons,
                       Logger::ERROR, sampling_frequency_);
     return false;
   }
-  if (!canHold(index_to_last_trajectory_point_, trajectory_positons.size(), false))
+  if (!canHold(index_to_last_trajectory_point_ + 1, trajectory_positons.size(), false))
   {
     return false;
   }
@@ -1296,6 +1805,7 @@ bool Trajectory::add(const VectorXd& trajectory_positons,
   trajectory_duration_ = static_cast<double> (index_to_last_trajectory_point_) / sampling_frequency_;
   // Logger::logPrintf("Setting trajectory duration to >%.1f< seconds.", Logger::DEBUG, trajectory_duration_);
 
+  checkNumAllocations(num_allocations, "add");
   return true;
 }
 
@@ -1304,6 +1814,7 @@ bool Trajectory::add(const VectorXd& trajectory_positons,
                      const bool positions_only)
 {
   // TODO: check whether all this check should be done inside
+  const uint64_t num_allocations = getNumAllocations();
   assert(initialized_);
   if(trajectory_positons.size() != trajectory_dimension_)
   {
@@ -1317,7 +1828,7 @@ bool Trajectory::add(const VectorXd& trajectory_positons,
                       Logger::ERROR, sampling_frequency_);
     return false;
   }
-  if (!canHold(index_to_last_trajectory_point_, trajectory_positons.size(), positions_only))
+  if (!canHold(index_to_last_trajectory_point_ + 1, trajectory_positons.size(), positions_only))
   {
     return false;
   }
@@ -1329,6 +1840,7 @@ bool Trajectory::add(const VectorXd& trajectory_positons,
   trajectory_duration_ = static_cast<double> (index_to_last_trajectory_point_) / sampling_frequency_;
   // Logger::logPrintf("Setting trajectory duration to >%.1f< seconds.", Logger::DEBUG, trajectory_duration_);
 
+  checkNumAllocations(num_allocations, "add");
   return true;
 }
 
@@ -54,9 +54,66 @@ bool TransformationSystem::initialize(const std::vector<TSParamPtr> parameters,
   parameters_ = parameters;
   states_ = states;
   integration_method_ = integration_method;
+  initializeBasisFunctions();
   return (initialized_ = true);
 }
 
+void TransformationSystem::initializeBasisFunctions()
+{
+  predictions_ = Eigen::VectorXd::Zero(parameters_.size());
+  shared_basis_functions_ = !parameters_.empty();
+  for (int i = 1; shared_basis_functions_ && i < (int)parameters_.size(); ++i)
+  {
+    shared_basis_functions_ = parameters_[0]->lwr_model_->hasSameReceptiveFields(*parameters_[i]->lwr_model_);
+  }
+  kernel_revisions_.clear();
+  if (shared_basis_functions_)
+  {
+    basis_functions_ = Eigen::VectorXd::Zero(parameters_[0]->lwr_model_->getNumRFS());
+    for (int i = 0; i < (int)parameters_.size(); ++i)
+    {
+      kernel_revisions_.push_back(parameters_[i]->lwr_model_->getKernelRevision());
+    }
+  }
+  else
+  {
+    basis_functions_.resize(0);
+  }
+}
+
+// REAL-TIME REQUIREMENTS
+bool TransformationSystem::predict(const double x_query)
+{
+  // the lwr models are shared, their receptive fields may have been changed through them
+  for (int i = 0; shared_basis_functions_ && i < (int)parameters_.size(); ++i)
+  {
+    shared_basis_functions_ = (parameters_[i]->lwr_model_->getKernelRevision() == kernel_revisions_[i]);
+  }
+  if (shared_basis_functions_)
+  {
+    if (!parameters_[0]->lwr_model_->generateNormalizedBasisFunctionVector(x_query, basis_functions_))
+    {
+      return false;
+    }
+    for (int i = 0; i < (int)parameters_.size(); ++i)
+    {
+      if (!parameters_[i]->lwr_model_->predict(x_query, basis_functions_, predictions_(i)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  for (int i = 0; i < (int)parameters_.size(); ++i)
+  {
+    if (!parameters_[i]->lwr_model_->predict(x_query, predictions_(i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool TransformationSystem::get(std::vector<TSParamConstPtr>& parameters,
                                std::vector<TSStateConstPtr>& states,
                                IntegrationMethod& integration_method) const
@@ -390,6 +447,41 @@ void TransformationSystem::getNames(vector<string>& names) const
   }
 }
 
+bool TransformationSystem::setKernelCutoff(const double kernel_cutoff)
+{
+  if (!initialized_)
+  {
+    Logger::logPrintf("Transformation system is not initialized, cannot set kernel cutoff.", Logger::ERROR);
+    return false;
+  }
+  for (int i = 0; i < (int)parameters_.size(); ++i)
+  {
+    if (!parameters_[i]->lwr_model_->setKernelCutoff(kernel_cutoff))
+    {
+      Logger::logPrintf("Could not set kernel cutoff of dimension >%i<.", Logger::ERROR, i);
+      initializeBasisFunctions();
+      return false;
+    }
+  }
+  initializeBasisFunctions();
+  return true;
+}
+
+bool TransformationSystem::getKernelCutoffs(std::vector<double>& kernel_cutoffs) const
+{
+  if (!initialized_)
+  {
+    Logger::logPrintf("Transformation system is not initialized, cannot return kernel cutoffs.", Logger::ERROR);
+    return false;
+  }
+  kernel_cutoffs.clear();
+  for (int i = 0; i < (int)parameters_.size(); ++i)
+  {
+    kernel_cutoffs.push_back(parameters_[i]->lwr_model_->getKernelCutoff());
+  }
+  return true;
+}
+
 bool TransformationSystem::setIntegrationMethod(IntegrationMethod integration_method)
 {
   if((integration_method == QUATERNION) && (getNumDimensions() != 4))
@@ -28,7 +28,12 @@ TransformationSystemParameters& TransformationSystemParameters::operator=(const
 {
   Logger::logPrintf("TransformationSystemParameters assignment.", Logger::DEBUG);
 
-  assert(Utilities<lwr_lib::LWR>::assign(lwr_model_, parameters.lwr_model_));
+  if (!Utilities<lwr_lib::LWR>::assign(lwr_model_, parameters.lwr_model_))
+  {
+    Logger::logPrintf("Could not assign TransformationSystemParameters.", Logger::FATAL);
+    initialized_ = false;
+    return *this;
+  }
   initial_start_ = parameters.initial_start_;
   initial_goal_ = parameters.initial_goal_;
   name_.assign(parameters.name_);
@@ -48,7 +53,11 @@ bool TransformationSystemParameters::initialize(const lwr_lib::LWRPtr lwr_model,
     Logger::logPrintf("Cannot initialize transformation system parameters from uninitialized LWR model.", Logger::ERROR);
     return (initialized_ = false);
   }
-  assert(Utilities<lwr_lib::LWR>::assign(lwr_model_, lwr_model));
+  if (!Utilities<lwr_lib::LWR>::assign(lwr_model_, lwr_model))
+  {
+    Logger::logPrintf("Could not initialize TransformationSystemParameters.", Logger::FATAL);
+    return (initialized_ = false);
+  }
   name_.assign(name);
   initial_start_ = initial_start;
   initial_goal_ = initial_goal;
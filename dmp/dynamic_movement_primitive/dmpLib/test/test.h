@@ -27,6 +27,8 @@
 // local includes
 #include "test_dynamic_movement_primitive.h"
 #include "test_trajectory.h"
+#include "test_dynamic_movement_primitive_batch.h"
+#include "test_kernel_cutoff.h"
 #include "test_data.h"
 #include "icra2009_test.h"
 
@@ -106,6 +108,25 @@ inline bool Test::test(const std::string base_directory, const bool regenerate_r
     return false;
   }
 
+  if (!test_dmp::TestDMPBatch::test(testdata))
+  {
+    dmp_lib::Logger::logPrintf("DMP batch test failed.", dmp_lib::Logger::ERROR);
+    return false;
+  }
+
+  // the quaternion transformation system shares its basis functions among four dimensions
+  if (!testdata.initialize(TestData::QUAT_TEST))
+  {
+    dmp_lib::Logger::logPrintf("Could not initialize test data.");
+    return false;
+  }
+
+  if (!test_dmp::TestKernelCutoff::test(testdata))
+  {
+    dmp_lib::Logger::logPrintf("Kernel cutoff test failed.", dmp_lib::Logger::ERROR);
+    return false;
+  }
+
   dmp_lib::Logger::logPrintf("Test finished successful.", dmp_lib::Logger::INFO);
   return true;
 }
@@ -0,0 +1,186 @@
+/*********************************************************************
+ Computational Learning and Motor Control Lab
+ University of Southern California
+ Prof. Stefan Schaal
+ *********************************************************************
+ \remarks		...
+ 
+ \file		test_dynamic_movement_primitive_batch.cpp
+
+ \date		Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <vector>
+#include <math.h>
+
+#include <Eigen/Core>
+
+#include <dmp_lib/logger.h>
+#include <dmp_lib/icra2009_dynamic_movement_primitive.h>
+#include <dmp_lib/dynamic_movement_primitive_batch.h>
+
+// local includes
+#include "test_dynamic_movement_primitive_batch.h"
+#include "icra2009_test.h"
+
+using namespace std;
+using namespace dmp_lib;
+
+// import most common Eigen types
+using namespace Eigen;
+
+namespace test_dmp
+{
+
+static const int NUM_ROLLOUTS = 7;
+static const int NUM_SAMPLES = 150;
+static const int NUM_THREADS = 3;
+static const double SAMPLING_FREQUENCY = 100.0;
+static const double UNSET_VALUE = 1e10;
+static const double ERROR_THRESHOLD = 1e-10;
+
+/*! Propagates a copy of dmp using propagateStep, rows after the end of the movement are left at zero
+ */
+static bool propagateSequentially(const ICRA2009DMP& dmp,
+                                  const vector<VectorXd>& thetas,
+                                  const VectorXd& start,
+                                  const VectorXd& goal,
+                                  const double duration,
+                                  MatrixXd& positions,
+                                  MatrixXd& velocities,
+                                  MatrixXd& accelerations)
+{
+  // the (implicit) copy constructor would share the parameters of dmp
+  ICRA2009DMP sequential_dmp;
+  sequential_dmp = dmp;
+  if (!sequential_dmp.setThetas(thetas)
+      || !sequential_dmp.setup(start, goal, duration, static_cast<double> (NUM_SAMPLES) / duration))
+  {
+    Logger::logPrintf("Could not setup DMP.", Logger::ERROR);
+    return false;
+  }
+  const int num_dimensions = sequential_dmp.getNumDimensions();
+  positions = MatrixXd::Zero(NUM_SAMPLES, num_dimensions);
+  velocities = MatrixXd::Zero(NUM_SAMPLES, num_dimensions);
+  accelerations = MatrixXd::Zero(NUM_SAMPLES, num_dimensions);
+  VectorXd desired_positions = VectorXd::Zero(num_dimensions);
+  VectorXd desired_velocities = VectorXd::Zero(num_dimensions);
+  VectorXd desired_accelerations = VectorXd::Zero(num_dimensions);
+  bool movement_finished = false;
+  for (int i = 0; i < NUM_SAMPLES && !movement_finished; ++i)
+  {
+    if (!sequential_dmp.propagateStep(desired_positions, desired_velocities, desired_accelerations, movement_finished, duration, NUM_SAMPLES))
+    {
+      Logger::logPrintf("Could not propagate DMP.", Logger::ERROR);
+      return false;
+    }
+    positions.row(i) = desired_positions.transpose();
+    velocities.row(i) = desired_velocities.transpose();
+    accelerations.row(i) = desired_accelerations.transpose();
+  }
+  return true;
+}
+
+bool TestDMPBatch::test(const TestData& testdata)
+{
+  ICRA2009DMP dmp;
+  if (!ICRA2009Test::initialize(dmp, testdata))
+  {
+    Logger::logPrintf("Could not initialize ICRA2009 DMP.", Logger::ERROR);
+    return false;
+  }
+  const int num_dimensions = dmp.getNumDimensions();
+  const VectorXd start = VectorXd::Zero(num_dimensions);
+  const VectorXd goal = VectorXd::Ones(num_dimensions);
+  if (!dmp.learnFromMinimumJerk(start, goal, SAMPLING_FREQUENCY, 1.0))
+  {
+    Logger::logPrintf("Could not learn DMP from minimum jerk.", Logger::ERROR);
+    return false;
+  }
+  vector<VectorXd> learned_thetas;
+  if (!dmp.getThetas(learned_thetas))
+  {
+    Logger::logPrintf("Could not get thetas.", Logger::ERROR);
+    return false;
+  }
+
+  // each rollout has its own (deterministically perturbed) thetas, start, goal and duration
+  vector<vector<VectorXd> > thetas;
+  vector<VectorXd> starts;
+  vector<VectorXd> goals;
+  vector<double> durations;
+  for (int r = 0; r < NUM_ROLLOUTS; ++r)
+  {
+    vector<VectorXd> rollout_thetas = learned_thetas;
+    for (int d = 0; d < (int)rollout_thetas.size(); ++d)
+    {
+      for (int j = 0; j < (int)rollout_thetas[d].size(); ++j)
+      {
+        rollout_thetas[d](j) += 10.0 * sin(static_cast<double> (1 + r * 13 + d * 7 + j));
+      }
+    }
+    thetas.push_back(rollout_thetas);
+    starts.push_back(VectorXd::Constant(num_dimensions, -0.1 * static_cast<double> (r)));
+    goals.push_back(VectorXd::Constant(num_dimensions, 1.0 + 0.2 * static_cast<double> (r)));
+    durations.push_back(0.5 + 0.25 * static_cast<double> (r));
+  }
+
+  DynamicMovementPrimitiveBatch<ICRA2009DMP> dmp_batch;
+  if (!dmp_batch.initialize(dmp, NUM_THREADS) || (dmp_batch.getNumThreads() != NUM_THREADS))
+  {
+    Logger::logPrintf("Could not initialize DMP batch.", Logger::ERROR);
+    return false;
+  }
+
+  // fill the output with a value that is never generated, the batch needs to overwrite every entry
+  const int num_columns = NUM_ROLLOUTS * num_dimensions;
+  MatrixXd positions = MatrixXd::Constant(NUM_SAMPLES, num_columns, UNSET_VALUE);
+  MatrixXd velocities = MatrixXd::Constant(NUM_SAMPLES, num_columns, UNSET_VALUE);
+  MatrixXd accelerations = MatrixXd::Constant(NUM_SAMPLES, num_columns, UNSET_VALUE);
+  if (!dmp_batch.propagateFull(thetas, starts, goals, durations, NUM_SAMPLES, positions, velocities, accelerations))
+  {
+    Logger::logPrintf("Could not propagate DMP batch.", Logger::ERROR);
+    return false;
+  }
+
+  for (int r = 0; r < NUM_ROLLOUTS; ++r)
+  {
+    MatrixXd sequential_positions, sequential_velocities, sequential_accelerations;
+    if (!propagateSequentially(dmp, thetas[r], starts[r], goals[r], durations[r], sequential_positions, sequential_velocities, sequential_accelerations))
+    {
+      return false;
+    }
+    const int column = r * num_dimensions;
+    const double error = max((positions.block(0, column, NUM_SAMPLES, num_dimensions) - sequential_positions).cwiseAbs().maxCoeff(),
+                             max((velocities.block(0, column, NUM_SAMPLES, num_dimensions) - sequential_velocities).cwiseAbs().maxCoeff(),
+                                 (accelerations.block(0, column, NUM_SAMPLES, num_dimensions) - sequential_accelerations).cwiseAbs().maxCoeff()));
+    if (error > ERROR_THRESHOLD)
+    {
+      Logger::logPrintf("Batch and sequential propagation of rollout >%i< differ by >%f<.", Logger::ERROR, r, error);
+      return false;
+    }
+  }
+
+  // the dmp copies of the batch must not share the parameters of the original dmp
+  vector<VectorXd> final_thetas;
+  if (!dmp.getThetas(final_thetas))
+  {
+    Logger::logPrintf("Could not get thetas.", Logger::ERROR);
+    return false;
+  }
+  for (int d = 0; d < (int)learned_thetas.size(); ++d)
+  {
+    if ((final_thetas[d] - learned_thetas[d]).cwiseAbs().maxCoeff() > ERROR_THRESHOLD)
+    {
+      Logger::logPrintf("Propagating the DMP batch changed the thetas of the original DMP.", Logger::ERROR);
+      return false;
+    }
+  }
+
+  Logger::logPrintf("DMP batch test finished successful.", Logger::INFO);
+  return true;
+}
+
+}
@@ -0,0 +1,50 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal 
+ *********************************************************************
+  \remarks		...
+ 
+  \file		test_dynamic_movement_primitive_batch.h
+
+  \date		Oct 17, 2026
+
+ *********************************************************************/
+
+#ifndef TEST_DYNAMIC_MOVEMENT_PRIMITIVE_BATCH_H_
+#define TEST_DYNAMIC_MOVEMENT_PRIMITIVE_BATCH_H_
+
+// system includes
+
+// local includes
+#include "test_data.h"
+
+namespace test_dmp
+{
+
+/*!
+ */
+class TestDMPBatch
+{
+
+public:
+
+    /*! Checks that propagating rollouts with a DynamicMovementPrimitiveBatch yields the same result
+     * as propagating each rollout sequentially using propagateStep
+     */
+    static bool test(const TestData& testdata);
+
+private:
+
+    /*!
+     */
+    TestDMPBatch() {};
+    /*!
+     */
+    virtual ~TestDMPBatch() {};
+
+};
+
+}
+
+#endif /* TEST_DYNAMIC_MOVEMENT_PRIMITIVE_BATCH_H_ */
@@ -0,0 +1,171 @@
+/*********************************************************************
+ Computational Learning and Motor Control Lab
+ University of Southern California
+ Prof. Stefan Schaal
+ *********************************************************************
+ \remarks		...
+
+ \file		test_kernel_cutoff.cpp
+
+ \date		Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <dmp_lib/logger.h>
+#include <dmp_lib/icra2009_dynamic_movement_primitive.h>
+
+// local includes
+#include "test_kernel_cutoff.h"
+#include "icra2009_test.h"
+
+using namespace std;
+using namespace dmp_lib;
+
+// import most common Eigen types
+using namespace Eigen;
+
+namespace test_dmp
+{
+
+static const int NUM_SAMPLES = 150;
+static const double SAMPLING_FREQUENCY = 100.0;
+static const double DURATION = 1.0;
+static const double KERNEL_CUTOFF = 0.01;
+static const double ERROR_THRESHOLD = 1e-10;
+
+/*! Propagates dmp from start to goal, returns the positions of all dimensions
+ */
+static bool propagate(ICRA2009DMP& dmp,
+                      const VectorXd& start,
+                      const VectorXd& goal,
+                      MatrixXd& positions)
+{
+  const int num_dimensions = dmp.getNumDimensions();
+  if (!dmp.setup(start, goal, DURATION, SAMPLING_FREQUENCY))
+  {
+    Logger::logPrintf("Could not setup DMP.", Logger::ERROR);
+    return false;
+  }
+  positions = MatrixXd::Zero(NUM_SAMPLES, num_dimensions);
+  VectorXd desired_positions = VectorXd::Zero(num_dimensions);
+  VectorXd desired_velocities = VectorXd::Zero(num_dimensions);
+  VectorXd desired_accelerations = VectorXd::Zero(num_dimensions);
+  bool movement_finished = false;
+  for (int i = 0; i < NUM_SAMPLES && !movement_finished; ++i)
+  {
+    if (!dmp.propagateStep(desired_positions, desired_velocities, desired_accelerations, movement_finished, DURATION, NUM_SAMPLES))
+    {
+      Logger::logPrintf("Could not propagate DMP.", Logger::ERROR);
+      return false;
+    }
+    positions.row(i) = desired_positions.transpose();
+  }
+  return true;
+}
+
+bool TestKernelCutoff::test(const TestData& testdata)
+{
+  if (testdata.getTestCase() != TestData::QUAT_TEST)
+  {
+    Logger::logPrintf("Kernel cutoff test requires the quaternion test data.", Logger::ERROR);
+    return false;
+  }
+  ICRA2009DMP dmp;
+  if (!ICRA2009Test::initialize(dmp, testdata))
+  {
+    Logger::logPrintf("Could not initialize ICRA2009 DMP.", Logger::ERROR);
+    return false;
+  }
+
+  // all dimensions of the quaternion transformation system share their basis functions,
+  // the transformation systems in front of it have one dimension each
+  const int num_dimensions = dmp.getNumDimensions();
+  const int quat_index = testdata.getQuatTSIndex();
+  VectorXd start = VectorXd::Zero(num_dimensions);
+  VectorXd goal = VectorXd::Ones(num_dimensions);
+  start.segment(quat_index, 4) << 1.0, 0.0, 0.0, 0.0;
+  goal.segment(quat_index, 4) << 0.5, 0.5, 0.5, 0.5;
+  if (!dmp.learnFromMinimumJerk(start, goal, SAMPLING_FREQUENCY, DURATION))
+  {
+    Logger::logPrintf("Could not learn DMP from minimum jerk.", Logger::ERROR);
+    return false;
+  }
+  const int modified_ts_dimension = 3;
+  const int modified_dimension = quat_index + modified_ts_dimension;
+
+  ICRA2009DMP untruncated_dmp;
+  untruncated_dmp = dmp;
+  MatrixXd untruncated_positions;
+  if (!propagate(untruncated_dmp, start, goal, untruncated_positions))
+  {
+    return false;
+  }
+
+  // the cutoff set through the dmp applies to all dimensions
+  ICRA2009DMP truncated_dmp;
+  truncated_dmp = dmp;
+  MatrixXd truncated_positions;
+  vector<double> kernel_cutoffs;
+  if (!truncated_dmp.setKernelCutoff(KERNEL_CUTOFF) || !truncated_dmp.getKernelCutoffs(kernel_cutoffs)
+      || (static_cast<int> (kernel_cutoffs.size()) != num_dimensions) || !propagate(truncated_dmp, start, goal, truncated_positions))
+  {
+    Logger::logPrintf("Could not set kernel cutoff of DMP.", Logger::ERROR);
+    return false;
+  }
+  for (int i = 0; i < num_dimensions; ++i)
+  {
+    if (kernel_cutoffs[i] != KERNEL_CUTOFF)
+    {
+      Logger::logPrintf("Kernel cutoff of dimension >%i< is >%f<, expected >%f<.", Logger::ERROR, i, kernel_cutoffs[i], KERNEL_CUTOFF);
+      return false;
+    }
+  }
+  if ((truncated_positions.col(modified_dimension) - untruncated_positions.col(modified_dimension)).cwiseAbs().maxCoeff() < ERROR_THRESHOLD)
+  {
+    Logger::logPrintf("Kernel cutoff >%f< did not change the DMP.", Logger::ERROR, KERNEL_CUTOFF);
+    return false;
+  }
+
+  // changing the kernels of a single dimension through its lwr model must not leave the shared basis functions stale,
+  // the assignment determines the shared basis functions anew, hence a copy serves as reference
+  ICRA2009DMP modified_dmp;
+  modified_dmp = dmp;
+  MatrixXd modified_positions;
+  if (!propagate(modified_dmp, start, goal, modified_positions))
+  {
+    return false;
+  }
+  if (!modified_dmp.getTransformationSystem(quat_index)->getParameters(modified_ts_dimension)->getLWRModel()->setKernelCutoff(KERNEL_CUTOFF))
+  {
+    Logger::logPrintf("Could not set kernel cutoff of LWR model.", Logger::ERROR);
+    return false;
+  }
+  ICRA2009DMP reference_dmp;
+  reference_dmp = modified_dmp;
+  MatrixXd reference_positions;
+  if (!propagate(modified_dmp, start, goal, modified_positions) || !propagate(reference_dmp, start, goal, reference_positions))
+  {
+    return false;
+  }
+  if ((reference_positions - untruncated_positions).cwiseAbs().maxCoeff() < ERROR_THRESHOLD)
+  {
+    Logger::logPrintf("Kernel cutoff >%f< of dimension >%i< did not change the DMP.", Logger::ERROR, KERNEL_CUTOFF, modified_dimension);
+    return false;
+  }
+  const double error = (modified_positions - reference_positions).cwiseAbs().maxCoeff();
+  if (error > ERROR_THRESHOLD)
+  {
+    Logger::logPrintf("DMP differs by >%f< after changing the kernel cutoff of dimension >%i<.", Logger::ERROR, error, modified_dimension);
+    return false;
+  }
+
+  Logger::logPrintf("Kernel cutoff test finished successful.", Logger::INFO);
+  return true;
+}
+
+}
@@ -0,0 +1,51 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks		...
+
+  \file		test_kernel_cutoff.h
+
+  \date		Oct 17, 2026
+
+ *********************************************************************/
+
+#ifndef TEST_KERNEL_CUTOFF_H_
+#define TEST_KERNEL_CUTOFF_H_
+
+// system includes
+
+// local includes
+#include "test_data.h"
+
+namespace test_dmp
+{
+
+/*!
+ */
+class TestKernelCutoff
+{
+
+public:
+
+    /*! Checks that kernel cutoffs set through the DMP as well as directly through the LWR model of
+     * a single dimension take effect in transformation systems that share their basis functions
+     * @param testdata Needs to contain a transformation system with more than one dimension
+     */
+    static bool test(const TestData& testdata);
+
+private:
+
+    /*!
+     */
+    TestKernelCutoff() {};
+    /*!
+     */
+    virtual ~TestKernelCutoff() {};
+
+};
+
+}
+
+#endif /* TEST_KERNEL_CUTOFF_H_ */
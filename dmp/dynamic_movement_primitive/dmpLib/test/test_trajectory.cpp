@@ -15,6 +15,7 @@
 // system includes
 #include <string>
 #include <vector>
+#include <math.h>
 
 #include <boost/filesystem.hpp>
 
@@ -34,6 +35,42 @@ using namespace Eigen;
 namespace test_dmp
 {
 
+static const int NUM_EXTRA_POINTS = 10;
+static const int NUM_CROPPED_POINTS = 7;
+static const int SAVITZKY_GOLAY_HALF_WINDOW = 5;
+static const int NUM_THREADS = 4;
+
+static bool isEqual(const Trajectory& trajectory, const Trajectory& other_trajectory)
+{
+  if (trajectory.getNumContainedSamples() != other_trajectory.getNumContainedSamples()
+      || trajectory.getDimension() != other_trajectory.getDimension()
+      || trajectory.containsPositionsOnly() != other_trajectory.containsPositionsOnly())
+  {
+    dmp_lib::Logger::logPrintf("Trajectories are not of same size.", Logger::ERROR);
+    return false;
+  }
+  int point_size = trajectory.getDimension();
+  if (!trajectory.containsPositionsOnly())
+  {
+    point_size *= 3;
+  }
+  VectorXd trajectory_point = VectorXd::Zero(point_size);
+  VectorXd other_trajectory_point = VectorXd::Zero(point_size);
+  for (int i = 0; i < trajectory.getNumContainedSamples(); ++i)
+  {
+    if (!trajectory.getTrajectoryPoint(i, trajectory_point) || !other_trajectory.getTrajectoryPoint(i, other_trajectory_point))
+    {
+      return false;
+    }
+    if ((trajectory_point - other_trajectory_point).cwiseAbs().maxCoeff() > 1e-10)
+    {
+      dmp_lib::Logger::logPrintf("Trajectory point >%i< differs.", Logger::ERROR, i);
+      return false;
+    }
+  }
+  return true;
+}
+
 bool TestTrajectory::test(const string& filename, const TestData& testdata, const string base_directory)
 {
   string data_directory_name = base_directory + "data/";
@@ -130,6 +167,35 @@ bool TestTrajectory::test(const string& filename, const TestData& testdata, cons
     return false;
   }
 
+  string binary_fname = result_directory_name + filename + string("_pos_vel_acc.bin");
+  Trajectory binary_trajectory;
+  if (!pos_vel_acc_trajectory.writeToBinaryFile(binary_fname) || !binary_trajectory.readFromBinaryFile(binary_fname, variable_names)
+      || !isEqual(pos_vel_acc_trajectory, binary_trajectory))
+  {
+    dmp_lib::Logger::logPrintf("Could not write and read binary file >%s<.", Logger::ERROR, binary_fname.c_str());
+    return false;
+  }
+  fname.assign(data_directory_name + filename + prefix);
+  binary_fname.assign(result_directory_name + filename + string("_converted.bin"));
+  if (!Trajectory::convertCLMCFileToBinaryFile(fname, binary_fname) || !binary_trajectory.readFromBinaryFile(binary_fname, variable_names)
+      || !isEqual(pos_vel_acc_trajectory, binary_trajectory))
+  {
+    dmp_lib::Logger::logPrintf("Could not convert clmc file >%s< into binary file.", Logger::ERROR, fname.c_str());
+    return false;
+  }
+
+  if (!testFixedCapacity(pos_trajectory))
+  {
+    dmp_lib::Logger::logPrintf("Fixed capacity trajectory test failed.", Logger::ERROR);
+    return false;
+  }
+
+  if (!testDerivatives(pos_trajectory))
+  {
+    dmp_lib::Logger::logPrintf("Derivative test failed.", Logger::ERROR);
+    return false;
+  }
+
   Trajectory pos_vel_acc_trajectory_copy;
   pos_vel_acc_trajectory_copy = pos_vel_acc_trajectory;
   fname.assign(result_directory_name + filename + string("_pos_vel_acc_copy") + prefix);
@@ -191,5 +257,112 @@ bool TestTrajectory::test(const string& filename, const TestData& testdata, cons
   return true;
 }
 
+bool TestTrajectory::testFixedCapacity(const Trajectory& pos_trajectory)
+{
+  const int num_samples = pos_trajectory.getNumContainedSamples();
+  Trajectory fixed_trajectory;
+  if (!fixed_trajectory.initialize(pos_trajectory.getVariableNames(), pos_trajectory.getSamplingFrequency(), true,
+                                   num_samples + 2 * NUM_EXTRA_POINTS + 100)
+      || !fixed_trajectory.reserveFixedCapacity(NUM_EXTRA_POINTS))
+  {
+    dmp_lib::Logger::logPrintf("Could not initialize fixed capacity trajectory.", Logger::ERROR);
+    return false;
+  }
+
+  VectorXd trajectory_point = VectorXd::Zero(pos_trajectory.getDimension());
+  for (int i = 0; i < num_samples; ++i)
+  {
+    if (!pos_trajectory.getTrajectoryPosition(i, trajectory_point) || !fixed_trajectory.add(trajectory_point))
+    {
+      return false;
+    }
+  }
+  if (!fixed_trajectory.computeDerivatives(NUM_EXTRA_POINTS) || !fixed_trajectory.crop(NUM_CROPPED_POINTS))
+  {
+    dmp_lib::Logger::logPrintf("Could not compute derivatives of fixed capacity trajectory.", Logger::ERROR);
+    return false;
+  }
+
+  Trajectory trajectory = pos_trajectory;
+  if (!trajectory.computeDerivatives(NUM_EXTRA_POINTS) || !trajectory.crop(NUM_CROPPED_POINTS))
+  {
+    dmp_lib::Logger::logPrintf("Could not compute derivatives of trajectory.", Logger::ERROR);
+    return false;
+  }
+
+  if (fixed_trajectory.getNumContainedSamples() != trajectory.getNumContainedSamples()
+      || fixed_trajectory.containsPositionsOnly() || !fixed_trajectory.hasFixedCapacity())
+  {
+    dmp_lib::Logger::logPrintf("Fixed capacity trajectory contains >%i< samples, expected >%i<.", Logger::ERROR,
+                               fixed_trajectory.getNumContainedSamples(), trajectory.getNumContainedSamples());
+    return false;
+  }
+  return isEqual(trajectory, fixed_trajectory);
+}
+
+bool TestTrajectory::testDerivatives(const Trajectory& pos_trajectory)
+{
+  // the results of the five point stencil must not depend on the number of threads
+  Trajectory trajectory = pos_trajectory;
+  Trajectory threaded_trajectory = pos_trajectory;
+  if (!trajectory.computeDerivatives(NUM_EXTRA_POINTS)
+      || !threaded_trajectory.computeDerivatives(NUM_EXTRA_POINTS, Trajectory::FIVE_POINT_STENCIL, 0, NUM_THREADS)
+      || !isEqual(trajectory, threaded_trajectory))
+  {
+    dmp_lib::Logger::logPrintf("Multi-threaded derivatives differ.", Logger::ERROR);
+    return false;
+  }
+
+  // both methods are exact for quadratic polynomials away from the ends
+  const double sampling_frequency = pos_trajectory.getSamplingFrequency();
+  const int num_samples = 500;
+  const double a = 0.3, b = -1.2, c = 2.5;
+  for (int m = 0; m < 2; ++m)
+  {
+    Trajectory quadratic_trajectory;
+    if (!quadratic_trajectory.initialize(pos_trajectory.getVariableNames(), sampling_frequency, true, num_samples))
+    {
+      return false;
+    }
+    VectorXd trajectory_point = VectorXd::Zero(pos_trajectory.getDimension());
+    for (int i = 0; i < num_samples; ++i)
+    {
+      const double t = static_cast<double> (i) / sampling_frequency;
+      trajectory_point.setConstant(a + b * t + c * t * t);
+      if (!quadratic_trajectory.add(trajectory_point))
+      {
+        return false;
+      }
+    }
+    Trajectory::DerivativeMethod derivative_method = Trajectory::FIVE_POINT_STENCIL;
+    if (m == 1)
+    {
+      derivative_method = Trajectory::SAVITZKY_GOLAY;
+    }
+    if (!quadratic_trajectory.computeDerivatives(0, derivative_method, SAVITZKY_GOLAY_HALF_WINDOW, NUM_THREADS))
+    {
+      return false;
+    }
+    const int margin = 10;
+    for (int i = margin; i < num_samples - margin; ++i)
+    {
+      const double t = static_cast<double> (i) / sampling_frequency;
+      for (int j = 0; j < quadratic_trajectory.getDimension(); ++j)
+      {
+        double velocity, acceleration;
+        if (!quadratic_trajectory.getTrajectoryVelocity(i, j, velocity) || !quadratic_trajectory.getTrajectoryAcceleration(i, j, acceleration))
+        {
+          return false;
+        }
+        if ((fabs(velocity - (b + 2.0 * c * t)) > 1e-6) || (fabs(acceleration - 2.0 * c) > 1e-6))
+        {
+          dmp_lib::Logger::logPrintf("Derivatives of quadratic trajectory are wrong at >%i< (vel: %f, acc: %f).", Logger::ERROR, i, velocity, acceleration);
+          return false;
+        }
+      }
+    }
+  }
+  return true;
 }
 
+}
@@ -37,6 +37,15 @@ public:
 
 private:
 
+    /*! Checks that computeDerivatives and crop of a trajectory with fixed capacity
+     * yield the same result as on a regular trajectory
+     */
+    static bool testFixedCapacity(const dmp_lib::Trajectory& pos_trajectory);
+
+    /*! Checks the derivatives of a quadratic trajectory for all derivative methods
+     */
+    static bool testDerivatives(const dmp_lib::Trajectory& pos_trajectory);
+
     /*!
      */
     TestTrajectory() {};
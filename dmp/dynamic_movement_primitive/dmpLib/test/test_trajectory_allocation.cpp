@@ -0,0 +1,188 @@
+/*********************************************************************
+ Computational Learning and Motor Control Lab
+ University of Southern California
+ Prof. Stefan Schaal
+ *********************************************************************
+ \remarks		Checks that a trajectory of fixed capacity does not allocate memory in add,
+              computeDerivatives, and crop. Heap operations are counted by interposing malloc,
+              which is specific to glibc, therefore the check lives in its own executable.
+
+ \file		test_trajectory_allocation.cpp
+
+ \date		Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include <Eigen/Core>
+
+#include <dmp_lib/logger.h>
+#include <dmp_lib/trajectory.h>
+
+using namespace std;
+using namespace dmp_lib;
+
+// import most common Eigen types
+using namespace Eigen;
+
+#ifdef __GLIBC__
+
+/*! Number of heap operations of this executable. operator new as well as Eigen allocate through malloc
+ */
+static volatile uint64_t num_heap_operations = 0;
+
+extern "C"
+{
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size)
+{
+  __sync_fetch_and_add(&num_heap_operations, 1);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size)
+{
+  __sync_fetch_and_add(&num_heap_operations, 1);
+  return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+  __sync_fetch_and_add(&num_heap_operations, 1);
+  return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr)
+{
+  __sync_fetch_and_add(&num_heap_operations, 1);
+  __libc_free(ptr);
+}
+}
+
+namespace test_dmp
+{
+
+static const int NUM_SAMPLES = 500;
+static const int NUM_DIMENSIONS = 3;
+static const int NUM_EXTRA_POINTS = 10;
+static const int NUM_CROPPED_POINTS = 7;
+static const double SAMPLING_FREQUENCY = 300.0;
+
+static uint64_t getNumAllocations()
+{
+  return num_heap_operations;
+}
+
+/*! Installs the allocation counter of the trajectory for the lifetime of the object
+ */
+class ScopedAllocationCounter
+{
+
+public:
+
+  ScopedAllocationCounter()
+  {
+    Trajectory::setAllocationCounter(&getNumAllocations);
+  }
+  ~ScopedAllocationCounter()
+  {
+    Trajectory::setAllocationCounter(NULL);
+  }
+
+};
+
+static bool testFixedCapacity()
+{
+  vector<string> variable_names;
+  VectorXd start = VectorXd::Zero(NUM_DIMENSIONS);
+  VectorXd goal = VectorXd::Zero(NUM_DIMENSIONS);
+  for (int i = 0; i < NUM_DIMENSIONS; ++i)
+  {
+    variable_names.push_back(string("x") + static_cast<char> ('0' + i));
+    goal(i) = 1.0 + i;
+  }
+  Trajectory pos_trajectory;
+  if (!pos_trajectory.initializeWithMinJerk(variable_names, SAMPLING_FREQUENCY, start, goal, NUM_SAMPLES))
+  {
+    Logger::logPrintf("Could not initialize trajectory with minimum jerk.", Logger::ERROR);
+    return false;
+  }
+
+  Trajectory fixed_trajectory;
+  if (!fixed_trajectory.initialize(variable_names, SAMPLING_FREQUENCY, true, NUM_SAMPLES + 2 * NUM_EXTRA_POINTS + 100)
+      || !fixed_trajectory.reserveFixedCapacity(NUM_EXTRA_POINTS))
+  {
+    Logger::logPrintf("Could not initialize fixed capacity trajectory.", Logger::ERROR);
+    return false;
+  }
+
+  // the counter needs to register the heap operations of a trajectory that is not of fixed capacity
+  const uint64_t num_allocations_before_copy = getNumAllocations();
+  {
+    Trajectory trajectory = pos_trajectory;
+    if (!trajectory.computeDerivatives(NUM_EXTRA_POINTS))
+    {
+      Logger::logPrintf("Could not compute derivatives of trajectory.", Logger::ERROR);
+      return false;
+    }
+  }
+  if (getNumAllocations() == num_allocations_before_copy)
+  {
+    Logger::logPrintf("Allocation counter did not register any heap operation.", Logger::ERROR);
+    return false;
+  }
+
+  VectorXd trajectory_point = VectorXd::Zero(NUM_DIMENSIONS);
+  uint64_t num_allocations = 0;
+  bool success = true;
+  {
+    ScopedAllocationCounter allocation_counter;
+    num_allocations = getNumAllocations();
+    for (int i = 0; success && i < NUM_SAMPLES; ++i)
+    {
+      success = pos_trajectory.getTrajectoryPosition(i, trajectory_point) && fixed_trajectory.add(trajectory_point);
+    }
+    success = success && fixed_trajectory.computeDerivatives(NUM_EXTRA_POINTS)
+        && fixed_trajectory.crop(NUM_CROPPED_POINTS);
+    num_allocations = getNumAllocations() - num_allocations;
+  }
+  if (!success)
+  {
+    Logger::logPrintf("Could not compute derivatives of fixed capacity trajectory.", Logger::ERROR);
+    return false;
+  }
+  // the check inside the trajectory only asserts, therefore also check here such that the test fails in release builds
+  if (num_allocations != 0)
+  {
+    Logger::logPrintf("Fixed capacity trajectory performed >%i< heap operations.", Logger::ERROR, (int)num_allocations);
+    return false;
+  }
+  return true;
+}
+
+}
+
+#endif
+
+int main(int argc, char** argv)
+{
+#ifdef __GLIBC__
+  if (!test_dmp::testFixedCapacity())
+  {
+    Logger::logPrintf("Fixed capacity trajectory allocation test failed.", Logger::ERROR);
+    return EXIT_FAILURE;
+  }
+#else
+  Logger::logPrintf("Heap operations can only be counted with glibc, skipping allocation test.", Logger::WARN);
+#endif
+  return EXIT_SUCCESS;
+}
@@ -88,6 +88,23 @@ public:
      */
     bool predict(const double x_query, double& y_prediction);
 
+    /*! Predicts using basis functions that have been evaluated (and normalized) beforehand
+     * using generateNormalizedBasisFunctionVector. This allows to evaluate the kernels only once
+     * for several LWR models that share the same receptive fields (see hasSameReceptiveFields).
+     * @param x_query
+     * @param normalized_basis_functions
+     * @param y_prediction
+     * @return True on success, otherwise False
+     * REAL-TIME REQUIREMENTS
+     */
+    bool predict(const double x_query, const Eigen::VectorXd& normalized_basis_functions, double& y_prediction) const;
+
+    /*!
+     * @param lwr_model
+     * @return True if both models have identical centers and widths (and kernel cutoff), otherwise False
+     */
+    bool hasSameReceptiveFields(const LWR& lwr_model) const;
+
     /*! Gets the theta vector
      * @param thetas
      * @return True on success, false on failure
@@ -181,6 +198,24 @@ public:
      */
     int getNumRFS() const;
 
+    /*! Sets the activation below which kernels are truncated to zero. Truncated kernels are
+     * skipped without evaluating exp(). A cutoff of 0.0 (default) disables truncation.
+     * @param kernel_cutoff
+     * @return True on success, false on failure
+     */
+    bool setKernelCutoff(const double kernel_cutoff);
+
+    /*! Returns the activation below which kernels are truncated to zero
+     * @return
+     */
+    double getKernelCutoff() const;
+
+    /*! Returns a counter that changes whenever the receptive fields of this model change
+     * @return
+     * REAL-TIME REQUIREMENTS
+     */
+    int getKernelRevision() const;
+
 //    /*!
 //     * @return
 //     */
@@ -206,6 +241,14 @@ public:
      */
     bool generateBasisFunctionVector(const double x_input, Eigen::VectorXd& basis_functions) const;
 
+    /*! Generates the basis function vector normalized to sum up to one.
+     * @param x_input
+     * @param normalized_basis_functions (needs to be of size num_rfs)
+     * @return True on success, false if size is incorrect or if no kernel is active at x_input
+     * REAL-TIME REQUIREMENTS
+     */
+    bool generateNormalizedBasisFunctionVector(const double x_input, Eigen::VectorXd& normalized_basis_functions) const;
+
     /*!
      * @param x_input
      * @param rfs_index
@@ -40,7 +40,7 @@ public:
     /*! Constructor
      */
     LWRParameters() :
-      num_rfs_(0) {};
+      num_rfs_(0), kernel_cutoff_(0.0), kernel_revision_(0) {};
 
     /*! Destructor
      */
@@ -199,6 +199,27 @@ public:
      */
     int getNumRFS() const;
 
+    /*! Sets the activation below which kernels are truncated to zero (compact support).
+     * A cutoff of 0.0 (default) disables truncation.
+     * @param kernel_cutoff
+     * @return True on success, false on failure
+     */
+    bool setKernelCutoff(const double kernel_cutoff);
+
+    /*! Returns the activation below which kernels are truncated to zero
+     * @return
+     */
+    double getKernelCutoff() const;
+
+    /*! Returns a counter that changes whenever the receptive fields (number, centers, widths, or kernel cutoff) change
+     * @return
+     * REAL-TIME REQUIREMENTS
+     */
+    int getKernelRevision() const
+    {
+      return kernel_revision_;
+    }
+
     /*! Writes the LWR model to file
      *
      * @param file_name File name in which the LWR model is stored.
@@ -235,6 +256,27 @@ private:
      */
     Eigen::VectorXd offsets_;
 
+    /*! Activation below which kernels are truncated (0.0 disables truncation)
+     */
+    double kernel_cutoff_;
+
+    /*! Precomputed 1/widths_ (avoids the division in the kernel)
+     */
+    Eigen::VectorXd inverse_widths_;
+
+    /*! Precomputed distance from the center beyond which the kernel activation drops below kernel_cutoff_
+     */
+    Eigen::VectorXd support_radii_;
+
+    /*! Incremented whenever the receptive fields change, allows users to detect stale copies of the kernels
+     */
+    int kernel_revision_;
+
+    /*! Recomputes inverse_widths_ and support_radii_ and increments kernel_revision_,
+     * needs to be called whenever widths_, centers_, or kernel_cutoff_ change
+     */
+    void updateKernelCache();
+
 };
 
 
@@ -14,6 +14,7 @@
 
 // system include
 #include <stdio.h>
+#include <math.h>
 #include <cassert>
 
 // local include
@@ -32,7 +33,12 @@ LWR& LWR::operator=(const LWR& lwr_model)
   Logger::logPrintf("LWR assignment.", Logger::DEBUG);
 
   // assign memeber variables
-  assert(Utilities<LWRParameters>::assign(parameters_, lwr_model.parameters_));
+  if (!Utilities<LWRParameters>::assign(parameters_, lwr_model.parameters_))
+  {
+    Logger::logPrintf("Could not assign LWR.", Logger::FATAL);
+    initialized_ = false;
+    return *this;
+  }
   initialized_ = lwr_model.initialized_;
   return *this;
 }
@@ -46,7 +52,11 @@ bool LWR::initialize(const LWRParamPtr parameters)
   }
   // copy the content of parameters
   Logger::logPrintf(initialized_, "LWR model already initialized. Re-initializing...", Logger::WARN);
-  assert(Utilities<LWRParameters>::assign(parameters_, parameters));
+  if (!Utilities<LWRParameters>::assign(parameters_, parameters))
+  {
+    Logger::logPrintf("Could not initialize LWR.", Logger::FATAL);
+    return (initialized_ = false);
+  }
   return (initialized_ = true);
 }
 
@@ -55,7 +65,12 @@ double LWR::evaluateKernel(const double x_input,
                            const int center_index) const
 {
   assert(parameters_->initialized_);
-  return exp(-(static_cast<double> (1.0) / parameters_->widths_(center_index)) * pow(x_input - parameters_->centers_(center_index), 2));
+  const double diff = x_input - parameters_->centers_(center_index);
+  if (fabs(diff) > parameters_->support_radii_(center_index))
+  {
+    return 0.0;
+  }
+  return exp(-parameters_->inverse_widths_(center_index) * diff * diff);
 }
 
 bool LWR::generateBasisFunctionMatrix(const VectorXd& x_input_vector,
@@ -98,6 +113,29 @@ bool LWR::generateBasisFunctionVector(const double x_input, VectorXd& basis_func
   return true;
 }
 
+// REAL-TIME REQUIREMENTS
+bool LWR::generateNormalizedBasisFunctionVector(const double x_input, VectorXd& normalized_basis_functions) const
+{
+  if(normalized_basis_functions.size() != parameters_->num_rfs_)
+  {
+    Logger::logPrintf("Size of provided basis function vector >%i< is incorrect, it should be of size >%i< (Real-time violation).", Logger::ERROR, normalized_basis_functions.size(), parameters_->num_rfs_);
+    return false;
+  }
+  double sx = 0;
+  for (int i = 0; i < parameters_->num_rfs_; ++i)
+  {
+    normalized_basis_functions(i) = evaluateKernel(x_input, i);
+    sx += normalized_basis_functions(i);
+  }
+  if (sx < 0.000000001 && sx > -0.000000001)
+  {
+    normalized_basis_functions.setZero();
+    return false;
+  }
+  normalized_basis_functions *= (static_cast<double> (1.0) / sx);
+  return true;
+}
+
 bool LWR::generateBasisFunction(const double x_input, const int rfs_index, double& basis_function) const
 {
   if(rfs_index < 0 || rfs_index >= parameters_->centers_.size())
@@ -172,6 +210,35 @@ bool LWR::predict(const double x_query,
   return true;
 }
 
+// REAL-TIME REQUIREMENTS
+bool LWR::predict(const double x_query,
+                  const VectorXd& normalized_basis_functions,
+                  double& y_prediction) const
+{
+  assert(parameters_->initialized_);
+  if (normalized_basis_functions.size() != parameters_->slopes_.size())
+  {
+    Logger::logPrintf("Size of provided basis function vector >%i< is incorrect, it should be of size >%i< (Real-time violation).", Logger::ERROR, normalized_basis_functions.size(), parameters_->slopes_.size());
+    y_prediction = 0;
+    return false;
+  }
+  y_prediction = parameters_->slopes_.dot(normalized_basis_functions) * x_query;
+  return true;
+}
+
+bool LWR::hasSameReceptiveFields(const LWR& lwr_model) const
+{
+  if (!initialized_ || !lwr_model.initialized_)
+  {
+    return false;
+  }
+  return ((parameters_->num_rfs_ == lwr_model.parameters_->num_rfs_)
+      && (parameters_->centers_.size() == lwr_model.parameters_->centers_.size())
+      && (parameters_->kernel_cutoff_ == lwr_model.parameters_->kernel_cutoff_)
+      && (parameters_->centers_ == lwr_model.parameters_->centers_)
+      && (parameters_->widths_ == lwr_model.parameters_->widths_));
+}
+
 bool LWR::getThetas(VectorXd& thetas) const
 {
   if (!initialized_)
@@ -316,6 +383,36 @@ bool LWR::setNumRFS(const int num_rfs)
   return parameters_->setNumRFS(num_rfs);
 }
 
+bool LWR::setKernelCutoff(const double kernel_cutoff)
+{
+  if (!initialized_)
+  {
+    Logger::logPrintf("Cannot set kernel cutoff, LWR model is not initialzed.", Logger::ERROR);
+    return false;
+  }
+  return parameters_->setKernelCutoff(kernel_cutoff);
+}
+
+double LWR::getKernelCutoff() const
+{
+  if (!initialized_)
+  {
+    Logger::logPrintf("Cannot return kernel cutoff, LWR model is not initialzed.", Logger::ERROR);
+    return 0.0;
+  }
+  return parameters_->getKernelCutoff();
+}
+
+// REAL-TIME REQUIREMENTS
+int LWR::getKernelRevision() const
+{
+  if (!initialized_)
+  {
+    return -1;
+  }
+  return parameters_->getKernelRevision();
+}
+
 int LWR::getNumRFS() const
 {
   if (!initialized_)
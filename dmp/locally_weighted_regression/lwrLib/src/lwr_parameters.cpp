@@ -15,6 +15,7 @@
 // system include
 #include <cassert>
 #include <sstream>
+#include <limits>
 
 // local include
 #include <lwr_lib/lwr_parameters.h>
@@ -59,6 +60,7 @@ bool LWRParameters::initialize(const VectorXd& centers,
   widths_ = widths;
   slopes_ = slopes;
   offsets_ = offsets;
+  updateKernelCache();
   return (initialized_ = true);
 }
 
@@ -149,6 +151,7 @@ bool LWRParameters::initialize(const int num_rfs,
     }
   }
 
+  updateKernelCache();
   return (initialized_ = true);
 }
 
@@ -203,6 +206,7 @@ bool LWRParameters::setNumRFS(const int num_rfs)
     return false;
   }
   num_rfs_ = num_rfs;
+  ++kernel_revision_;
   return true;
 }
 
@@ -211,6 +215,35 @@ int LWRParameters::getNumRFS() const
   return num_rfs_;
 }
 
+bool LWRParameters::setKernelCutoff(const double kernel_cutoff)
+{
+  if (kernel_cutoff < 0.0 || kernel_cutoff >= 1.0)
+  {
+    Logger::logPrintf("Kernel cutoff >%f< is invalid. It must be within [0, 1).", Logger::ERROR, kernel_cutoff);
+    return false;
+  }
+  kernel_cutoff_ = kernel_cutoff;
+  updateKernelCache();
+  return true;
+}
+
+double LWRParameters::getKernelCutoff() const
+{
+  return kernel_cutoff_;
+}
+
+void LWRParameters::updateKernelCache()
+{
+  ++kernel_revision_;
+  inverse_widths_ = widths_.array().inverse().matrix();
+  support_radii_ = VectorXd::Constant(widths_.size(), numeric_limits<double>::max());
+  if (kernel_cutoff_ > 0.0)
+  {
+    // exp(-(x-c)^2 / w) < cutoff  <=>  |x-c| > sqrt(-w * log(cutoff))
+    support_radii_ = (widths_ * -log(kernel_cutoff_)).array().sqrt().matrix();
+  }
+}
+
 bool LWRParameters::setWidthsAndCenters(const VectorXd& widths,
                                         const VectorXd& centers)
 {
@@ -218,6 +251,7 @@ bool LWRParameters::setWidthsAndCenters(const VectorXd& widths,
   assert((centers.cols() == centers_.cols()) && (centers.rows() == centers_.rows()));
   widths_ = widths;
   centers_ = centers;
+  updateKernelCache();
   return true;
 }
 
@@ -231,6 +265,7 @@ bool LWRParameters::setWidthsAndCenters(const vector<double>& widths,
     widths_(i) = widths[i];
     centers_(i) = centers[i];
   }
+  updateKernelCache();
   return true;
 }
 
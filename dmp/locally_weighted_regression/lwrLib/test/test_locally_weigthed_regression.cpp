@@ -17,6 +17,7 @@
 #include <time.h>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 
 #include <Eigen/Core>
 #include <boost/shared_ptr.hpp>
@@ -43,6 +44,8 @@ public:
 
   bool testLearning();
 
+  bool testNormalizedBasisFunctionPrediction();
+
   double targetFunction(const double test_x);
 
 private:
@@ -167,6 +170,80 @@ bool LWRTest::testLearning()
   return true;
 }
 
+bool LWRTest::testNormalizedBasisFunctionPrediction()
+{
+  int num_data_query = 2000;
+  double prediction_error_threshold = 1e-10;
+
+  VectorXd basis_functions = VectorXd::Zero(lwr_->getNumRFS());
+  for (int i = 0; i < num_data_query; i++)
+  {
+    double x_query = static_cast<double> (i) / static_cast<double> (num_data_query - 1);
+    double y_prediction = 0;
+    if (!lwr_->predict(x_query, y_prediction))
+    {
+      Logger::logPrintf("Could not predict from LWR model.", Logger::ERROR);
+      return false;
+    }
+    double y_batch_prediction = 0;
+    if (!lwr_->generateNormalizedBasisFunctionVector(x_query, basis_functions)
+        || !lwr_->predict(x_query, basis_functions, y_batch_prediction))
+    {
+      Logger::logPrintf("Could not predict from normalized basis functions.", Logger::ERROR);
+      return false;
+    }
+    if (fabs(y_prediction - y_batch_prediction) > prediction_error_threshold)
+    {
+      Logger::logPrintf("Prediction >%f< and prediction from normalized basis functions >%f< differ.", Logger::ERROR, y_prediction, y_batch_prediction);
+      return false;
+    }
+  }
+
+  // truncated kernels should only marginally change the prediction
+  double kernel_cutoff = 1e-12;
+  // initialize a second model (instead of copying lwr_, which would share its parameters) and transfer the learned thetas
+  LWRParamPtr truncated_params(new LWRParameters(*params_));
+  LWR truncated_lwr;
+  VectorXd thetas = VectorXd::Zero(lwr_->getNumRFS());
+  if (!truncated_lwr.initialize(truncated_params) || !lwr_->getThetas(thetas) || !truncated_lwr.setThetas(thetas))
+  {
+    Logger::logPrintf("Could not initialize truncated LWR model.", Logger::ERROR);
+    return false;
+  }
+  if (!truncated_lwr.setKernelCutoff(kernel_cutoff))
+  {
+    Logger::logPrintf("Could not set kernel cutoff.", Logger::ERROR);
+    return false;
+  }
+  double max_truncation_error = 0.0;
+  for (int i = 0; i < num_data_query; i++)
+  {
+    double x_query = static_cast<double> (i) / static_cast<double> (num_data_query - 1);
+    double y_prediction = 0;
+    double y_truncated_prediction = 0;
+    if (!lwr_->predict(x_query, y_prediction) || !truncated_lwr.predict(x_query, y_truncated_prediction))
+    {
+      Logger::logPrintf("Could not predict from LWR model.", Logger::ERROR);
+      return false;
+    }
+    if (fabs(y_prediction - y_truncated_prediction) > 1e-6)
+    {
+      Logger::logPrintf("Prediction >%f< and truncated prediction >%f< differ.", Logger::ERROR, y_prediction, y_truncated_prediction);
+      return false;
+    }
+    max_truncation_error = std::max(max_truncation_error, fabs(y_prediction - y_truncated_prediction));
+  }
+  // identical predictions would mean that the cutoff has not been applied to the truncated model only
+  if (max_truncation_error <= 0.0)
+  {
+    Logger::logPrintf("Truncated and untruncated predictions are identical.", Logger::ERROR);
+    return false;
+  }
+
+  Logger::logPrintf("Test finished successfully.", Logger::INFO);
+  return true;
+}
+
 int main()
 {
   LWRTest lwr_test;
@@ -174,7 +251,11 @@ int main()
   {
     return -1;
   }
-  if (lwr_test.testLearning())
+  if (!lwr_test.testLearning())
+  {
+    return -1;
+  }
+  if (!lwr_test.testNormalizedBasisFunctionPrediction())
   {
     return -1;
   }
@@ -181,6 +181,63 @@ public:
                std::vector<task_recorder2_msgs::DataSampleLabel>& data_labels);/*,
                const std::vector<std::string> variable_names = std::vector<std::string>());*/
 
+  /*! Prepares the streaming predict path: the indices of the SVM variables in names are looked up once and
+   * the support vectors, alphas and bias are copied out of the trained (or loaded) SVM. Only linear and
+   * (non compact) gaussian kernels with identity normalization are supported.
+   * @param names All names of the data samples that will be passed to predictStreaming
+   * @param window_size Number of most recently scored samples that are kept
+   * @return True on success, otherwise False
+   */
+  bool initializeStreaming(const std::vector<std::string>& names,
+                           const int window_size = MAX_NUM_TEST_SAMPLES);
+
+  /*!
+   * @return True if the streaming predict path is initialized, otherwise False
+   */
+  bool isStreamingInitialized() const
+  {
+    return streaming_initialized_;
+  }
+
+  /*! Removes all scored samples from the window
+   */
+  void resetStreamingWindow();
+
+  /*! Evaluates the decision function directly (without shogun) and adds the sample to the window.
+   * Initializes the streaming predict path from the names of data_sample if needed, i.e. also if the names
+   * differ from the ones it has been initialized for.
+   * @param data_sample
+   * @param data_label
+   * @return True on success, otherwise False
+   */
+  bool predictStreaming(const task_recorder2_msgs::DataSample& data_sample,
+                        task_recorder2_msgs::DataSampleLabel& data_label);
+
+  /*! Same as predict, but samples (identified by their time stamp) that are still contained in
+   * the window are not scored again. Samples need to be ordered by time stamp and all of them need
+   * to have the same names.
+   * @param data_samples
+   * @param data_labels
+   * @return True on success, otherwise False
+   */
+  bool predictStreaming(const std::vector<task_recorder2_msgs::DataSample>& data_samples,
+                        std::vector<task_recorder2_msgs::DataSampleLabel>& data_labels);
+
+  /*!
+   * @param logging_enabled If True, training and test data as well as predicted labels are logged to /tmp
+   */
+  void setLoggingEnabled(const bool logging_enabled)
+  {
+    logging_enabled_ = logging_enabled;
+  }
+  /*!
+   * @return
+   */
+  bool isLoggingEnabled() const
+  {
+    return logging_enabled_;
+  }
+
   /*!
    * @param value
    * @param label
@@ -235,6 +292,57 @@ private:
 
   SVMParameters svm_parameters_;
 
+  bool logging_enabled_;
+
+  /*! Streaming predict path
+   */
+  bool streaming_initialized_;
+  int streaming_num_signals_;
+  /*! Names the index map has been computed for
+   */
+  std::vector<std::string> streaming_names_;
+  std::vector<int> streaming_indices_;
+  int streaming_kernel_type_;
+  double streaming_kernel_width_;
+  double streaming_bias_;
+  int streaming_num_support_vectors_;
+  /*! Row-major, one row per support vector
+   */
+  std::vector<double> streaming_support_vectors_;
+  std::vector<double> streaming_support_vector_norms_;
+  std::vector<double> streaming_alphas_;
+
+  /*! Circular window of the most recently scored samples, features are stored row-major
+   */
+  int streaming_window_size_;
+  int streaming_window_head_;
+  int streaming_window_count_;
+  std::vector<double> streaming_features_;
+  std::vector<double> streaming_values_;
+  std::vector<ros::Time> streaming_stamps_;
+
+  /*! Evaluates the decision function and adds the sample to the window if it is newer than all contained samples
+   * @param data_sample
+   * @param value
+   * @return True on success, otherwise False
+   */
+  bool computeStreamingValue(const task_recorder2_msgs::DataSample& data_sample,
+                             double& value);
+
+  /*! (Re-)initializes the streaming predict path unless it has been initialized for names, the window size is kept
+   * @param names
+   * @return True on success, otherwise False
+   */
+  bool prepareStreaming(const std::vector<std::string>& names);
+
+  /*!
+   * @param stamp
+   * @param value
+   * @return True if a sample with stamp is contained in the window, otherwise False
+   */
+  bool findInStreamingWindow(const ros::Time& stamp,
+                             double& value) const;
+
   void reset();
   void freeSVM();
   void clear();
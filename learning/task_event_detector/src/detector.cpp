@@ -40,6 +40,8 @@ bool Detector::reset()
 {
   svm_classifier_.reset(new SVMClassifier());
   ROS_VERIFY(svm_classifier_->read(ros::NodeHandle("/TaskEventDetector")));
+  // the detector predicts continuously, logging each prediction to /tmp would dominate its run time
+  svm_classifier_->setLoggingEnabled(false);
   ROS_VERIFY(monitor_io_.initialize());
   return true;
 }
@@ -70,7 +72,12 @@ bool Detector::save(task_recorder2_msgs::Description& description)
 
 bool Detector::load(const task_recorder2_msgs::Description& description)
 {
-  return svm_io_.read(description, svm_classifier_);
+  if (!svm_io_.read(description, svm_classifier_))
+  {
+    return false;
+  }
+  svm_classifier_->setLoggingEnabled(false);
+  return true;
 }
 
 bool Detector::filter(std::vector<task_recorder2_msgs::DataSample>& data_samples)
@@ -128,12 +135,12 @@ bool Detector::predict(const std::vector<task_recorder2_msgs::DataSample>& data_
     ROS_ERROR("No data samples provided, cannot predict.");
     return false;
   }
-  for (int i = 0; i < (int)data_samples.size(); ++i)
+  std::vector<task_recorder2_msgs::DataSampleLabel> predicted_data_labels;
+  ROS_VERIFY(svm_classifier_->predictStreaming(data_samples, predicted_data_labels));
+  for (int i = 0; i < (int)predicted_data_labels.size(); ++i)
   {
-    task_recorder2_msgs::DataSampleLabel data_label;
-    ROS_VERIFY(svm_classifier_->predict(data_samples[i], data_label));
-    ROS_ASSERT(data_label.type == task_recorder2_msgs::DataSampleLabel::BINARY_LABEL);
-    data_labels.push_back(data_label);
+    ROS_ASSERT(predicted_data_labels[i].type == task_recorder2_msgs::DataSampleLabel::BINARY_LABEL);
+    data_labels.push_back(predicted_data_labels[i]);
   }
   return true;
 }
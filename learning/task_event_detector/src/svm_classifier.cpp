@@ -26,12 +26,15 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
 
 #include <task_recorder2_utilities/data_sample_utilities.h>
 #include <task_recorder2_utilities/data_sample_label_utilities.h>
 
 #include <shogun/kernel/GaussianKernel.h>
 #include <shogun/kernel/LinearKernel.h>
+#include <shogun/kernel/KernelNormalizer.h>
 
 #include <usc_utilities/logging.h>
 
@@ -51,7 +54,10 @@ static const std::string LABELS_FILE_NAME = "svm_labels.txt";
 // static const std::string SVM_PARAMETERS_FILE_NAME = "svm_parameters.txt";
 
 SVMClassifier::SVMClassifier() :
-  trained_(false), loaded_(false)
+  trained_(false), loaded_(false), logging_enabled_(SVM_LOGGING_ENABLED),
+  streaming_initialized_(false), streaming_num_signals_(0), streaming_kernel_type_(0), streaming_kernel_width_(0.0),
+  streaming_bias_(0.0), streaming_num_support_vectors_(0),
+  streaming_window_size_(0), streaming_window_head_(0), streaming_window_count_(0)
 {
   ROS_VERIFY(initialize());
 }
@@ -103,6 +109,7 @@ void SVMClassifier::freeSVM()
     // SG_UNREF(ctraining_features_);
     // SG_UNREF(ctraining_labels_);
   }
+  streaming_initialized_ = false;
   if (trained_ || loaded_)
   {
     SG_UNREF(ctest_labels_);
@@ -216,6 +223,7 @@ bool SVMClassifier::train()
                  svm_parameters_.msg_.num_data_samples, (int)data_labels_.size());
 
   ROS_DEBUG("Training SVM with >%i< dimensions from >%i< samples.", svm_parameters_.msg_.num_variables, svm_parameters_.msg_.num_data_samples);
+  streaming_initialized_ = false;
 
   // assuming that input data is somewhat normalized
 
@@ -233,7 +241,7 @@ bool SVMClassifier::train()
     double label;
     ROS_VERIFY(task_recorder2_utilities::getSVMLabel(data_labels_[i], label));
     training_labels_[i] = static_cast<float64_t> (label);
-    if (SVM_LOGGING_ENABLED)
+    if (logging_enabled_)
     {
       log_label.push_back(label);
       log_data.push_back(data_samples_[i].data);
@@ -244,7 +252,7 @@ bool SVMClassifier::train()
     }
   }
 
-  if(SVM_LOGGING_ENABLED)
+  if(logging_enabled_)
   {
     usc_utilities::log(log_label, "/tmp/training_label.txt");
     usc_utilities::log(log_data, "/tmp/training_data.txt");
@@ -396,6 +404,7 @@ bool SVMClassifier::save(const std::string directory_name)
 bool SVMClassifier::load(const std::string directory_name)
 {
   ROS_VERIFY(initialize());
+  streaming_initialized_ = false;
   std::string dir = directory_name;
   usc_utilities::appendTrailingSlash(dir);
 
@@ -535,7 +544,7 @@ bool SVMClassifier::predict(const std::vector<task_recorder2_msgs::DataSample>&
         ROS_ASSERT_MSG(j < ctest_labels_->get_num_labels(), "You asked for label >%i<, but there are only >%i< labels.", j, ctest_labels_->get_num_labels());
         ROS_VERIFY(getLabel(ctest_labels_->get_label(j), data_labels[j + (counter * MAX_NUM_TEST_SAMPLES)]));
 
-        if(SVM_LOGGING_ENABLED)
+        if(logging_enabled_)
         {
           predicted_labels[j + counter * MAX_NUM_TEST_SAMPLES] = data_labels[j + counter * MAX_NUM_TEST_SAMPLES].binary_label.label;
         }
@@ -554,12 +563,12 @@ bool SVMClassifier::predict(const std::vector<task_recorder2_msgs::DataSample>&
       {
         test_features_[index * svm_parameters_.msg_.num_variables + j] = static_cast<float64_t> (reduced_data_samples[i].data[j]);
       }
-      if(SVM_LOGGING_ENABLED)
+      if(logging_enabled_)
       {
         test_data_sample[j] = static_cast<float64_t> (test_features_[index * svm_parameters_.msg_.num_variables + j]);
       }
     }
-    if(SVM_LOGGING_ENABLED)
+    if(logging_enabled_)
     {
       test_data_samples.push_back(test_data_sample);
     }
@@ -578,14 +587,14 @@ bool SVMClassifier::predict(const std::vector<task_recorder2_msgs::DataSample>&
       ROS_ASSERT_MSG(i < ctest_labels_->get_num_labels(), "You asked for label >%i<, but there are only >%i< labels.", i, ctest_labels_->get_num_labels());
       ROS_VERIFY(getLabel(ctest_labels_->get_label(i), data_labels[i + (counter * MAX_NUM_TEST_SAMPLES)]));
 
-      if(SVM_LOGGING_ENABLED)
+      if(logging_enabled_)
       {
         predicted_labels[i + counter * MAX_NUM_TEST_SAMPLES] = data_labels[i + counter * MAX_NUM_TEST_SAMPLES].binary_label.label;
       }
     }
   }
 
-  if(SVM_LOGGING_ENABLED)
+  if(logging_enabled_)
   {
     usc_utilities::log(predicted_labels, "/tmp/predicted_labels.txt");
     usc_utilities::log(test_data_samples, "/tmp/test_data.txt");
@@ -593,6 +602,318 @@ bool SVMClassifier::predict(const std::vector<task_recorder2_msgs::DataSample>&
   return true;
 }
 
+bool SVMClassifier::initializeStreaming(const std::vector<std::string>& names,
+                                        const int window_size)
+{
+  ROS_ASSERT_MSG(trained_ || loaded_, "SVMClassifier is not trained or loaded.");
+  streaming_initialized_ = false;
+  if (window_size < 1)
+  {
+    ROS_ERROR("Window size >%i< must be positive.", window_size);
+    return false;
+  }
+
+  // the index map is computed once instead of for each predicted sample
+  if (!task_recorder2_utilities::getIndices(names, svm_parameters_.msg_.variable_names, streaming_indices_))
+  {
+    return false;
+  }
+  const int num_variables = svm_parameters_.msg_.num_variables;
+  if ((int)streaming_indices_.size() != num_variables)
+  {
+    ROS_ERROR("Number of variables used when training the SVM >%i< does not correspond to number of variables provided >%i<.",
+              num_variables, (int)streaming_indices_.size());
+    return false;
+  }
+  streaming_num_signals_ = (int)names.size();
+  streaming_names_ = names;
+
+  // the decision function is only reproduced for kernels without normalization
+  shogun::CKernelNormalizer* normalizer = ckernel_->get_normalizer();
+  const bool identity_normalizer = (strcmp(normalizer->get_name(), "IdentityKernelNormalizer") == 0);
+  SG_UNREF(normalizer);
+  if (!identity_normalizer)
+  {
+    ROS_ERROR("Streaming predict path only supports the identity kernel normalizer.");
+    return false;
+  }
+  streaming_kernel_type_ = ckernel_->get_kernel_type();
+  if (streaming_kernel_type_ == shogun::K_GAUSSIAN)
+  {
+    shogun::CGaussianKernel* gaussian_kernel = static_cast<shogun::CGaussianKernel*> (ckernel_);
+    if (gaussian_kernel->get_compact_enabled())
+    {
+      ROS_ERROR("Streaming predict path does not support compact gaussian kernels.");
+      return false;
+    }
+    streaming_kernel_width_ = gaussian_kernel->get_width();
+  }
+  else if (streaming_kernel_type_ != shogun::K_LINEAR)
+  {
+    ROS_ERROR("Streaming predict path does not support kernel type >%i<.", streaming_kernel_type_);
+    return false;
+  }
+
+  // copy support vectors and alphas
+  shogun::CFeatures* lhs = ckernel_->get_lhs();
+  shogun::CSimpleFeatures<float64_t>* support_vector_features = dynamic_cast<shogun::CSimpleFeatures<float64_t>*> (lhs);
+  if (support_vector_features == NULL)
+  {
+    ROS_ERROR("Kernel does not contain the training features, cannot extract support vectors.");
+    SG_UNREF(lhs);
+    return false;
+  }
+  const int num_support_vectors = svm_->get_num_support_vectors();
+  std::vector<double> support_vectors(num_support_vectors * num_variables);
+  std::vector<double> alphas(num_support_vectors);
+  for (int i = 0; i < num_support_vectors; ++i)
+  {
+    const int32_t support_vector_index = svm_->get_support_vector(i);
+    int32_t length = 0;
+    bool do_free = false;
+    float64_t* support_vector = support_vector_features->get_feature_vector(support_vector_index, length, do_free);
+    if (length != num_variables)
+    {
+      ROS_ERROR("Support vector >%i< has >%i< dimensions, SVM has been trained for >%i< dimensions.", i, length, num_variables);
+      support_vector_features->free_feature_vector(support_vector, support_vector_index, do_free);
+      SG_UNREF(lhs);
+      return false;
+    }
+    for (int j = 0; j < num_variables; ++j)
+    {
+      support_vectors[i * num_variables + j] = static_cast<double> (support_vector[j]);
+    }
+    support_vector_features->free_feature_vector(support_vector, support_vector_index, do_free);
+    alphas[i] = static_cast<double> (svm_->get_alpha(i));
+  }
+  SG_UNREF(lhs);
+  streaming_bias_ = static_cast<double> (svm_->get_bias());
+
+  if (streaming_kernel_type_ == shogun::K_LINEAR)
+  {
+    // a linear decision function collapses into a single weight vector
+    streaming_num_support_vectors_ = 1;
+    streaming_support_vectors_.assign(num_variables, 0.0);
+    for (int i = 0; i < num_support_vectors; ++i)
+    {
+      for (int j = 0; j < num_variables; ++j)
+      {
+        streaming_support_vectors_[j] += alphas[i] * support_vectors[i * num_variables + j];
+      }
+    }
+    streaming_alphas_.assign(1, 1.0);
+  }
+  else
+  {
+    streaming_num_support_vectors_ = num_support_vectors;
+    streaming_support_vectors_.swap(support_vectors);
+    streaming_alphas_.swap(alphas);
+  }
+  streaming_support_vector_norms_.resize(streaming_num_support_vectors_);
+  for (int i = 0; i < streaming_num_support_vectors_; ++i)
+  {
+    const double* support_vector = &streaming_support_vectors_[i * num_variables];
+    double norm = 0.0;
+    for (int j = 0; j < num_variables; ++j)
+    {
+      norm += support_vector[j] * support_vector[j];
+    }
+    streaming_support_vector_norms_[i] = norm;
+  }
+
+  // the last row of the feature matrix is used for samples that are not added to the window
+  streaming_window_size_ = window_size;
+  streaming_features_.assign((streaming_window_size_ + 1) * num_variables, 0.0);
+  streaming_values_.assign(streaming_window_size_, 0.0);
+  streaming_stamps_.assign(streaming_window_size_, ros::Time(0));
+  resetStreamingWindow();
+
+  ROS_DEBUG("Initialized streaming predict path with >%i< support vectors and a window of >%i< samples.",
+            streaming_num_support_vectors_, streaming_window_size_);
+  return (streaming_initialized_ = true);
+}
+
+bool SVMClassifier::prepareStreaming(const std::vector<std::string>& names)
+{
+  // the index map is only valid for the names it has been computed for
+  if (streaming_initialized_ && names == streaming_names_)
+  {
+    return true;
+  }
+  return initializeStreaming(names, streaming_initialized_ ? streaming_window_size_ : MAX_NUM_TEST_SAMPLES);
+}
+
+void SVMClassifier::resetStreamingWindow()
+{
+  streaming_window_head_ = 0;
+  streaming_window_count_ = 0;
+}
+
+bool SVMClassifier::computeStreamingValue(const task_recorder2_msgs::DataSample& data_sample,
+                                          double& value)
+{
+  if ((int)data_sample.data.size() != streaming_num_signals_)
+  {
+    ROS_ERROR("Data sample contains >%i< signals, streaming predict path has been initialized for >%i< signals.",
+              (int)data_sample.data.size(), streaming_num_signals_);
+    return false;
+  }
+
+  // samples that are not newer than the window content (or have no time stamp) are not added
+  bool add_to_window = !data_sample.header.stamp.isZero();
+  if (add_to_window && streaming_window_count_ > 0)
+  {
+    const int newest = (streaming_window_head_ + streaming_window_size_ - 1) % streaming_window_size_;
+    add_to_window = (data_sample.header.stamp > streaming_stamps_[newest]);
+  }
+  const int num_variables = svm_parameters_.msg_.num_variables;
+  const int row = add_to_window ? streaming_window_head_ : streaming_window_size_;
+  double* features = &streaming_features_[row * num_variables];
+  double norm = 0.0;
+  for (int j = 0; j < num_variables; ++j)
+  {
+    features[j] = data_sample.data[streaming_indices_[j]];
+    norm += features[j] * features[j];
+  }
+
+  value = streaming_bias_;
+  for (int i = 0; i < streaming_num_support_vectors_; ++i)
+  {
+    const double* support_vector = &streaming_support_vectors_[i * num_variables];
+    double dot = 0.0;
+    for (int j = 0; j < num_variables; ++j)
+    {
+      dot += support_vector[j] * features[j];
+    }
+    if (streaming_kernel_type_ == shogun::K_GAUSSIAN)
+    {
+      value += streaming_alphas_[i] * exp(-(streaming_support_vector_norms_[i] + norm - 2.0 * dot) / streaming_kernel_width_);
+    }
+    else
+    {
+      value += streaming_alphas_[i] * dot;
+    }
+  }
+
+  if (add_to_window)
+  {
+    streaming_values_[streaming_window_head_] = value;
+    streaming_stamps_[streaming_window_head_] = data_sample.header.stamp;
+    streaming_window_head_ = (streaming_window_head_ + 1) % streaming_window_size_;
+    if (streaming_window_count_ < streaming_window_size_)
+    {
+      streaming_window_count_++;
+    }
+  }
+  return true;
+}
+
+bool SVMClassifier::findInStreamingWindow(const ros::Time& stamp,
+                                          double& value) const
+{
+  if (stamp.isZero())
+  {
+    return false;
+  }
+  // time stamps in the window are increasing, binary search from the oldest to the newest sample
+  const int oldest = (streaming_window_head_ + streaming_window_size_ - streaming_window_count_) % streaming_window_size_;
+  int low = 0;
+  int high = streaming_window_count_ - 1;
+  while (low <= high)
+  {
+    const int middle = (low + high) / 2;
+    const int index = (oldest + middle) % streaming_window_size_;
+    if (streaming_stamps_[index] < stamp)
+    {
+      low = middle + 1;
+    }
+    else if (streaming_stamps_[index] > stamp)
+    {
+      high = middle - 1;
+    }
+    else
+    {
+      value = streaming_values_[index];
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SVMClassifier::predictStreaming(const task_recorder2_msgs::DataSample& data_sample,
+                                     task_recorder2_msgs::DataSampleLabel& data_label)
+{
+  ROS_ASSERT_MSG(trained_ || loaded_, "SVMClassifier is not trained or loaded.");
+  if (!prepareStreaming(data_sample.names))
+  {
+    return false;
+  }
+  double value = 0.0;
+  if (!computeStreamingValue(data_sample, value))
+  {
+    return false;
+  }
+  return getLabel(value, data_label);
+}
+
+bool SVMClassifier::predictStreaming(const std::vector<task_recorder2_msgs::DataSample>& data_samples,
+                                     std::vector<task_recorder2_msgs::DataSampleLabel>& data_labels)
+{
+  ROS_ASSERT_MSG(trained_ || loaded_, "SVMClassifier is not trained or loaded.");
+  ROS_ASSERT_MSG(!data_samples.empty(), "Data samples are empty, cannot predict anything.");
+  if (!prepareStreaming(data_samples[0].names))
+  {
+    return false;
+  }
+
+  const int num_data_samples = (int)data_samples.size();
+  data_labels.resize(num_data_samples);
+  std::vector<double> predicted_labels;
+  if (logging_enabled_)
+  {
+    predicted_labels.resize(num_data_samples);
+  }
+  int num_scored_data_samples = 0;
+  for (int i = 0; i < num_data_samples; ++i)
+  {
+    if (i > 0 && data_samples[i].names != streaming_names_)
+    {
+      ROS_ERROR("Data sample >%i< does not contain the same names as the first data sample.", i);
+      return false;
+    }
+    double value = 0.0;
+    if (!findInStreamingWindow(data_samples[i].header.stamp, value))
+    {
+      if (!computeStreamingValue(data_samples[i], value))
+      {
+        return false;
+      }
+      num_scored_data_samples++;
+    }
+    ROS_VERIFY(getLabel(value, data_labels[i]));
+    if (logging_enabled_)
+    {
+      predicted_labels[i] = data_labels[i].binary_label.label;
+    }
+  }
+  ROS_DEBUG("Scored >%i< of >%i< data samples.", num_scored_data_samples, num_data_samples);
+
+  if (logging_enabled_)
+  {
+    std::vector<std::vector<double> > test_data_samples(num_data_samples, std::vector<double>(svm_parameters_.msg_.num_variables));
+    for (int i = 0; i < num_data_samples; ++i)
+    {
+      for (int j = 0; j < svm_parameters_.msg_.num_variables; ++j)
+      {
+        test_data_samples[i][j] = data_samples[i].data[streaming_indices_[j]];
+      }
+    }
+    usc_utilities::log(predicted_labels, "/tmp/predicted_labels.txt");
+    usc_utilities::log(test_data_samples, "/tmp/test_data.txt");
+  }
+  return true;
+}
+
 bool SVMClassifier::setClassificationBoundary(const double classification_boundary)
 {
   ROS_ASSERT(svm_parameters_.initialized_);
@@ -615,6 +936,7 @@ bool SVMClassifier::getLabel(const double value,
 bool SVMClassifier::setSVMParametersMsg(const SVMParametersMsg& msg)
 {
   svm_parameters_.msg_ = msg;
+  streaming_initialized_ = false;
   return true;
 }
 
@@ -0,0 +1,241 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks		...
+
+  \file		test_svm_streaming_predict.cpp
+
+  \date		Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <gtest/gtest.h>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+#include <task_recorder2_msgs/DataSample.h>
+#include <task_recorder2_msgs/DataSampleLabel.h>
+#include <task_recorder2_msgs/BinaryLabel.h>
+
+// local includes
+#include <task_event_detector/svm_classifier.h>
+#include <task_event_detector/shogun_init.h>
+
+using namespace task_event_detector;
+
+const int NUM_TRAINING_SAMPLES_PER_CLUSTER = 50;
+const int NUM_TEST_SAMPLES = 250;
+const double DISTANCE = 0.5;
+const double TOLERANCE = 1e-8;
+
+/*! Samples contain a distractor signal and the two SVM variables in reversed order such that the index map is not the identity
+ */
+task_recorder2_msgs::DataSample createDataSample(const double x,
+                                                 const double y,
+                                                 const int index)
+{
+  task_recorder2_msgs::DataSample data_sample;
+  data_sample.header.stamp = ros::Time(1.0 + 0.01 * static_cast<double> (index));
+  data_sample.names.push_back("distractor");
+  data_sample.names.push_back("test_variable_1");
+  data_sample.names.push_back("test_variable_0");
+  data_sample.data.push_back(static_cast<double> (rand()) / static_cast<double> (RAND_MAX));
+  data_sample.data.push_back(y);
+  data_sample.data.push_back(x);
+  return data_sample;
+}
+
+double getRandom(const double min,
+                 const double max)
+{
+  return min + (max - min) * static_cast<double> (rand()) / static_cast<double> (RAND_MAX);
+}
+
+/*! Trains on four clusters with XOR labels
+ */
+void train(const int kernel_type,
+           SVMClassifier& svm_classifier)
+{
+  SVMParametersMsg msg;
+  msg.svm_lib = shogun::CT_LIBSVM;
+  msg.kernel_type = kernel_type;
+  msg.kernel_width = 0.5;
+  msg.svm_c = 1.0;
+  msg.svm_eps = 1e-3;
+  msg.classification_boundary = 0.0;
+  SVMParameters svm_parameters;
+  ASSERT_TRUE(svm_parameters.set(msg));
+  ASSERT_TRUE(svm_classifier.set(svm_parameters));
+  svm_classifier.setLoggingEnabled(false);
+
+  std::vector<std::string> variable_names;
+  variable_names.push_back("test_variable_0");
+  variable_names.push_back("test_variable_1");
+
+  std::vector<task_recorder2_msgs::DataSample> data_samples;
+  std::vector<task_recorder2_msgs::DataSampleLabel> data_labels;
+  for (int c = 0; c < 4; ++c)
+  {
+    const double x_offset = (c % 2) ? DISTANCE : -DISTANCE;
+    const double y_offset = (c / 2) ? DISTANCE : -DISTANCE;
+    task_recorder2_msgs::DataSampleLabel data_label;
+    data_label.type = task_recorder2_msgs::DataSampleLabel::BINARY_LABEL;
+    data_label.binary_label.label = (x_offset * y_offset > 0.0) ? task_recorder2_msgs::BinaryLabel::SUCCEEDED
+        : task_recorder2_msgs::BinaryLabel::FAILED;
+    for (int i = 0; i < NUM_TRAINING_SAMPLES_PER_CLUSTER; ++i)
+    {
+      data_samples.push_back(createDataSample(x_offset + getRandom(0.0, 1.0), y_offset + getRandom(0.0, 1.0), (int)data_samples.size()));
+      data_labels.push_back(data_label);
+    }
+  }
+  ASSERT_TRUE(svm_classifier.addTrainingData(data_samples, data_labels, variable_names));
+  ASSERT_TRUE(svm_classifier.train());
+}
+
+void generateTestData(std::vector<task_recorder2_msgs::DataSample>& data_samples)
+{
+  data_samples.clear();
+  for (int i = 0; i < NUM_TEST_SAMPLES; ++i)
+  {
+    data_samples.push_back(createDataSample(getRandom(-1.0, 2.0), getRandom(-1.0, 2.0), i));
+  }
+}
+
+/*! Compares the decision values (stored in the cost label) and the binary labels
+ */
+void expectEqual(const std::vector<task_recorder2_msgs::DataSampleLabel>& shogun_labels,
+                 const std::vector<task_recorder2_msgs::DataSampleLabel>& streaming_labels,
+                 const int offset = 0)
+{
+  for (int i = 0; i < (int)streaming_labels.size(); ++i)
+  {
+    const task_recorder2_msgs::DataSampleLabel& expected = shogun_labels[offset + i];
+    EXPECT_EQ(task_recorder2_msgs::DataSampleLabel::BINARY_LABEL, streaming_labels[i].type);
+    EXPECT_NEAR(expected.cost_label.cost, streaming_labels[i].cost_label.cost, TOLERANCE * (1.0 + fabs(expected.cost_label.cost)))
+        << "sample " << offset + i;
+    if (fabs(expected.cost_label.cost) > TOLERANCE)
+    {
+      EXPECT_EQ(expected.binary_label.label, streaming_labels[i].binary_label.label) << "sample " << offset + i;
+    }
+  }
+}
+
+void compareStreamingToShogun(SVMClassifier& svm_classifier)
+{
+  std::vector<task_recorder2_msgs::DataSample> data_samples;
+  generateTestData(data_samples);
+  std::vector<task_recorder2_msgs::DataSampleLabel> shogun_labels;
+  ASSERT_TRUE(svm_classifier.predict(data_samples, shogun_labels));
+  ASSERT_EQ(NUM_TEST_SAMPLES, (int)shogun_labels.size());
+
+  // one sample at a time
+  std::vector<task_recorder2_msgs::DataSampleLabel> streaming_labels(NUM_TEST_SAMPLES);
+  for (int i = 0; i < NUM_TEST_SAMPLES; ++i)
+  {
+    ASSERT_TRUE(svm_classifier.predictStreaming(data_samples[i], streaming_labels[i]));
+  }
+  EXPECT_TRUE(svm_classifier.isStreamingInitialized());
+  expectEqual(shogun_labels, streaming_labels);
+
+  // overlapping windows, only the newest samples of each window are scored
+  svm_classifier.resetStreamingWindow();
+  const int WINDOW_SIZE = 40;
+  const int STEP_SIZE = 7;
+  for (int start = 0; start + WINDOW_SIZE <= NUM_TEST_SAMPLES; start += STEP_SIZE)
+  {
+    std::vector<task_recorder2_msgs::DataSample> window(data_samples.begin() + start, data_samples.begin() + start + WINDOW_SIZE);
+    ASSERT_TRUE(svm_classifier.predictStreaming(window, streaming_labels));
+    ASSERT_EQ(WINDOW_SIZE, (int)streaming_labels.size());
+    expectEqual(shogun_labels, streaming_labels, start);
+  }
+
+  // all samples at once, most of them have been evicted from the window
+  ASSERT_TRUE(svm_classifier.predictStreaming(data_samples, streaming_labels));
+  expectEqual(shogun_labels, streaming_labels);
+}
+
+TEST(SVMClassifierStreaming, gaussianKernel)
+{
+  srand(0);
+  SVMClassifier svm_classifier;
+  train(shogun::K_GAUSSIAN, svm_classifier);
+  compareStreamingToShogun(svm_classifier);
+}
+
+TEST(SVMClassifierStreaming, linearKernel)
+{
+  srand(1);
+  SVMClassifier svm_classifier;
+  train(shogun::K_LINEAR, svm_classifier);
+  compareStreamingToShogun(svm_classifier);
+}
+
+TEST(SVMClassifierStreaming, loadedSVM)
+{
+  srand(2);
+  SVMClassifier svm_classifier;
+  train(shogun::K_GAUSSIAN, svm_classifier);
+  ASSERT_TRUE(svm_classifier.save("/tmp"));
+
+  SVMClassifier loaded_svm_classifier;
+  ASSERT_TRUE(loaded_svm_classifier.load("/tmp"));
+  loaded_svm_classifier.setLoggingEnabled(false);
+  compareStreamingToShogun(loaded_svm_classifier);
+}
+
+TEST(SVMClassifierStreaming, changedNames)
+{
+  srand(4);
+  SVMClassifier svm_classifier;
+  train(shogun::K_GAUSSIAN, svm_classifier);
+  ASSERT_TRUE(svm_classifier.initializeStreaming(createDataSample(0.0, 0.0, 0).names, 20));
+  compareStreamingToShogun(svm_classifier);
+
+  // same number of signals in a different order, the index map needs to be recomputed
+  std::vector<task_recorder2_msgs::DataSample> data_samples;
+  generateTestData(data_samples);
+  for (int i = 0; i < NUM_TEST_SAMPLES; ++i)
+  {
+    std::swap(data_samples[i].names[0], data_samples[i].names[2]);
+    std::swap(data_samples[i].data[0], data_samples[i].data[2]);
+    data_samples[i].header.stamp = ros::Time(data_samples[i].header.stamp.toSec() + 10.0);
+  }
+  std::vector<task_recorder2_msgs::DataSampleLabel> shogun_labels;
+  ASSERT_TRUE(svm_classifier.predict(data_samples, shogun_labels));
+  std::vector<task_recorder2_msgs::DataSampleLabel> streaming_labels(1);
+  ASSERT_TRUE(svm_classifier.predictStreaming(data_samples[0], streaming_labels[0]));
+  expectEqual(shogun_labels, streaming_labels);
+  ASSERT_TRUE(svm_classifier.predictStreaming(data_samples, streaming_labels));
+  expectEqual(shogun_labels, streaming_labels);
+
+  // all data samples of a batch need to have the same names
+  generateTestData(data_samples);
+  std::swap(data_samples.back().names[0], data_samples.back().names[2]);
+  EXPECT_FALSE(svm_classifier.predictStreaming(data_samples, streaming_labels));
+}
+
+TEST(SVMClassifierStreaming, invalidNames)
+{
+  srand(3);
+  SVMClassifier svm_classifier;
+  train(shogun::K_GAUSSIAN, svm_classifier);
+  std::vector<std::string> names;
+  names.push_back("test_variable_0");
+  EXPECT_FALSE(svm_classifier.initializeStreaming(names));
+  EXPECT_FALSE(svm_classifier.isStreamingInitialized());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  task_event_detector::init();
+  const int result = RUN_ALL_TESTS();
+  task_event_detector::exit();
+  return result;
+}
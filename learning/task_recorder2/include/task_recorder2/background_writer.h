@@ -0,0 +1,102 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks		...
+
+  \file		background_writer.h
+
+  \date		Oct 17, 2026
+
+ *********************************************************************/
+
+#ifndef BACKGROUND_WRITER_H_
+#define BACKGROUND_WRITER_H_
+
+// system includes
+#include <deque>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+// local includes
+
+namespace task_recorder2
+{
+
+/*! Bounded queue of write jobs (e.g. TaskRecorderIO bag and CLMC writes) that are processed in
+ * order by a single background thread. Pushing a job blocks while the queue is full.
+ */
+class BackgroundWriter
+{
+
+public:
+
+  typedef boost::function<bool ()> Job;
+
+  /*! Constructor
+   */
+  BackgroundWriter() :
+    initialized_(false), max_num_pending_jobs_(0), num_pushed_jobs_(0), num_done_jobs_(0), failed_(false), stop_(false) {};
+  /*! Destructor, processes all pending jobs before it returns
+   */
+  virtual ~BackgroundWriter();
+
+  /*!
+   * @param max_num_pending_jobs
+   * @return True on success, otherwise False
+   */
+  bool initialize(const int max_num_pending_jobs);
+
+  /*! Adds the job to the queue. Blocks while max_num_pending_jobs are pending.
+   * @param job
+   * @return Id of the job
+   */
+  int push(const Job& job);
+
+  /*!
+   * @param job_id
+   * @return True if the job with job_id has been processed, otherwise False
+   */
+  bool isDone(const int job_id);
+
+  /*!
+   * @return Number of jobs that are queued or being processed
+   */
+  int getNumPendingJobs();
+
+  /*! Blocks until all pushed jobs have been processed
+   * @return True if all jobs processed since the last flush succeeded, otherwise False
+   */
+  bool flush();
+
+private:
+
+  bool initialized_;
+  int max_num_pending_jobs_;
+
+  /*! Job ids are consecutive and jobs are processed in order
+   */
+  int num_pushed_jobs_;
+  int num_done_jobs_;
+  bool failed_;
+  bool stop_;
+
+  std::deque<Job> jobs_;
+  boost::mutex mutex_;
+  boost::condition_variable job_pushed_condition_;
+  boost::condition_variable job_done_condition_;
+  boost::shared_ptr<boost::thread> thread_;
+
+  /*!
+   */
+  void run();
+
+};
+
+}
+
+#endif /* BACKGROUND_WRITER_H_ */
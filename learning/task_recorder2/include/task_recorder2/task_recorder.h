@@ -32,6 +32,7 @@
 // #include <task_recorder2_utilities/accumulator.h>
 #include <task_recorder2_utilities/message_buffer.h>
 #include <task_recorder2_utilities/message_ring_buffer.h>
+#include <task_recorder2_utilities/data_sample_buffer.h>
 
 #include <task_recorder2_utilities/data_sample_utilities.h>
 #include <task_recorder2_utilities/task_description_utilities.h>
@@ -286,20 +287,20 @@ template<class MessageType>
     void recordMessagesCallback(const MessageTypeConstPtr message);
 
     /*!
-     * @param messages
+     * @param data_samples
      * @param start_time
      * @param end_time
      * @param num_samples
      * @param message_names
-     * @param resampled_messages
+     * @param resampled_data_samples
      * @return True on success, otherwise False
      */
-    bool resample(std::vector<task_recorder2_msgs::DataSample>& messages,
+    bool resample(const task_recorder2_utilities::DataSampleBuffer& data_samples,
                   const ros::Time& start_time,
                   const ros::Time& end_time,
                   const int num_samples,
                   const std::vector<std::string>& message_names,
-                  std::vector<task_recorder2_msgs::DataSample>& resampled_messages);
+                  task_recorder2_utilities::DataSampleBuffer& resampled_data_samples);
 
     /*!
      * @param data_sample
@@ -436,7 +437,7 @@ template<class MessageType>
     {
       // double delay = (ros::Time::now() - data_sample_.header.stamp).toSec();
       // ROS_INFO("Delay = %f", delay);
-      recorder_io_.messages_.push_back(data_sample_);
+      ROS_VERIFY(recorder_io_.data_samples_.add(data_sample_));
     }
     if (streaming_)
     {
@@ -454,10 +455,10 @@ template<class MessageType>
     {
       ros::spinOnce();
       mutex_.lock();
-      no_message = recorder_io_.messages_.empty();
+      no_message = recorder_io_.data_samples_.empty();
       if (!no_message)
       {
-        abs_start_time_ = recorder_io_.messages_[0].header.stamp;
+        abs_start_time_ = recorder_io_.data_samples_.getStamp(0);
       }
       mutex_.unlock();
     }
@@ -477,7 +478,7 @@ template<class MessageType>
     mutex_.lock();
     logging_ = true;
     // streaming_ = true;
-    recorder_io_.messages_.clear();
+    recorder_io_.data_samples_.clear();
     mutex_.unlock();
     ROS_VERIFY(startRecording());
     waitForMessages();
@@ -514,7 +515,7 @@ template<class MessageType>
     mutex_.lock();
     if (logging_)
     {
-      last = recorder_io_.messages_.back().header.stamp;
+      last = recorder_io_.data_samples_.getLastStamp();
     }
     mutex_.unlock();
     return true;
@@ -614,7 +615,7 @@ template<class MessageType>
                                                 const std::vector<std::string>& message_names,
                                                 std::vector<task_recorder2_msgs::DataSample>& filter_and_cropped_messages)
   {
-    int num_messages = (int)recorder_io_.messages_.size();
+    int num_messages = recorder_io_.data_samples_.size();
     if (num_messages == 0)
     {
       ROS_ERROR("Zero messages have been logged.");
@@ -632,13 +633,13 @@ template<class MessageType>
       {
         boost::thread(boost::bind(&TaskRecorderIO<task_recorder2_msgs::DataSample>::writeRawData, recorder_io_));
       }
-      recorder_io_.messages_ = filter_and_cropped_messages;
+      ROS_VERIFY(recorder_io_.data_samples_.set(filter_and_cropped_messages));
       return true;
     }
 
     // figure out when our data starts and ends
-    ros::Time our_start_time = recorder_io_.messages_[0].header.stamp;
-    ros::Time our_end_time = recorder_io_.messages_[num_messages - 1].header.stamp;
+    ros::Time our_start_time = recorder_io_.data_samples_.getStamp(0);
+    ros::Time our_end_time = recorder_io_.data_samples_.getStamp(num_messages - 1);
 
     int index = 0;
     while (our_end_time.toSec() < 1e-6)
@@ -649,7 +650,7 @@ template<class MessageType>
         ROS_ERROR("Time stamps of recorded messages seem to be invalid.");
         return false;
       }
-      our_end_time = recorder_io_.messages_[num_messages - (1 + index)].header.stamp;
+      our_end_time = recorder_io_.data_samples_.getStamp(num_messages - (1 + index));
     }
 
     if (our_start_time > start_time || our_end_time < end_time)
@@ -661,65 +662,63 @@ template<class MessageType>
     }
 
     // first crop
-    ROS_VERIFY(task_recorder2_utilities::crop<task_recorder2_msgs::DataSample>(recorder_io_.messages_, start_time, end_time));
+    ROS_VERIFY(recorder_io_.data_samples_.crop(start_time, end_time));
     // then remove duplicates
-    ROS_VERIFY(task_recorder2_utilities::removeDuplicates<task_recorder2_msgs::DataSample>(recorder_io_.messages_));
+    ROS_VERIFY(recorder_io_.data_samples_.removeDuplicates());
 
     if(recorder_io_.write_out_raw_data_)
     {
       boost::thread(boost::bind(&TaskRecorderIO<task_recorder2_msgs::DataSample>::writeRawData, recorder_io_));
     }
 
-    ROS_DEBUG("Resampling >%i< messages to >%i< messages for topic >%s<.", (int)recorder_io_.messages_.size(), num_samples, recorder_io_.topic_name_.c_str());
+    ROS_DEBUG("Resampling >%i< messages to >%i< messages for topic >%s<.", recorder_io_.data_samples_.size(), num_samples, recorder_io_.topic_name_.c_str());
 
     // then resample
-    ROS_VERIFY(resample(recorder_io_.messages_, start_time, end_time, num_samples, message_names, filter_and_cropped_messages));
-    ROS_ASSERT(static_cast<int>(filter_and_cropped_messages.size()) == num_samples);
+    task_recorder2_utilities::DataSampleBuffer resampled_data_samples;
+    ROS_VERIFY(resample(recorder_io_.data_samples_, start_time, end_time, num_samples, message_names, resampled_data_samples));
+    ROS_ASSERT(resampled_data_samples.size() == num_samples);
 
-    recorder_io_.messages_ = filter_and_cropped_messages;
+    // only convert into messages once all processing is done
+    ROS_VERIFY(resampled_data_samples.getMessages(filter_and_cropped_messages));
+    recorder_io_.data_samples_ = resampled_data_samples;
     return true;
   }
 
 template<class MessageType>
-  bool TaskRecorder<MessageType>::resample(std::vector<task_recorder2_msgs::DataSample>& messages,
+  bool TaskRecorder<MessageType>::resample(const task_recorder2_utilities::DataSampleBuffer& data_samples,
                                            const ros::Time& start_time,
                                            const ros::Time& end_time,
                                            const int num_samples,
                                            const std::vector<std::string>& message_names,
-                                           std::vector<task_recorder2_msgs::DataSample>& resampled_messages)
+                                           task_recorder2_utilities::DataSampleBuffer& resampled_data_samples)
   {
     // error checking
-    ROS_ASSERT(!messages.empty());
-    for (int i = 0; i < (int)messages.size(); ++i)
-    {
-      ROS_ASSERT(!messages[i].names.empty());
-      ROS_ASSERT(messages[i].names.size() == messages[i].data.size());
-    }
+    ROS_ASSERT(!data_samples.empty());
+    ROS_ASSERT(!data_samples.getNames().empty());
     ROS_ASSERT(num_samples > 1);
 
     // extract indices
     std::vector<std::string> selected_names = message_names;
     if(selected_names.empty())
     {
-      selected_names = messages[0].names;
+      selected_names = data_samples.getNames();
     }
 
     std::vector<int> indices;
-    ROS_VERIFY(task_recorder2_utilities::getIndices(messages[0].names, selected_names, indices));
+    ROS_VERIFY(task_recorder2_utilities::getIndices(data_samples.getNames(), selected_names, indices));
 
-    const int num_messages = static_cast<int> (messages.size());
-    const int num_vars = static_cast<int>(indices.size());
+    const int num_messages = data_samples.size();
 
     // compute mean dt of the provided time stamps
     double dts[num_messages - 1];
     double mean_dt = 0.0;
 
     std::vector<double> input_vector(num_messages);
-    ros::Time first_time_stamp = messages[0].header.stamp;
-    input_vector[0] = messages[0].header.stamp.toSec();
+    ros::Time first_time_stamp = data_samples.getStamp(0);
+    input_vector[0] = data_samples.getStamp(0).toSec();
     for (int i = 0; i < num_messages - 1; i++)
     {
-      dts[i] = messages[i + 1].header.stamp.toSec() - messages[i].header.stamp.toSec();
+      dts[i] = data_samples.getStamp(i + 1).toSec() - data_samples.getStamp(i).toSec();
       mean_dt += dts[i];
       input_vector[i + 1] = input_vector[i] + dts[i];
     }
@@ -728,72 +727,46 @@ template<class MessageType>
     ros::Duration interval = static_cast<ros::Duration> (end_time - start_time) * (1.0 / double(num_samples - 1));
     double wave_length = interval.toSec() * static_cast<double> (2.0);
 
-    resampled_messages.clear();
     std::vector<double> input_querry(num_samples);
     for (int i = 0; i < num_samples; i++)
     {
-      task_recorder2_msgs::DataSample msg;
-      msg.header.seq = i;
-      msg.header.stamp = static_cast<ros::Time> (start_time.toSec() + i * interval.toSec());
-      msg.header.frame_id = messages[0].header.frame_id;
-      input_querry[i] = msg.header.stamp.toSec();
-      resampled_messages.push_back(msg);
+      input_querry[i] = static_cast<ros::Time> (start_time.toSec() + i * interval.toSec()).toSec();
     }
 
-    std::vector<std::vector<double> > variables;
-    variables.resize(num_vars);
-    for (int j = 0; j < num_messages; ++j)
+    // one column per variable, all of them share the same time stamps
+    Eigen::MatrixXd variables;
+    ROS_VERIFY(data_samples.getData(indices, variables));
+
+    usc_utilities::ResamplingMethod resampling_method = usc_utilities::BSPLINE_RESAMPLING;
+    switch(splining_method_)
     {
-      for (int i = 0; i < num_vars; ++i)
+      case BSpline:
       {
-        variables[i].push_back(messages[j].data[indices[i]]);
+        resampling_method = usc_utilities::BSPLINE_RESAMPLING;
+        break;
       }
-    }
-
-    std::vector<std::vector<double> > variables_resampled;
-    variables_resampled.resize(num_vars);
-    for (int i = 0; i < num_vars; ++i)
-    {
-      switch(splining_method_)
+      case Linear:
       {
-        case BSpline:
-        {
-          ROS_VERIFY(usc_utilities::resample(input_vector, variables[i], wave_length, input_querry, variables_resampled[i], false));
-          // log(task_recorder2_utilities::getDataFileName(recorder_io_.prefixed_topic_name_, i), i, input_vector, variables[i], input_querry, variables_resampled[i]);
-          break;
-        }
-        case Linear:
-        {
-          ROS_VERIFY(usc_utilities::resampleLinearNoBounds(input_vector, variables[i], input_querry, variables_resampled[i]));
-          // log(task_recorder2_utilities::getDataFileName(recorder_io_.prefixed_topic_name_, i), i, input_vector, variables[i], input_querry, variables_resampled[i]);
-          break;
-        }
-        default:
-        {
-          ROS_ASSERT_MSG(false, "Unknown sampling method for task recorder with topic >%s<. This should never happen.", recorder_io_.topic_name_.c_str());
-          break;
-        }
+        resampling_method = usc_utilities::LINEAR_RESAMPLING;
+        break;
+      }
+      default:
+      {
+        ROS_ASSERT_MSG(false, "Unknown sampling method for task recorder with topic >%s<. This should never happen.", recorder_io_.topic_name_.c_str());
+        break;
       }
     }
+    Eigen::MatrixXd variables_resampled;
+    ROS_VERIFY(usc_utilities::resample(input_vector, variables, wave_length, input_querry, variables_resampled, resampling_method));
 
-    std::vector<std::string> names;
-    for (int i = 0; i < num_vars; ++i)
-    {
-      names.push_back(messages[0].names[indices[i]]);
-    }
+    std::vector<ros::Time> stamps(num_samples);
     for (int j = 0; j < num_samples; ++j)
     {
-      resampled_messages[j].data.resize(num_vars, 0.0);
-      for (int i = 0; i < num_vars; ++i)
-      {
-        resampled_messages[j].data[i] = variables_resampled[i][j];
-      }
-      resampled_messages[j].names = names;
       // make time stamps start from 0.0
-      // resampled_messages[j].header.stamp = static_cast<ros::Time> (ros::TIME_MIN + ros::Duration(j * interval.toSec()));
-      resampled_messages[j].header.stamp = static_cast<ros::Time> (first_time_stamp - ros::Duration(ROS_TIME_OFFSET) + ros::Duration(j * interval.toSec()));
+      // stamps[j] = static_cast<ros::Time> (ros::TIME_MIN + ros::Duration(j * interval.toSec()));
+      stamps[j] = static_cast<ros::Time> (first_time_stamp - ros::Duration(ROS_TIME_OFFSET) + ros::Duration(j * interval.toSec()));
     }
-    return true;
+    return resampled_data_samples.set(selected_names, stamps, variables_resampled, data_samples.getFrameId());
   }
 
 template<class MessageType>
@@ -16,6 +16,7 @@
 #define TASK_RECORDER_IO_H_
 
 // system includes
+#include <algorithm>
 
 // ros includes
 #include <ros/ros.h>
@@ -34,6 +35,7 @@
 #include <task_recorder2_msgs/Description.h>
 #include <task_recorder2_msgs/AccumulatedTrialStatistics.h>
 #include <task_recorder2_utilities/task_recorder_utilities.h>
+#include <task_recorder2_utilities/data_sample_buffer.h>
 #include <task_recorder2_utilities/task_description_utilities.h>
 
 #include <dmp_lib/trajectory.h>
@@ -63,7 +65,7 @@ template<class MessageType>
           initialized_(false)
     {
       ROS_DEBUG("Reserving memory for >%i< messages.", NUMBER_OF_INITIALLY_RESERVED_MESSAGES);
-      messages_.reserve(NUMBER_OF_INITIALLY_RESERVED_MESSAGES);
+      data_samples_.reserve(NUMBER_OF_INITIALLY_RESERVED_MESSAGES);
     };
 
     /*! Destructor
@@ -151,9 +153,9 @@ template<class MessageType>
     std::string topic_name_;
     std::string prefixed_topic_name_;
 
-    /*!
+    /*! Recorded data samples, converted into messages only when written to file
      */
-    std::vector<MessageType> messages_;
+    task_recorder2_utilities::DataSampleBuffer data_samples_;
     bool write_out_raw_data_;
     bool write_out_clmc_data_;
     bool write_out_resampled_data_;
@@ -178,6 +180,12 @@ template<class MessageType>
     boost::filesystem::path absolute_data_directory_path_;
     bool create_directories_;
 
+    /*!
+     * @param abs_bag_file_name
+     * @return True on success, otherwise False
+     */
+    bool writeToBagFile(const std::string& abs_bag_file_name);
+
   };
 
 template<class MessageType>
@@ -198,11 +206,19 @@ template<class MessageType>
     ROS_VERIFY(usc_utilities::read(node_handle_, "write_out_clmc_data", write_out_clmc_data_));
     ROS_VERIFY(usc_utilities::read(node_handle_, "write_out_statistics", write_out_statistics_));
 
-    std::string recorder_package_name;
-    ROS_VERIFY(usc_utilities::read(node_handle_, "recorder_package_name", recorder_package_name));
-    std::string recorder_data_directory_name;
-    ROS_VERIFY(usc_utilities::read(node_handle_, "recorder_data_directory_name", recorder_data_directory_name));
-    data_directory_name_ = task_recorder2_utilities::getDirectoryPath(recorder_package_name, recorder_data_directory_name);
+    // an absolute data directory (e.g. a temporary one) takes precedence over the directory inside the recorder package
+    if (node_handle_.getParam("recorder_data_directory_path", data_directory_name_))
+    {
+      usc_utilities::appendTrailingSlash(data_directory_name_);
+    }
+    else
+    {
+      std::string recorder_package_name;
+      ROS_VERIFY(usc_utilities::read(node_handle_, "recorder_package_name", recorder_package_name));
+      std::string recorder_data_directory_name;
+      ROS_VERIFY(usc_utilities::read(node_handle_, "recorder_data_directory_name", recorder_data_directory_name));
+      data_directory_name_ = task_recorder2_utilities::getDirectoryPath(recorder_package_name, recorder_data_directory_name);
+    }
     ROS_VERIFY(task_recorder2_utilities::checkAndCreateDirectories(data_directory_name_));
     ROS_DEBUG("Setting TaskRecorderIO data directory name to >%s<.", data_directory_name_.c_str());
 
@@ -270,7 +286,7 @@ template<class MessageType>
         usc_utilities::appendTrailingSlash(file_name);
       }
       file_name.append(task_recorder2_utilities::getDataFileName(prefixed_topic_name_, description_.trial));
-      ROS_VERIFY(usc_utilities::FileIO<MessageType>::writeToBagFileWithTimeStamps(messages_, topic_name_, file_name, false));
+      ROS_VERIFY(writeToBagFile(file_name));
       if (increment_trial_counter)
       {
         ROS_VERIFY(task_recorder2_utilities::incrementTrialCounterFile(path, prefixed_topic_name_));
@@ -281,7 +297,31 @@ template<class MessageType>
     else
     {
       std::string file_name = absolute_data_directory_path_.file_string();
-      ROS_VERIFY(usc_utilities::FileIO<MessageType>::writeToBagFileWithTimeStamps(messages_, topic_name_, file_name, false));
+      ROS_VERIFY(writeToBagFile(file_name));
+    }
+    return true;
+  }
+
+template<class MessageType>
+  bool TaskRecorderIO<MessageType>::writeToBagFile(const std::string& abs_bag_file_name)
+  {
+    ROS_ASSERT_MSG(!data_samples_.empty(), "Data samples are empty. Cannot write anything to bag file >%s<.", abs_bag_file_name.c_str());
+    try
+    {
+      rosbag::Bag bag(abs_bag_file_name, rosbag::bagmode::Write);
+      // names are the same for all samples, therefore they are only assigned once
+      task_recorder2_msgs::DataSample data_sample;
+      for (int i = 0; i < data_samples_.size(); ++i)
+      {
+        ROS_VERIFY(data_samples_.getMessage(i, data_sample, (i == 0)));
+        bag.write(topic_name_, data_sample.header.stamp, data_sample);
+      }
+      bag.close();
+    }
+    catch (rosbag::BagIOException& ex)
+    {
+      ROS_ERROR("Problem when writing to bag file named >%s< : %s", abs_bag_file_name.c_str(), ex.what());
+      return false;
     }
     return true;
   }
@@ -318,7 +358,7 @@ template<class MessageType>
   bool TaskRecorderIO<MessageType>::writeRecordedDataToCLMCFile(const std::string directory_name)
   {
     ROS_ASSERT_MSG(initialized_, "Task recorder IO module is not initialized.");
-    ROS_ASSERT_MSG(!messages_.empty(), "Messages are empty. Cannot write anything to CLMC file.");
+    ROS_ASSERT_MSG(!data_samples_.empty(), "Data samples are empty. Cannot write anything to CLMC file.");
     if(create_directories_)
     {
       std::string file_name = task_recorder2_utilities::getPathNameIncludingTrailingSlash(absolute_data_directory_path_);
@@ -334,8 +374,8 @@ template<class MessageType>
       ROS_VERIFY(task_recorder2_utilities::setCLMCFileName(clmc_file_name, description_.trial - 1));
       file_name.append(clmc_file_name);
 
-      const int trajectory_length = (int)messages_.size();
-      double trajectory_duration = (messages_[trajectory_length-1].header.stamp - messages_[0].header.stamp).toSec();
+      const int trajectory_length = data_samples_.size();
+      double trajectory_duration = (data_samples_.getStamp(trajectory_length-1) - data_samples_.getStamp(0)).toSec();
       if(trajectory_length == 1) // TODO: think about this again...
       {
         ROS_WARN("Only 1 data sample contained when writing out clmc data file.");
@@ -346,13 +386,14 @@ template<class MessageType>
       boost::scoped_ptr<dmp_lib::Trajectory> trajectory(new dmp_lib::Trajectory());
       std::vector<std::string> variable_names;
       variable_names.push_back("ros_time");
-      variable_names.insert(variable_names.end(), messages_[0].names.begin(), messages_[0].names.end());
+      variable_names.insert(variable_names.end(), data_samples_.getNames().begin(), data_samples_.getNames().end());
       ROS_VERIFY(trajectory->initialize(variable_names, SAMPLING_FREQUENCY, true, trajectory_length));
+      const int num_signals = data_samples_.getNumSignals();
+      std::vector<double> data(1 + num_signals);
       for (int i = 0; i < trajectory_length; ++i)
       {
-        std::vector<double> data;
-        data.push_back(static_cast<double>(messages_[i].header.stamp.toSec()));
-        data.insert(data.end(), messages_[i].data.begin(), messages_[i].data.end());
+        data[0] = static_cast<double>(data_samples_.getStamp(i).toSec());
+        std::copy(data_samples_.getData(i), data_samples_.getData(i) + num_signals, data.begin() + 1);
         ROS_VERIFY(trajectory->add(data, true));
       }
       ROS_VERIFY(trajectory->writeToCLMCFile(file_name, true));
@@ -402,7 +443,7 @@ template<class MessageType>
         for (int j = 0; j < static_cast<int> (accumulated_trial_statistics.size()); ++j)
         {
           // accumulated_trial_statistics[j].id = getId(description_);
-          bag.write(topic_name_, messages_[j].header.stamp, accumulated_trial_statistics[j]);
+          bag.write(topic_name_, data_samples_.getStamp(j), accumulated_trial_statistics[j]);
         }
       }
       bag.close();
@@ -25,6 +25,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include <task_recorder2_msgs/DataSample.h>
+#include <task_recorder2_msgs/Notification.h>
 
 #include <task_recorder2/joint_states_recorder.h>
 #include <task_recorder2/audio_recorder.h>
@@ -45,6 +46,7 @@
 // local includes
 #include <task_recorder2/task_recorder_io.h>
 #include <task_recorder2/task_recorder.h>
+#include <task_recorder2/background_writer.h>
 
 namespace task_recorder2
 {
@@ -58,9 +60,12 @@ public:
    * @param node_handle
    */
   TaskRecorderManager(ros::NodeHandle node_handle);
-  /*! Destructor
+  /*! Destructor, waits until all recorded data is written
    */
-  virtual ~TaskRecorderManager() {};
+  virtual ~TaskRecorderManager()
+  {
+    background_writer_.flush();
+  };
 
   /*!
    * @return True on success, False otherwise
@@ -153,6 +158,30 @@ public:
   bool readDataSamples(task_recorder2::ReadDataSamples::Request& request,
                        task_recorder2::ReadDataSamples::Response& response);
 
+  /*!
+   * @param write_id as set by the last call to stopRecording
+   * @return True if the corresponding data has been written to disc, otherwise False
+   */
+  bool isWritten(const int write_id);
+
+  /*!
+   * @return Id of the data written after the last call to stopRecording
+   */
+  int getLastWriteId() const
+  {
+    return last_write_id_;
+  }
+
+  /*!
+   * @return Number of writes that are queued or in progress
+   */
+  int getNumPendingWrites();
+
+  /*! Blocks until all queued data has been written to disc
+   * @return True if all writes succeeded, otherwise False
+   */
+  bool waitForPendingWrites();
+
 protected:
 
   /*!
@@ -173,6 +202,18 @@ private:
   ros::Timer timer_;
   int counter_;
 
+  /*! post processing of the task recorders when recording is stopped
+   */
+  int num_post_processing_threads_;
+  int next_post_processing_index_;
+  boost::mutex post_processing_mutex_;
+  std::vector<int> stop_recording_results_;
+
+  /*! writes recorded data to disc in the background
+   */
+  BackgroundWriter background_writer_;
+  int last_write_id_;
+
   /*! task recorders
    */
   std::vector<boost::shared_ptr<task_recorder2::TaskRecorderBase> > task_recorders_;
@@ -224,6 +265,18 @@ private:
    */
   bool setLastDataSample(const ros::Time& time_stamp);
 
+  /*! Calls stopRecording on task recorders until all of them are processed, run by each post processing thread
+   */
+  void postProcess();
+
+  /*!
+   * @param recorder_io Copy of the recorder io that contains the data to be written
+   * @param notification Published once the data is written
+   * @return True on success, otherwise False
+   */
+  bool writeRecordedData(boost::shared_ptr<TaskRecorderIO<task_recorder2_msgs::DataSample> > recorder_io,
+                         const task_recorder2_msgs::Notification notification);
+
 };
 
 }
@@ -0,0 +1,130 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks		...
+
+  \file		background_writer.cpp
+
+  \date		Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <ros/ros.h>
+#include <boost/bind.hpp>
+
+// local includes
+#include <task_recorder2/background_writer.h>
+
+namespace task_recorder2
+{
+
+BackgroundWriter::~BackgroundWriter()
+{
+  if (initialized_)
+  {
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      stop_ = true;
+    }
+    job_pushed_condition_.notify_all();
+    thread_->join();
+  }
+}
+
+bool BackgroundWriter::initialize(const int max_num_pending_jobs)
+{
+  if (initialized_)
+  {
+    ROS_ERROR("Background writer is already initialized.");
+    return false;
+  }
+  if (max_num_pending_jobs < 1)
+  {
+    ROS_ERROR("Maximum number of pending jobs >%i< must be positive.", max_num_pending_jobs);
+    return false;
+  }
+  max_num_pending_jobs_ = max_num_pending_jobs;
+  thread_.reset(new boost::thread(boost::bind(&BackgroundWriter::run, this)));
+  return (initialized_ = true);
+}
+
+int BackgroundWriter::push(const Job& job)
+{
+  ROS_ASSERT_MSG(initialized_, "Background writer is not initialized.");
+  int job_id = 0;
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    while (num_pushed_jobs_ - num_done_jobs_ >= max_num_pending_jobs_)
+    {
+      job_done_condition_.wait(lock);
+    }
+    jobs_.push_back(job);
+    job_id = num_pushed_jobs_++;
+  }
+  job_pushed_condition_.notify_one();
+  return job_id;
+}
+
+bool BackgroundWriter::isDone(const int job_id)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  return (job_id < num_done_jobs_);
+}
+
+int BackgroundWriter::getNumPendingJobs()
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  return num_pushed_jobs_ - num_done_jobs_;
+}
+
+bool BackgroundWriter::flush()
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  while (num_done_jobs_ < num_pushed_jobs_)
+  {
+    job_done_condition_.wait(lock);
+  }
+  const bool succeeded = !failed_;
+  failed_ = false;
+  return succeeded;
+}
+
+void BackgroundWriter::run()
+{
+  while (true)
+  {
+    Job job;
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      while (jobs_.empty() && !stop_)
+      {
+        job_pushed_condition_.wait(lock);
+      }
+      // pending jobs are always processed before stopping
+      if (jobs_.empty())
+      {
+        return;
+      }
+      job = jobs_.front();
+      jobs_.pop_front();
+    }
+
+    const bool succeeded = job();
+    if (!succeeded)
+    {
+      ROS_ERROR("Background write job failed.");
+    }
+
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      num_done_jobs_++;
+      failed_ = failed_ || !succeeded;
+    }
+    job_done_condition_.notify_all();
+  }
+}
+
+}
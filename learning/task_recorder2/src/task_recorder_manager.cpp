@@ -13,6 +13,8 @@
  *********************************************************************/
 
 // system includes
+#include <algorithm>
+#include <boost/bind.hpp>
 // #include <boost/thread.hpp>
 #include <usc_utilities/assert.h>
 #include <usc_utilities/param_server.h>
@@ -27,7 +29,7 @@ namespace task_recorder2
 {
 
 TaskRecorderManager::TaskRecorderManager(ros::NodeHandle node_handle) :
-    initialized_(false), recorder_io_(node_handle), counter_(-1)
+    initialized_(false), recorder_io_(node_handle), counter_(-1), num_post_processing_threads_(1), next_post_processing_index_(0), last_write_id_(-1)
 {
   ROS_DEBUG("Creating task recorder manager in namespace >%s<.", node_handle.getNamespace().c_str());
   ROS_VERIFY(recorder_io_.initialize(recorder_io_.node_handle_.getNamespace() + std::string("/data_samples")));
@@ -53,6 +55,16 @@ bool TaskRecorderManager::initialize()
   stop_recording_responses_.resize(task_recorders_.size());
   interrupt_recording_requests_.resize(task_recorders_.size());
   interrupt_recording_responses_.resize(task_recorders_.size());
+  stop_recording_results_.resize(task_recorders_.size(), 0);
+
+  recorder_io_.node_handle_.param("num_post_processing_threads", num_post_processing_threads_, (int)boost::thread::hardware_concurrency());
+  if(num_post_processing_threads_ < 1)
+  {
+    num_post_processing_threads_ = 1;
+  }
+  int max_num_pending_writes;
+  recorder_io_.node_handle_.param("max_num_pending_writes", max_num_pending_writes, 2);
+  ROS_VERIFY(background_writer_.initialize(max_num_pending_writes));
 
   ROS_VERIFY(usc_utilities::read(recorder_io_.node_handle_, "sampling_rate", sampling_rate_));
   ROS_ASSERT(sampling_rate_ > 0);
@@ -120,6 +132,8 @@ bool TaskRecorderManager::startRecording(task_recorder2::StartRecording::Request
                                          task_recorder2::StartRecording::Response& response)
 {
   ROS_ASSERT(initialized_);
+  // the trial counter is only incremented once pending data is written
+  ROS_VERIFY(waitForPendingWrites());
   recorder_io_.setDescription(request.description);
 
   response.start_time = ros::Time::now();
@@ -149,8 +163,22 @@ bool TaskRecorderManager::stopRecording(task_recorder2::StopRecording::Request&
     stop_recording_requests_[i] = request;
     stop_recording_requests_[i].message_names.clear();
     stop_recording_responses_[i] = response;
-    ROS_VERIFY(task_recorders_[i]->stopRecording(stop_recording_requests_[i], stop_recording_responses_[i]));
+  }
+
+  // crop, filter, and resample the recorded data of all task recorders in parallel
+  next_post_processing_index_ = 0;
+  const int num_threads = std::min(num_post_processing_threads_, (int)task_recorders_.size());
+  boost::thread_group post_processing_threads;
+  for (int i = 1; i < num_threads; ++i)
+  {
+    post_processing_threads.create_thread(boost::bind(&TaskRecorderManager::postProcess, this));
+  }
+  postProcess();
+  post_processing_threads.join_all();
 
+  for (int i = 0; i < (int)task_recorders_.size(); ++i)
+  {
+    ROS_VERIFY(stop_recording_results_[i]);
     ROS_ASSERT(stop_recording_responses_[i].return_code == task_recorder2::StopRecording::Response::SERVICE_CALL_SUCCESSFUL);
     response.info.append(stop_recording_responses_[i].info);
     ROS_DEBUG("Got >%i< messages.", (int)stop_recording_responses_[i].filtered_and_cropped_messages.size());
@@ -172,61 +200,101 @@ bool TaskRecorderManager::stopRecording(task_recorder2::StopRecording::Request&
                               stop_recording_responses_[i].filtered_and_cropped_messages[0].names.end());
   }
 
-  // accumulate all data samples
-  recorder_io_.messages_.clear();
-
+  // accumulate all data samples, the names are only stored once
+  recorder_io_.data_samples_.setNames(all_variable_names);
+  recorder_io_.data_samples_.reserve(num_messages);
+  std::vector<double> data;
+  data.reserve(all_variable_names.size());
   for (int j = 0; j < num_messages; ++j)
   {
-    task_recorder2_msgs::DataSample data_sample;
-    data_sample.header.seq = j;
-    data_sample.header.stamp = stop_recording_responses_[0].filtered_and_cropped_messages[j].header.stamp;
-    data_sample.names = all_variable_names;
+    data.clear();
     for (int i = 0; i < (int)task_recorders_.size(); ++i)
     {
-      data_sample.data.insert(data_sample.data.end(),
-                              stop_recording_responses_[i].filtered_and_cropped_messages[j].data.begin(),
-                              stop_recording_responses_[i].filtered_and_cropped_messages[j].data.end());
+      data.insert(data.end(),
+                  stop_recording_responses_[i].filtered_and_cropped_messages[j].data.begin(),
+                  stop_recording_responses_[i].filtered_and_cropped_messages[j].data.end());
     }
-    recorder_io_.messages_.push_back(data_sample);
+    ROS_VERIFY(recorder_io_.data_samples_.add(stop_recording_responses_[0].filtered_and_cropped_messages[j].header.stamp, data, j));
   }
 
   // if requested names is empty... return all...
   if(request.message_names.empty())
   {
     // extract all data samples
-    ROS_VERIFY(task_recorder2_utilities::extractDataSamples(recorder_io_.messages_, all_variable_names, response.filtered_and_cropped_messages));
+    ROS_VERIFY(recorder_io_.data_samples_.getMessages(response.filtered_and_cropped_messages));
   }
   else
   {
     // ...else extract data samples according to request
-    ROS_VERIFY(task_recorder2_utilities::extractDataSamples(recorder_io_.messages_, request.message_names, response.filtered_and_cropped_messages));
+    ROS_VERIFY(recorder_io_.data_samples_.getMessages(request.message_names, response.filtered_and_cropped_messages));
   }
 
   // response.description = stop_recording_responses_[0].description;
   response.description = recorder_io_.getDescription();
   response.return_code = task_recorder2::StopRecording::Response::SERVICE_CALL_SUCCESSFUL;
 
-  // write resampled data to file
-  if(recorder_io_.write_out_resampled_data_)
-  {
-    // boost::thread(boost::bind(&task_recorder2_utilities::TaskRecorderIO<task_recorder2_msgs::DataSample>::writeRecordedDataSamples, recorder_io_));
-    ROS_VERIFY(recorder_io_.writeRecordedDataSamples());
-  }
-  if(recorder_io_.write_out_clmc_data_)
-  {
-    ROS_VERIFY(recorder_io_.writeRecordedDataToCLMCFile());
-  }
-
-  // publish notification
+  // write data to file in the background, the notification is published once the data is written
   task_recorder2_msgs::Notification notification;
   notification.description = response.description;
   notification.start = request.crop_start_time;
   notification.end = request.crop_end_time;
-  stop_recording_publisher_.publish(notification);
+  boost::shared_ptr<TaskRecorderIO<task_recorder2_msgs::DataSample> > recorder_io(new TaskRecorderIO<task_recorder2_msgs::DataSample>(recorder_io_));
+  last_write_id_ = background_writer_.push(boost::bind(&TaskRecorderManager::writeRecordedData, this, recorder_io, notification));
+
+  return true;
+}
+
+void TaskRecorderManager::postProcess()
+{
+  while (true)
+  {
+    post_processing_mutex_.lock();
+    const int i = next_post_processing_index_++;
+    post_processing_mutex_.unlock();
+    if (i >= (int)task_recorders_.size())
+    {
+      return;
+    }
+    stop_recording_results_[i] = task_recorders_[i]->stopRecording(stop_recording_requests_[i], stop_recording_responses_[i]);
+  }
+}
 
+bool TaskRecorderManager::writeRecordedData(boost::shared_ptr<TaskRecorderIO<task_recorder2_msgs::DataSample> > recorder_io,
+                                            const task_recorder2_msgs::Notification notification)
+{
+  if(recorder_io->write_out_resampled_data_)
+  {
+    if(!recorder_io->writeRecordedDataSamples())
+    {
+      return false;
+    }
+  }
+  if(recorder_io->write_out_clmc_data_)
+  {
+    if(!recorder_io->writeRecordedDataToCLMCFile())
+    {
+      return false;
+    }
+  }
+  stop_recording_publisher_.publish(notification);
   return true;
 }
 
+bool TaskRecorderManager::isWritten(const int write_id)
+{
+  return background_writer_.isDone(write_id);
+}
+
+int TaskRecorderManager::getNumPendingWrites()
+{
+  return background_writer_.getNumPendingJobs();
+}
+
+bool TaskRecorderManager::waitForPendingWrites()
+{
+  return background_writer_.flush();
+}
+
 bool TaskRecorderManager::interruptRecording(task_recorder2::InterruptRecording::Request& request,
                                              task_recorder2::InterruptRecording::Response& response)
 {
@@ -353,8 +421,9 @@ bool TaskRecorderManager::addDataSamples(task_recorder2::AddDataSamples::Request
   }
   ROS_VERIFY_MSG(!request.data_samples.empty(), "No data samples provided to add.");
 
+  ROS_VERIFY(waitForPendingWrites());
   recorder_io_.setDescription(request.description);
-  recorder_io_.messages_ = request.data_samples;
+  ROS_VERIFY(recorder_io_.data_samples_.set(request.data_samples));
   ROS_VERIFY(recorder_io_.writeRecordedDataSamples());
 
   response.return_code = task_recorder2::AddDataSamples::Response::SERVICE_CALL_SUCCESSFUL;
@@ -373,6 +442,7 @@ bool TaskRecorderManager::readDataSamples(task_recorder2::ReadDataSamples::Reque
                                           task_recorder2::ReadDataSamples::Response& response)
 {
   ROS_ASSERT(initialized_);
+  ROS_VERIFY(waitForPendingWrites());
   if(!recorder_io_.readDataSamples(request.description, response.data_samples))
   {
     response.return_code = task_recorder2::ReadDataSamples::Response::SERVICE_CALL_FAILED;
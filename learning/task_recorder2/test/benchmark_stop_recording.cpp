@@ -0,0 +1,218 @@
+/*********************************************************************
+ Computational Learning and Motor Control Lab
+ University of Southern California
+ Prof. Stefan Schaal
+ *********************************************************************
+ \remarks   Measures the latency of TaskRecorderManager::stopRecording against the number of task recorders.
+            Requires a running roscore, the recorded data is written into a temporary directory.
+
+ \file    benchmark_stop_recording.cpp
+
+ \date    Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <ros/ros.h>
+
+#include <usc_utilities/assert.h>
+
+#include <task_recorder2_msgs/DataSample.h>
+
+// local includes
+#include <task_recorder2/task_recorder.h>
+#include <task_recorder2/task_recorder_manager.h>
+
+static const int NUM_SIGNALS = 20;
+static const double RECORDING_DURATION = 10.0;
+static const double RECORDING_RATE = 300.0;
+static const int NUM_SAMPLES = 1000;
+static const int NUM_REPETITIONS = 5;
+
+/*! Task recorder that is filled with synthetic data instead of subscribing to a topic. Stopping the recording
+ * runs the post processing (crop, remove duplicates, resample) of TaskRecorder.
+ */
+class BenchmarkTaskRecorder : public task_recorder2::TaskRecorder<task_recorder2_msgs::DataSample>
+{
+
+public:
+
+  BenchmarkTaskRecorder(ros::NodeHandle node_handle, const int id) :
+    task_recorder2::TaskRecorder<task_recorder2_msgs::DataSample>(node_handle)
+  {
+    for (int i = 0; i < NUM_SIGNALS; ++i)
+    {
+      std::stringstream ss;
+      ss << "recorder_" << id << "_signal_" << i;
+      names_.push_back(ss.str());
+    }
+  };
+  virtual ~BenchmarkTaskRecorder() {};
+
+  bool transformMsg(const task_recorder2_msgs::DataSample& message, task_recorder2_msgs::DataSample& data_sample)
+  {
+    data_sample = message;
+    return true;
+  }
+  int getNumSignals() const
+  {
+    return NUM_SIGNALS;
+  }
+  std::vector<std::string> getNames() const
+  {
+    return names_;
+  }
+
+  bool startRecording(task_recorder2::StartRecording::Request& request, task_recorder2::StartRecording::Response& response)
+  {
+    // "record" RECORDING_DURATION seconds of data that ends now
+    recorder_io_.setResampledDescription(request.description);
+    const int num_recorded_samples = static_cast<int> (RECORDING_DURATION * RECORDING_RATE);
+    const ros::Time start_time = ros::Time::now() - ros::Duration(RECORDING_DURATION);
+    recorder_io_.data_samples_.setNames(names_);
+    recorder_io_.data_samples_.reserve(num_recorded_samples);
+    std::vector<double> data(NUM_SIGNALS);
+    for (int j = 0; j < num_recorded_samples; ++j)
+    {
+      const double t = static_cast<double> (j) / RECORDING_RATE;
+      for (int i = 0; i < NUM_SIGNALS; ++i)
+      {
+        data[i] = std::sin(static_cast<double> (i + 1) * t) + 0.01 * (static_cast<double> (rand()) / static_cast<double> (RAND_MAX));
+      }
+      ROS_VERIFY(recorder_io_.data_samples_.add(start_time + ros::Duration(t), data, j));
+    }
+    response.start_time = start_time;
+    response.return_code = task_recorder2::StartRecording::Response::SERVICE_CALL_SUCCESSFUL;
+    return true;
+  }
+
+private:
+
+  std::vector<std::string> names_;
+
+};
+
+class BenchmarkTaskRecorderManager : public task_recorder2::TaskRecorderManager
+{
+
+public:
+
+  BenchmarkTaskRecorderManager(ros::NodeHandle node_handle, const int num_recorders) :
+    task_recorder2::TaskRecorderManager(node_handle), num_recorders_(num_recorders) {};
+  virtual ~BenchmarkTaskRecorderManager() {};
+
+  bool read(std::vector<boost::shared_ptr<task_recorder2::TaskRecorderBase> >& task_recorders)
+  {
+    // the recorders only post process, the data is written by the task recorder manager
+    ros::NodeHandle recorder_node_handle(recorder_io_.node_handle_, "recorders");
+    task_recorders.clear();
+    for (int i = 0; i < num_recorders_; ++i)
+    {
+      boost::shared_ptr<BenchmarkTaskRecorder> task_recorder(new BenchmarkTaskRecorder(recorder_node_handle, i));
+      std::stringstream ss;
+      ss << "/benchmark_topic_" << i;
+      ROS_VERIFY(task_recorder->initialize(ss.str()));
+      task_recorders.push_back(task_recorder);
+    }
+    return true;
+  }
+
+private:
+
+  int num_recorders_;
+
+};
+
+/*! Returns the mean latency of stopRecording and the mean time until the data is written (both in ms)
+ */
+void runBenchmark(ros::NodeHandle node_handle,
+                  const int num_recorders,
+                  const int num_threads,
+                  double& stop_recording_latency,
+                  double& write_latency)
+{
+  node_handle.setParam("num_post_processing_threads", num_threads);
+  BenchmarkTaskRecorderManager task_recorder_manager(node_handle, num_recorders);
+  ROS_VERIFY(task_recorder_manager.initialize());
+
+  stop_recording_latency = 0.0;
+  write_latency = 0.0;
+  for (int r = 0; r < NUM_REPETITIONS; ++r)
+  {
+    task_recorder2::StartRecording::Request start_request;
+    start_request.description.description.assign("benchmark");
+    start_request.description.id = r;
+    task_recorder2::StartRecording::Response start_response;
+    ROS_VERIFY(task_recorder_manager.startRecording(start_request, start_response));
+
+    task_recorder2::StopRecording::Request stop_request;
+    // the synthetic recordings end right before the returned start time
+    stop_request.crop_end_time = start_response.start_time - ros::Duration(1.0);
+    stop_request.crop_start_time = stop_request.crop_end_time - ros::Duration(RECORDING_DURATION - 2.0);
+    stop_request.num_samples = NUM_SAMPLES;
+    task_recorder2::StopRecording::Response stop_response;
+
+    ros::WallTime start = ros::WallTime::now();
+    ROS_VERIFY(task_recorder_manager.stopRecording(stop_request, stop_response));
+    stop_recording_latency += (ros::WallTime::now() - start).toSec();
+    ROS_VERIFY(task_recorder_manager.waitForPendingWrites());
+    write_latency += (ros::WallTime::now() - start).toSec();
+    ROS_ASSERT((int)stop_response.filtered_and_cropped_messages.size() == NUM_SAMPLES);
+  }
+  stop_recording_latency *= 1e3 / static_cast<double> (NUM_REPETITIONS);
+  write_latency *= 1e3 / static_cast<double> (NUM_REPETITIONS);
+}
+
+int main(int argc, char** argv)
+{
+  ros::init(argc, argv, "BenchmarkStopRecording");
+  ros::NodeHandle node_handle("~");
+
+  int max_num_recorders = 16;
+  if (argc > 1)
+  {
+    max_num_recorders = atoi(argv[1]);
+  }
+
+  // data is written into a single bag file in a temporary directory that is overwritten and removed at the end
+  char data_directory_path[] = "/tmp/benchmark_stop_recording_XXXXXX";
+  if (mkdtemp(data_directory_path) == NULL)
+  {
+    ROS_ERROR("Could not create temporary data directory.");
+    return -1;
+  }
+  node_handle.setParam("sampling_rate", 10.0);
+  node_handle.setParam("create_directories", false);
+  node_handle.setParam("write_out_resampled_data", true);
+  node_handle.setParam("write_out_raw_data", false);
+  node_handle.setParam("write_out_clmc_data", false);
+  node_handle.setParam("write_out_statistics", false);
+  node_handle.setParam("recorder_data_directory_path", std::string(data_directory_path));
+  node_handle.setParam("recorders/create_directories", false);
+  node_handle.setParam("recorders/write_out_resampled_data", false);
+  node_handle.setParam("recorders/write_out_raw_data", false);
+  node_handle.setParam("recorders/write_out_clmc_data", false);
+  node_handle.setParam("recorders/write_out_statistics", false);
+  node_handle.setParam("recorders/recorder_data_directory_path", std::string(data_directory_path));
+
+  const int max_num_threads = std::max(1, (int)boost::thread::hardware_concurrency());
+  printf("%10s %14s %14s %14s %14s\n", "recorders", "stop 1 (ms)", "written 1 (ms)", "stop N (ms)", "written N (ms)");
+  for (int num_recorders = 1; num_recorders <= max_num_recorders; num_recorders *= 2)
+  {
+    double sequential_stop_latency, sequential_write_latency;
+    runBenchmark(node_handle, num_recorders, 1, sequential_stop_latency, sequential_write_latency);
+    double parallel_stop_latency, parallel_write_latency;
+    runBenchmark(node_handle, num_recorders, max_num_threads, parallel_stop_latency, parallel_write_latency);
+    printf("%10i %14.2f %14.2f %14.2f %14.2f\n", num_recorders,
+           sequential_stop_latency, sequential_write_latency, parallel_stop_latency, parallel_write_latency);
+  }
+  printf("N = %i post processing threads\n", max_num_threads);
+
+  boost::filesystem::remove_all(boost::filesystem::path(data_directory_path));
+  return 0;
+}
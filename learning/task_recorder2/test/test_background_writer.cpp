@@ -0,0 +1,245 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks		...
+
+  \file		test_background_writer.cpp
+
+  \date		Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <gtest/gtest.h>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+// local includes
+#include <task_recorder2/background_writer.h>
+
+using namespace task_recorder2;
+
+/*! Blocks the jobs that wait on it until it is opened
+ */
+class Gate
+{
+
+public:
+
+  Gate() :
+    open_(false) {};
+
+  void open()
+  {
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      open_ = true;
+    }
+    condition_.notify_all();
+  }
+
+  void wait()
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    while (!open_)
+    {
+      condition_.wait(lock);
+    }
+  }
+
+private:
+
+  bool open_;
+  boost::mutex mutex_;
+  boost::condition_variable condition_;
+
+};
+
+/*! Records the ids of the jobs in the order in which they are processed
+ */
+class JobLog
+{
+
+public:
+
+  bool add(const int id,
+           const bool succeed)
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    ids_.push_back(id);
+    return succeed;
+  }
+
+  bool addAfter(Gate* gate,
+                const int id)
+  {
+    gate->wait();
+    return add(id, true);
+  }
+
+  bool addDelayed(const int id)
+  {
+    boost::this_thread::sleep(boost::posix_time::milliseconds(5));
+    return add(id, true);
+  }
+
+  std::vector<int> getIds()
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    return ids_;
+  }
+
+private:
+
+  boost::mutex mutex_;
+  std::vector<int> ids_;
+
+};
+
+/*! Flag that is set by one thread and read by another
+ */
+class Flag
+{
+
+public:
+
+  Flag() :
+    set_(false) {};
+
+  void set()
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    set_ = true;
+  }
+
+  bool isSet()
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    return set_;
+  }
+
+private:
+
+  bool set_;
+  boost::mutex mutex_;
+
+};
+
+void push(BackgroundWriter* background_writer,
+          const BackgroundWriter::Job job,
+          Flag* pushed)
+{
+  background_writer->push(job);
+  pushed->set();
+}
+
+TEST(TestBackgroundWriter, TestInitialize)
+{
+  BackgroundWriter background_writer;
+  EXPECT_FALSE(background_writer.initialize(0));
+  EXPECT_TRUE(background_writer.initialize(1));
+  EXPECT_FALSE(background_writer.initialize(1));
+}
+
+TEST(TestBackgroundWriter, TestInOrderCompletion)
+{
+  JobLog job_log;
+  BackgroundWriter background_writer;
+  ASSERT_TRUE(background_writer.initialize(3));
+  const int num_jobs = 50;
+  for (int i = 0; i < num_jobs; ++i)
+  {
+    EXPECT_EQ(i, background_writer.push(boost::bind(&JobLog::addDelayed, &job_log, i)));
+  }
+  EXPECT_TRUE(background_writer.flush());
+  EXPECT_EQ(0, background_writer.getNumPendingJobs());
+
+  std::vector<int> ids = job_log.getIds();
+  ASSERT_EQ(num_jobs, static_cast<int> (ids.size()));
+  for (int i = 0; i < num_jobs; ++i)
+  {
+    EXPECT_EQ(i, ids[i]);
+    EXPECT_TRUE(background_writer.isDone(i));
+  }
+  EXPECT_FALSE(background_writer.isDone(num_jobs));
+}
+
+TEST(TestBackgroundWriter, TestBackpressure)
+{
+  Gate gate;
+  JobLog job_log;
+  BackgroundWriter background_writer;
+  ASSERT_TRUE(background_writer.initialize(2));
+  EXPECT_EQ(0, background_writer.push(boost::bind(&JobLog::addAfter, &job_log, &gate, 0)));
+  EXPECT_EQ(1, background_writer.push(boost::bind(&JobLog::addAfter, &job_log, &gate, 1)));
+  EXPECT_EQ(2, background_writer.getNumPendingJobs());
+
+  // the third job needs to wait until one of the pending jobs is done
+  Flag pushed;
+  boost::thread push_thread(boost::bind(&push, &background_writer, BackgroundWriter::Job(boost::bind(&JobLog::add, &job_log, 2, true)), &pushed));
+  boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+  EXPECT_FALSE(pushed.isSet());
+  EXPECT_EQ(2, background_writer.getNumPendingJobs());
+  EXPECT_FALSE(background_writer.isDone(0));
+  EXPECT_FALSE(background_writer.isDone(1));
+  EXPECT_TRUE(job_log.getIds().empty());
+
+  gate.open();
+  push_thread.join();
+  EXPECT_TRUE(pushed.isSet());
+  EXPECT_TRUE(background_writer.flush());
+  EXPECT_TRUE(background_writer.isDone(2));
+  EXPECT_EQ(3, static_cast<int> (job_log.getIds().size()));
+}
+
+TEST(TestBackgroundWriter, TestFlushFailure)
+{
+  JobLog job_log;
+  BackgroundWriter background_writer;
+  ASSERT_TRUE(background_writer.initialize(2));
+  background_writer.push(boost::bind(&JobLog::add, &job_log, 0, true));
+  background_writer.push(boost::bind(&JobLog::add, &job_log, 1, false));
+  background_writer.push(boost::bind(&JobLog::add, &job_log, 2, true));
+  EXPECT_FALSE(background_writer.flush());
+  // the failed job is processed (and reported) only once, the jobs after it are processed as well
+  EXPECT_EQ(3, static_cast<int> (job_log.getIds().size()));
+  EXPECT_TRUE(background_writer.flush());
+
+  background_writer.push(boost::bind(&JobLog::add, &job_log, 3, true));
+  EXPECT_TRUE(background_writer.flush());
+  background_writer.push(boost::bind(&JobLog::add, &job_log, 4, false));
+  EXPECT_FALSE(background_writer.flush());
+  EXPECT_TRUE(background_writer.flush());
+}
+
+TEST(TestBackgroundWriter, TestDrainOnDestruction)
+{
+  JobLog job_log;
+  const int num_jobs = 10;
+  {
+    BackgroundWriter background_writer;
+    ASSERT_TRUE(background_writer.initialize(num_jobs));
+    for (int i = 0; i < num_jobs; ++i)
+    {
+      background_writer.push(boost::bind(&JobLog::addDelayed, &job_log, i));
+    }
+    EXPECT_LT(static_cast<int> (job_log.getIds().size()), num_jobs);
+  }
+  std::vector<int> ids = job_log.getIds();
+  ASSERT_EQ(num_jobs, static_cast<int> (ids.size()));
+  for (int i = 0; i < num_jobs; ++i)
+  {
+    EXPECT_EQ(i, ids[i]);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,225 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks		...
+
+  \file		data_sample_buffer.h
+
+  \date		Oct 17, 2026
+
+ *********************************************************************/
+
+#ifndef DATA_SAMPLE_BUFFER_H_
+#define DATA_SAMPLE_BUFFER_H_
+
+// system includes
+#include <string>
+#include <vector>
+#include <ros/ros.h>
+#include <Eigen/Core>
+
+// local includes
+#include <task_recorder2_msgs/DataSample.h>
+
+namespace task_recorder2_utilities
+{
+
+/*! Columnar storage for recorded data samples. All samples share a single names header, the data of
+ * all samples is kept in one contiguous row-major block (one row per sample). Samples are only converted
+ * into task_recorder2_msgs::DataSample messages on request, e.g. when publishing or writing to file.
+ */
+class DataSampleBuffer
+{
+
+public:
+
+  /*! Constructor
+   */
+  DataSampleBuffer() :
+    num_signals_(0), num_reserved_samples_(0) {};
+  /*! Destructor
+   */
+  virtual ~DataSampleBuffer() {};
+
+  /*! Sets the names header and removes all samples
+   * @param names
+   * @param frame_id
+   */
+  void setNames(const std::vector<std::string>& names,
+                const std::string& frame_id = std::string(""));
+
+  /*! Removes all samples, the names header is kept
+   */
+  void clear();
+
+  /*!
+   * @param num_samples
+   */
+  void reserve(const int num_samples);
+
+  /*! Appends the data sample. The first data sample added to an empty buffer sets the names header.
+   * @param data_sample
+   * @return True on success, otherwise False
+   */
+  bool add(const task_recorder2_msgs::DataSample& data_sample);
+
+  /*! Appends a sample that corresponds to the names header
+   * @param stamp
+   * @param data
+   * @param seq
+   * @return True on success, otherwise False
+   */
+  bool add(const ros::Time& stamp,
+           const std::vector<double>& data,
+           const unsigned int seq = 0);
+
+  /*! Replaces the content of the buffer with the provided data samples
+   * @param data_samples
+   * @return True on success, otherwise False
+   */
+  bool set(const std::vector<task_recorder2_msgs::DataSample>& data_samples);
+
+  /*! Replaces the content of the buffer with the provided matrix (one row per sample)
+   * @param names
+   * @param stamps
+   * @param data
+   * @param frame_id
+   * @return True on success, otherwise False
+   */
+  bool set(const std::vector<std::string>& names,
+           const std::vector<ros::Time>& stamps,
+           const Eigen::MatrixXd& data,
+           const std::string& frame_id = std::string(""));
+
+  /*!
+   * @return Number of samples
+   */
+  int size() const
+  {
+    return static_cast<int> (stamps_.size());
+  }
+  /*!
+   * @return True if no sample is contained, otherwise False
+   */
+  bool empty() const
+  {
+    return stamps_.empty();
+  }
+  /*!
+   * @return Number of signals of each sample
+   */
+  int getNumSignals() const
+  {
+    return num_signals_;
+  }
+  /*!
+   * @return
+   */
+  const std::vector<std::string>& getNames() const
+  {
+    return names_;
+  }
+  /*!
+   * @return
+   */
+  const std::string& getFrameId() const
+  {
+    return frame_id_;
+  }
+  /*!
+   * @param index
+   * @return
+   */
+  const ros::Time& getStamp(const int index) const
+  {
+    ROS_ASSERT(index >= 0 && index < size());
+    return stamps_[index];
+  }
+  /*!
+   * @return
+   */
+  const ros::Time& getLastStamp() const
+  {
+    ROS_ASSERT(!empty());
+    return stamps_.back();
+  }
+  /*! Returns a pointer to the getNumSignals() values of sample index
+   * @param index
+   * @return
+   */
+  const double* getData(const int index) const
+  {
+    ROS_ASSERT(index >= 0 && index < size());
+    return &data_[index * num_signals_];
+  }
+
+  /*! Removes all samples before start_time (except the last one before start_time) and after end_time
+   * @param start_time
+   * @param end_time
+   * @return True on success, otherwise False
+   */
+  bool crop(const ros::Time& start_time,
+            const ros::Time& end_time);
+
+  /*! Removes samples with invalid time stamps and samples whose time stamp does not increase
+   * @return True on success, otherwise False
+   */
+  bool removeDuplicates();
+
+  /*! Copies the signals at the provided indices into a matrix (one row per sample, one column per index)
+   * @param indices
+   * @param data
+   * @return True on success, otherwise False
+   */
+  bool getData(const std::vector<int>& indices,
+               Eigen::MatrixXd& data) const;
+
+  /*!
+   * @param index
+   * @param data_sample
+   * @param set_names If False, the names of data_sample are left untouched
+   * @return True on success, otherwise False
+   */
+  bool getMessage(const int index,
+                  task_recorder2_msgs::DataSample& data_sample,
+                  const bool set_names = true) const;
+
+  /*!
+   * @param data_samples
+   * @return True on success, otherwise False
+   */
+  bool getMessages(std::vector<task_recorder2_msgs::DataSample>& data_samples) const;
+
+  /*!
+   * @param names Subset of the names header that are extracted
+   * @param data_samples
+   * @return True on success, otherwise False
+   */
+  bool getMessages(const std::vector<std::string>& names,
+                   std::vector<task_recorder2_msgs::DataSample>& data_samples) const;
+
+private:
+
+  std::vector<std::string> names_;
+  std::string frame_id_;
+  int num_signals_;
+  int num_reserved_samples_;
+
+  std::vector<ros::Time> stamps_;
+  std::vector<unsigned int> seqs_;
+  std::vector<double> data_;
+
+  /*! Removes samples [begin, end)
+   * @param begin
+   * @param end
+   */
+  void erase(const int begin,
+             const int end);
+
+};
+
+}
+
+#endif /* DATA_SAMPLE_BUFFER_H_ */
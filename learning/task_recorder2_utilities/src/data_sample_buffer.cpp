@@ -0,0 +1,296 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks		...
+
+  \file		data_sample_buffer.cpp
+
+  \date		Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <algorithm>
+
+// local includes
+#include <task_recorder2_utilities/data_sample_buffer.h>
+#include <task_recorder2_utilities/data_sample_utilities.h>
+
+namespace task_recorder2_utilities
+{
+
+void DataSampleBuffer::setNames(const std::vector<std::string>& names,
+                                const std::string& frame_id)
+{
+  names_ = names;
+  frame_id_ = frame_id;
+  num_signals_ = static_cast<int> (names_.size());
+  clear();
+  data_.reserve(num_reserved_samples_ * num_signals_);
+}
+
+void DataSampleBuffer::clear()
+{
+  stamps_.clear();
+  seqs_.clear();
+  data_.clear();
+}
+
+void DataSampleBuffer::reserve(const int num_samples)
+{
+  num_reserved_samples_ = num_samples;
+  stamps_.reserve(num_samples);
+  seqs_.reserve(num_samples);
+  data_.reserve(num_samples * num_signals_);
+}
+
+bool DataSampleBuffer::add(const task_recorder2_msgs::DataSample& data_sample)
+{
+  if (empty())
+  {
+    if (data_sample.names.size() != data_sample.data.size())
+    {
+      ROS_ERROR("Data sample contains >%i< names and >%i< values.", (int)data_sample.names.size(), (int)data_sample.data.size());
+      return false;
+    }
+    setNames(data_sample.names, data_sample.header.frame_id);
+  }
+  return add(data_sample.header.stamp, data_sample.data, data_sample.header.seq);
+}
+
+bool DataSampleBuffer::add(const ros::Time& stamp,
+                           const std::vector<double>& data,
+                           const unsigned int seq)
+{
+  if (static_cast<int> (data.size()) != num_signals_)
+  {
+    ROS_ERROR("Size of data vector >%i< needs to be >%i<.", (int)data.size(), num_signals_);
+    return false;
+  }
+  stamps_.push_back(stamp);
+  seqs_.push_back(seq);
+  data_.insert(data_.end(), data.begin(), data.end());
+  return true;
+}
+
+bool DataSampleBuffer::set(const std::vector<task_recorder2_msgs::DataSample>& data_samples)
+{
+  if (data_samples.empty())
+  {
+    ROS_ERROR("No data samples provided.");
+    return false;
+  }
+  setNames(data_samples[0].names, data_samples[0].header.frame_id);
+  reserve(static_cast<int> (data_samples.size()));
+  for (int i = 0; i < static_cast<int> (data_samples.size()); ++i)
+  {
+    if (!add(data_samples[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DataSampleBuffer::set(const std::vector<std::string>& names,
+                           const std::vector<ros::Time>& stamps,
+                           const Eigen::MatrixXd& data,
+                           const std::string& frame_id)
+{
+  if (static_cast<int> (data.rows()) != static_cast<int> (stamps.size()) || static_cast<int> (data.cols()) != static_cast<int> (names.size()))
+  {
+    ROS_ERROR("Data matrix of size >%i<x>%i< does not match >%i< time stamps and >%i< names.",
+              (int)data.rows(), (int)data.cols(), (int)stamps.size(), (int)names.size());
+    return false;
+  }
+  setNames(names, frame_id);
+  const int num_samples = static_cast<int> (stamps.size());
+  stamps_ = stamps;
+  seqs_.resize(num_samples);
+  data_.resize(num_samples * num_signals_);
+  for (int j = 0; j < num_samples; ++j)
+  {
+    seqs_[j] = j;
+    for (int i = 0; i < num_signals_; ++i)
+    {
+      data_[j * num_signals_ + i] = data(j, i);
+    }
+  }
+  return true;
+}
+
+void DataSampleBuffer::erase(const int begin,
+                             const int end)
+{
+  stamps_.erase(stamps_.begin() + begin, stamps_.begin() + end);
+  seqs_.erase(seqs_.begin() + begin, seqs_.begin() + end);
+  data_.erase(data_.begin() + begin * num_signals_, data_.begin() + end * num_signals_);
+}
+
+bool DataSampleBuffer::crop(const ros::Time& start_time,
+                            const ros::Time& end_time)
+{
+  // remove samples before start_time
+  int initial_index = 0;
+  bool found_limit = false;
+  for (int i = 0; i < size() && !found_limit; i++)
+  {
+    if (stamps_[i] < start_time)
+    {
+      initial_index = i;
+    }
+    else
+    {
+      found_limit = true;
+    }
+  }
+  ROS_ASSERT_MSG(found_limit, "Looks like the start and end time are not contained in the messages. Check the requested times.");
+  erase(0, initial_index);
+
+  // remove samples after end_time
+  int final_index = size();
+  found_limit = false;
+  for (int i = size() - 1; i >= 0 && !found_limit; --i)
+  {
+    if (stamps_[i] > end_time)
+    {
+      final_index = i;
+    }
+    else
+    {
+      found_limit = true;
+    }
+  }
+  ROS_ASSERT(found_limit);
+  erase(final_index, size());
+  return true;
+}
+
+bool DataSampleBuffer::removeDuplicates()
+{
+  if (empty())
+  {
+    return true;
+  }
+  // compact in a single pass, each sample is compared to its original predecessor which is
+  // never overwritten before it has been compared
+  int num_kept = 0;
+  for (int i = 0; i < size(); ++i)
+  {
+    bool keep = true;
+    if (i == 0)
+    {
+      if (stamps_[i] < ros::TIME_MIN)
+      {
+        ROS_WARN("Found message (0) with invalid stamp.");
+        keep = false;
+      }
+    }
+    else if (stamps_[i].toSec() - stamps_[i - 1].toSec() < 1e-6 || stamps_[i] < ros::TIME_MIN)
+    {
+      keep = false;
+    }
+    if (keep)
+    {
+      if (num_kept != i)
+      {
+        stamps_[num_kept] = stamps_[i];
+        seqs_[num_kept] = seqs_[i];
+        std::copy(data_.begin() + i * num_signals_, data_.begin() + (i + 1) * num_signals_, data_.begin() + num_kept * num_signals_);
+      }
+      num_kept++;
+    }
+  }
+  stamps_.resize(num_kept);
+  seqs_.resize(num_kept);
+  data_.resize(num_kept * num_signals_);
+  return true;
+}
+
+bool DataSampleBuffer::getData(const std::vector<int>& indices,
+                               Eigen::MatrixXd& data) const
+{
+  const int num_samples = size();
+  const int num_vars = static_cast<int> (indices.size());
+  for (int i = 0; i < num_vars; ++i)
+  {
+    if (indices[i] < 0 || indices[i] >= num_signals_)
+    {
+      ROS_ERROR("Index >%i< is out of bounds, there are only >%i< signals.", indices[i], num_signals_);
+      return false;
+    }
+  }
+  data.resize(num_samples, num_vars);
+  for (int j = 0; j < num_samples; ++j)
+  {
+    const double* row = &data_[j * num_signals_];
+    for (int i = 0; i < num_vars; ++i)
+    {
+      data(j, i) = row[indices[i]];
+    }
+  }
+  return true;
+}
+
+bool DataSampleBuffer::getMessage(const int index,
+                                  task_recorder2_msgs::DataSample& data_sample,
+                                  const bool set_names) const
+{
+  if (index < 0 || index >= size())
+  {
+    ROS_ERROR("Index >%i< is out of bounds, there are only >%i< samples.", index, size());
+    return false;
+  }
+  data_sample.header.seq = seqs_[index];
+  data_sample.header.stamp = stamps_[index];
+  data_sample.header.frame_id = frame_id_;
+  if (set_names)
+  {
+    data_sample.names = names_;
+  }
+  data_sample.data.assign(data_.begin() + index * num_signals_, data_.begin() + (index + 1) * num_signals_);
+  return true;
+}
+
+bool DataSampleBuffer::getMessages(std::vector<task_recorder2_msgs::DataSample>& data_samples) const
+{
+  data_samples.resize(size());
+  for (int j = 0; j < size(); ++j)
+  {
+    if (!getMessage(j, data_samples[j]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DataSampleBuffer::getMessages(const std::vector<std::string>& names,
+                                   std::vector<task_recorder2_msgs::DataSample>& data_samples) const
+{
+  std::vector<int> indices;
+  if (!getIndices(names_, names, indices))
+  {
+    return false;
+  }
+  const int num_vars = static_cast<int> (indices.size());
+  data_samples.resize(size());
+  for (int j = 0; j < size(); ++j)
+  {
+    data_samples[j].header.seq = seqs_[j];
+    data_samples[j].header.stamp = stamps_[j];
+    data_samples[j].header.frame_id = frame_id_;
+    data_samples[j].names = names;
+    data_samples[j].data.resize(num_vars);
+    const double* row = &data_[j * num_signals_];
+    for (int i = 0; i < num_vars; ++i)
+    {
+      data_samples[j].data[i] = row[indices[i]];
+    }
+  }
+  return true;
+}
+
+}
@@ -0,0 +1,273 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks		...
+
+  \file		test_data_sample_buffer.cpp
+
+  \date		Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <gtest/gtest.h>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+// local includes
+#include <task_recorder2_utilities/data_sample_buffer.h>
+#include <task_recorder2_utilities/task_recorder_utilities.h>
+
+using namespace task_recorder2_utilities;
+
+typedef task_recorder2_msgs::DataSample DataSample;
+
+const int NUM_SIGNALS = 3;
+
+std::vector<std::string> getNames(const std::string& prefix,
+                                  const int num_signals)
+{
+  std::vector<std::string> names;
+  for (int i = 0; i < num_signals; ++i)
+  {
+    names.push_back(prefix + std::string(1, 'a' + i));
+  }
+  return names;
+}
+
+std::vector<DataSample> getDataSamples(const std::vector<ros::Time>& stamps)
+{
+  std::vector<DataSample> data_samples(stamps.size());
+  for (int j = 0; j < static_cast<int> (stamps.size()); ++j)
+  {
+    data_samples[j].header.seq = j;
+    data_samples[j].header.stamp = stamps[j];
+    data_samples[j].header.frame_id = "frame";
+    data_samples[j].names = getNames("signal_", NUM_SIGNALS);
+    for (int i = 0; i < NUM_SIGNALS; ++i)
+    {
+      data_samples[j].data.push_back(static_cast<double> (rand()) / RAND_MAX);
+    }
+  }
+  return data_samples;
+}
+
+/*! Time stamps at 0.1, 0.2, ... that contain invalid (zero) stamps, repeated stamps and stamps that go back in time
+ */
+std::vector<ros::Time> getRandomStamps(const int num_samples)
+{
+  std::vector<ros::Time> stamps;
+  for (int j = 0; j < num_samples; ++j)
+  {
+    const int r = rand() % 10;
+    if (r == 0)
+    {
+      stamps.push_back(ros::Time(0.0));
+    }
+    else if (r == 1 && !stamps.empty())
+    {
+      stamps.push_back(stamps.back());
+    }
+    else if (r == 2 && j > 1)
+    {
+      stamps.push_back(ros::Time(0.1 * (j - 1)));
+    }
+    else
+    {
+      stamps.push_back(ros::Time(0.1 * (j + 1)));
+    }
+  }
+  return stamps;
+}
+
+void expectEqual(const std::vector<DataSample>& expected,
+                 const DataSampleBuffer& buffer)
+{
+  std::vector<DataSample> data_samples;
+  ASSERT_TRUE(buffer.getMessages(data_samples));
+  ASSERT_EQ(expected.size(), data_samples.size());
+  for (int j = 0; j < static_cast<int> (expected.size()); ++j)
+  {
+    EXPECT_EQ(expected[j].header.seq, data_samples[j].header.seq);
+    EXPECT_EQ(expected[j].header.stamp, data_samples[j].header.stamp);
+    EXPECT_EQ(expected[j].header.frame_id, data_samples[j].header.frame_id);
+    EXPECT_TRUE(expected[j].names == data_samples[j].names);
+    EXPECT_TRUE(expected[j].data == data_samples[j].data);
+  }
+}
+
+TEST(TestDataSampleBuffer, TestCrop)
+{
+  srand(0);
+  std::vector<ros::Time> stamps;
+  for (int j = 0; j < 20; ++j)
+  {
+    stamps.push_back(ros::Time(0.1 * (j + 1)));
+  }
+  const std::vector<DataSample> data_samples = getDataSamples(stamps);
+
+  const double limits[][2] = { {0.0, 3.0}, {0.1, 2.0}, {0.55, 1.25}, {0.5, 1.2}, {1.95, 2.5}, {0.05, 0.1}, {1.0, 1.0}};
+  for (int k = 0; k < static_cast<int> (sizeof(limits) / sizeof(limits[0])); ++k)
+  {
+    const ros::Time start_time(limits[k][0]);
+    const ros::Time end_time(limits[k][1]);
+    std::vector<DataSample> expected = data_samples;
+    ASSERT_TRUE(crop(expected, start_time, end_time));
+
+    DataSampleBuffer buffer;
+    ASSERT_TRUE(buffer.set(data_samples));
+    ASSERT_TRUE(buffer.crop(start_time, end_time));
+    expectEqual(expected, buffer);
+  }
+}
+
+TEST(TestDataSampleBuffer, TestRemoveDuplicates)
+{
+  srand(1);
+  std::vector<std::vector<ros::Time> > stamps_list;
+  std::vector<ros::Time> stamps;
+  // invalid first and last stamp, duplicates at the beginning, in the middle and at the end
+  const double fixed_stamps[] = {0.0, 0.1, 0.1, 0.1, 0.2, 0.0, 0.3, 0.25, 0.4, 0.4, 0.0};
+  for (int j = 0; j < static_cast<int> (sizeof(fixed_stamps) / sizeof(fixed_stamps[0])); ++j)
+  {
+    stamps.push_back(ros::Time(fixed_stamps[j]));
+  }
+  stamps_list.push_back(stamps);
+  for (int k = 0; k < 50; ++k)
+  {
+    stamps_list.push_back(getRandomStamps(1 + rand() % 40));
+  }
+
+  for (int k = 0; k < static_cast<int> (stamps_list.size()); ++k)
+  {
+    const std::vector<DataSample> data_samples = getDataSamples(stamps_list[k]);
+    std::vector<DataSample> expected = data_samples;
+    ASSERT_TRUE(removeDuplicates(expected));
+
+    DataSampleBuffer buffer;
+    ASSERT_TRUE(buffer.set(data_samples));
+    ASSERT_TRUE(buffer.removeDuplicates());
+    expectEqual(expected, buffer);
+  }
+}
+
+TEST(TestDataSampleBuffer, TestGetData)
+{
+  srand(2);
+  std::vector<ros::Time> stamps;
+  for (int j = 0; j < 10; ++j)
+  {
+    stamps.push_back(ros::Time(0.1 * (j + 1)));
+  }
+  const std::vector<DataSample> data_samples = getDataSamples(stamps);
+  DataSampleBuffer buffer;
+  ASSERT_TRUE(buffer.set(data_samples));
+
+  std::vector<int> indices;
+  indices.push_back(2);
+  indices.push_back(0);
+  indices.push_back(2);
+  Eigen::MatrixXd data;
+  ASSERT_TRUE(buffer.getData(indices, data));
+  ASSERT_EQ(static_cast<int> (data_samples.size()), static_cast<int> (data.rows()));
+  ASSERT_EQ(static_cast<int> (indices.size()), static_cast<int> (data.cols()));
+  for (int j = 0; j < static_cast<int> (data_samples.size()); ++j)
+  {
+    for (int i = 0; i < static_cast<int> (indices.size()); ++i)
+    {
+      EXPECT_EQ(data_samples[j].data[indices[i]], data(j, i));
+    }
+  }
+
+  indices.push_back(NUM_SIGNALS);
+  EXPECT_FALSE(buffer.getData(indices, data));
+  indices.back() = -1;
+  EXPECT_FALSE(buffer.getData(indices, data));
+}
+
+TEST(TestDataSampleBuffer, TestSetMatrix)
+{
+  srand(3);
+  const int num_samples = 7;
+  std::vector<ros::Time> stamps;
+  for (int j = 0; j < num_samples; ++j)
+  {
+    stamps.push_back(ros::Time(0.1 * (j + 1)));
+  }
+  const std::vector<std::string> names = getNames("signal_", NUM_SIGNALS);
+  const Eigen::MatrixXd data = Eigen::MatrixXd::Random(num_samples, NUM_SIGNALS);
+
+  DataSampleBuffer buffer;
+  ASSERT_TRUE(buffer.set(getDataSamples(stamps)));
+  ASSERT_TRUE(buffer.set(names, stamps, data, "frame"));
+  ASSERT_EQ(num_samples, buffer.size());
+  ASSERT_EQ(NUM_SIGNALS, buffer.getNumSignals());
+
+  std::vector<DataSample> expected(num_samples);
+  for (int j = 0; j < num_samples; ++j)
+  {
+    expected[j].header.seq = j;
+    expected[j].header.stamp = stamps[j];
+    expected[j].header.frame_id = "frame";
+    expected[j].names = names;
+    for (int i = 0; i < NUM_SIGNALS; ++i)
+    {
+      expected[j].data.push_back(data(j, i));
+    }
+  }
+  expectEqual(expected, buffer);
+
+  // dimensions that do not match are rejected
+  EXPECT_FALSE(buffer.set(names, stamps, Eigen::MatrixXd::Random(num_samples - 1, NUM_SIGNALS)));
+  EXPECT_FALSE(buffer.set(names, stamps, Eigen::MatrixXd::Random(num_samples, NUM_SIGNALS + 1)));
+}
+
+TEST(TestDataSampleBuffer, TestNamesReset)
+{
+  srand(4);
+  std::vector<ros::Time> stamps;
+  for (int j = 0; j < 5; ++j)
+  {
+    stamps.push_back(ros::Time(0.1 * (j + 1)));
+  }
+  DataSampleBuffer buffer;
+  ASSERT_TRUE(buffer.set(getDataSamples(stamps)));
+  EXPECT_TRUE(buffer.getNames() == getNames("signal_", NUM_SIGNALS));
+
+  // samples added to a non empty buffer need to match the names header
+  DataSample data_sample;
+  data_sample.header.stamp = ros::Time(1.0);
+  data_sample.header.frame_id = "other_frame";
+  data_sample.names = getNames("other_", NUM_SIGNALS + 2);
+  data_sample.data.resize(NUM_SIGNALS + 2, 1.0);
+  EXPECT_FALSE(buffer.add(data_sample));
+  EXPECT_EQ(5, buffer.size());
+
+  // the first sample added into an empty buffer sets the names header
+  buffer.clear();
+  EXPECT_TRUE(buffer.getNames() == getNames("signal_", NUM_SIGNALS));
+  ASSERT_TRUE(buffer.add(data_sample));
+  EXPECT_EQ(1, buffer.size());
+  EXPECT_EQ(NUM_SIGNALS + 2, buffer.getNumSignals());
+  EXPECT_TRUE(buffer.getNames() == data_sample.names);
+  EXPECT_EQ(std::string("other_frame"), buffer.getFrameId());
+  std::vector<DataSample> expected(1, data_sample);
+  expectEqual(expected, buffer);
+
+  // unless its names and values do not match
+  buffer.clear();
+  data_sample.data.resize(NUM_SIGNALS);
+  EXPECT_FALSE(buffer.add(data_sample));
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_FALSE(buffer.add(ros::Time(1.0), std::vector<double>(NUM_SIGNALS, 1.0)));
+  EXPECT_TRUE(buffer.add(ros::Time(1.0), std::vector<double>(NUM_SIGNALS + 2, 1.0)));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,7 @@
 
 // system includes
 #include <vector>
+#include <complex>
 #include <boost/thread.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/shared_ptr.hpp>
@@ -60,6 +61,9 @@ public:
    * @param apply_window
    * @param mel_filter_parameter_a
    * @param mel_filter_parameter_b
+   * @param use_sliding_dft If set, the spectrum is updated incrementally for each sample in O(N)
+   * instead of recomputing the full FFT over the whole window (O(N log N)). The sliding DFT is
+   * re-synchronized with a full FFT once every num_frames_per_period samples to bound round-off drift.
    * @return True on success, otherwise False
    */
   bool initialize(const int num_frames_per_period,
@@ -67,7 +71,8 @@ public:
                   const double output_sample_rate,
                   bool apply_window = false,
                   const double mel_filter_parameter_a = 700.0,
-                  const double mel_filter_parameter_b = 2590.0);
+                  const double mel_filter_parameter_b = 2590.0,
+                  const bool use_sliding_dft = false);
 
   /*!
    * @param value
@@ -82,6 +87,7 @@ private:
   int num_frames_per_period_;
   int num_output_signals_;
   bool apply_window_;
+  bool use_sliding_dft_;
 
   std::vector<double> current_data_;
   Eigen::VectorXd output_signal_spectrum_;
@@ -90,14 +96,35 @@ private:
 
   Eigen::MatrixXd mel_filter_bank_;
 
+  /*! Sparse representation of the mel filter bank. Each (triangular) filter is stored as the
+   * index of its first non-zero row and the contiguous range of its non-zero weights.
+   */
+  std::vector<int> mel_filter_start_indices_;
+  std::vector<Eigen::VectorXd> mel_filter_weights_;
+
   double* fftw_input_;
   fftw_complex *fftw_out_;
   fftw_plan fftw_plan_;
 
   boost::shared_ptr<task_recorder2_utilities::CircularMessageBuffer<double> > cb_;
 
+  /*! Sliding DFT state. The spectrum bins 0...N/2 of the current window (ordered from the newest
+   * to the oldest sample) and the raw samples of the window.
+   */
+  int num_spectrum_bins_;
+  std::vector<std::complex<double> > sliding_spectrum_;
+  std::vector<std::complex<double> > sliding_twiddle_factors_;
+  std::vector<double> sliding_buffer_;
+  int sliding_buffer_index_;
+  int num_samples_since_resync_;
+
   double output_sample_rate_;
   bool initMelFilterBank(const double a, const double b);
+  void initSparseMelFilterBank();
+  void computeFullSpectrum(const double value);
+  void computeSlidingSpectrum(const double value);
+  void resyncSlidingSpectrum();
+  std::complex<double> getSlidingSpectrumBin(const int index) const;
   void setupOutput();
 };
 
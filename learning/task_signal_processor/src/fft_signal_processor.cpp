@@ -13,6 +13,7 @@
  *********************************************************************/
 
 // system includes
+#include <algorithm>
 
 // local includes
 #include <task_signal_processor/fft_signal_processor.h>
@@ -21,7 +22,7 @@ namespace task_signal_processor
 {
 
 FFTSignalProcessor::FFTSignalProcessor()
-  : initialized_(false)
+  : initialized_(false), use_sliding_dft_(false), num_spectrum_bins_(0), sliding_buffer_index_(0), num_samples_since_resync_(0)
 {
 }
 
@@ -40,21 +41,30 @@ bool FFTSignalProcessor::initialize(const int num_frames_per_period,
                                     const double output_sample_rate,
                                     bool apply_window,
                                     const double mel_filter_parameter_a,
-                                    const double mel_filter_parameter_b)
+                                    const double mel_filter_parameter_b,
+                                    const bool use_sliding_dft)
 {
   num_frames_per_period_ = num_frames_per_period;
   num_output_signals_ = num_output_signals;
   output_sample_rate_ = output_sample_rate;
   apply_window_ = apply_window;
+  use_sliding_dft_ = use_sliding_dft;
   ROS_VERIFY(initMelFilterBank(mel_filter_parameter_a, mel_filter_parameter_b));
+  initSparseMelFilterBank();
 
   fftw_input_ = new double[num_frames_per_period_];
   fftw_out_ = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * num_frames_per_period_);
   fftw_plan_ = fftw_plan_dft_r2c_1d(num_frames_per_period_, fftw_input_, fftw_out_, FFTW_MEASURE);
+  // the r2c transform only writes the first N/2+1 (non-redundant) bins, make sure the remaining ones are well defined
+  for (int i = 0; i < num_frames_per_period_; ++i)
+  {
+    fftw_out_[i][0] = 0.0;
+    fftw_out_[i][1] = 0.0;
+  }
 
   current_data_.resize(num_frames_per_period_);
   output_signal_spectrum_ = Eigen::VectorXd((Eigen::DenseIndex)num_output_signals_);
-  amplitude_spectrum_ = Eigen::VectorXd((Eigen::DenseIndex)num_frames_per_period_);
+  amplitude_spectrum_ = Eigen::VectorXd::Zero((Eigen::DenseIndex)num_frames_per_period_);
   if(apply_window_)
   {
     hamming_window_ = Eigen::VectorXd::Zero((Eigen::DenseIndex)num_frames_per_period_);
@@ -65,7 +75,23 @@ bool FFTSignalProcessor::initialize(const int num_frames_per_period,
   }
 
   double default_value = 0.0;
-  cb_.reset(new task_recorder2_utilities::CircularMessageBuffer<double>(num_frames_per_period_, default_value));
+  if (use_sliding_dft_)
+  {
+    num_spectrum_bins_ = num_frames_per_period_ / 2 + 1;
+    sliding_spectrum_.assign(num_spectrum_bins_, std::complex<double>(0.0, 0.0));
+    sliding_twiddle_factors_.resize(num_spectrum_bins_);
+    for (int k = 0; k < num_spectrum_bins_; ++k)
+    {
+      sliding_twiddle_factors_[k] = std::polar(1.0, -2.0 * M_PI * static_cast<double> (k) / static_cast<double> (num_frames_per_period_));
+    }
+    sliding_buffer_.assign(num_frames_per_period_, default_value);
+    sliding_buffer_index_ = 0;
+    num_samples_since_resync_ = 0;
+  }
+  else
+  {
+    cb_.reset(new task_recorder2_utilities::CircularMessageBuffer<double>(num_frames_per_period_, default_value));
+  }
 
   return (initialized_ = true);
 }
@@ -74,6 +100,35 @@ bool FFTSignalProcessor::filter(const double value, std::vector<double>& data)
 {
   ROS_ASSERT((int)data.size() == num_output_signals_);
 
+  if (use_sliding_dft_)
+  {
+    computeSlidingSpectrum(value);
+  }
+  else
+  {
+    computeFullSpectrum(value);
+  }
+
+  // fill in the output signal
+  setupOutput();
+
+  // write to data
+  for (int i = 0; i < num_output_signals_; ++i)
+  {
+		if(isnan(output_signal_spectrum_(i)))
+		{
+			data[i] = 0.0;
+		}
+		else
+		{
+			data[i] = output_signal_spectrum_(i);
+		}
+  }
+  return true;
+}
+
+void FFTSignalProcessor::computeFullSpectrum(const double value)
+{
   cb_->push_front(value);
   ROS_VERIFY(cb_->get(current_data_));
 
@@ -99,30 +154,99 @@ bool FFTSignalProcessor::filter(const double value, std::vector<double>& data)
   {
     amplitude_spectrum_(i) = sqrt(fftw_out_[i][0] * fftw_out_[i][0] + fftw_out_[i][1] * fftw_out_[i][1]);
   }
+}
 
-  // fill in the output signal
-  setupOutput();
+void FFTSignalProcessor::computeSlidingSpectrum(const double value)
+{
+  // replace the oldest sample
+  const double oldest_value = sliding_buffer_[sliding_buffer_index_];
+  sliding_buffer_[sliding_buffer_index_] = value;
+  sliding_buffer_index_ = (sliding_buffer_index_ + 1) % num_frames_per_period_;
 
-  // write to data
-  for (int i = 0; i < num_output_signals_; ++i)
+  if (++num_samples_since_resync_ >= num_frames_per_period_)
   {
-		if(isnan(output_signal_spectrum_(i)))
-		{
-			data[i] = 0.0;
-		}
-		else
-		{
-			data[i] = output_signal_spectrum_(i);
-		}
+    resyncSlidingSpectrum();
   }
-  return true;
+  else
+  {
+    // X_k(n) = e^(-i 2 pi k / N) * X_k(n-1) + x(n) - x(n-N)
+    const double delta = value - oldest_value;
+    for (int k = 0; k < num_spectrum_bins_; ++k)
+    {
+      sliding_spectrum_[k] = sliding_twiddle_factors_[k] * sliding_spectrum_[k] + delta;
+    }
+  }
+
+  // compute amplitude, the hamming window is applied in the frequency domain
+  // (w(n) = 0.54 - 0.23 e^(i 2 pi n / N) - 0.23 e^(-i 2 pi n / N) amounts to a 3-tap convolution)
+  for (int k = 0; k < num_spectrum_bins_; ++k)
+  {
+    if (apply_window_)
+    {
+      amplitude_spectrum_(k) = std::abs(0.54 * sliding_spectrum_[k] - 0.23 * (getSlidingSpectrumBin(k - 1) + getSlidingSpectrumBin(k + 1)));
+    }
+    else
+    {
+      amplitude_spectrum_(k) = std::abs(sliding_spectrum_[k]);
+    }
+  }
+}
+
+void FFTSignalProcessor::resyncSlidingSpectrum()
+{
+  // order samples from the newest to the oldest (as in the full FFT path)
+  for (int i = 0; i < num_frames_per_period_; ++i)
+  {
+    fftw_input_[i] = sliding_buffer_[(sliding_buffer_index_ - 1 - i + 2 * num_frames_per_period_) % num_frames_per_period_];
+  }
+  fftw_execute(fftw_plan_);
+  for (int k = 0; k < num_spectrum_bins_; ++k)
+  {
+    sliding_spectrum_[k] = std::complex<double>(fftw_out_[k][0], fftw_out_[k][1]);
+  }
+  num_samples_since_resync_ = 0;
+}
+
+std::complex<double> FFTSignalProcessor::getSlidingSpectrumBin(const int index) const
+{
+  // the spectrum of a real signal is hermitian, X(-k) = X(N-k) = conj(X(k))
+  if (index < 0)
+  {
+    return std::conj(sliding_spectrum_[-index]);
+  }
+  if (index >= num_spectrum_bins_)
+  {
+    return std::conj(sliding_spectrum_[num_frames_per_period_ - index]);
+  }
+  return sliding_spectrum_[index];
 }
 
 void FFTSignalProcessor::setupOutput()
 {
   for (int i = 0; i < num_output_signals_; ++i)
   {
-    output_signal_spectrum_(i) = static_cast<double> (amplitude_spectrum_.transpose() * mel_filter_bank_.col(i));
+    output_signal_spectrum_(i) = amplitude_spectrum_.segment(mel_filter_start_indices_[i], mel_filter_weights_[i].size()).dot(mel_filter_weights_[i]);
+  }
+}
+
+void FFTSignalProcessor::initSparseMelFilterBank()
+{
+  mel_filter_start_indices_.resize(num_output_signals_);
+  mel_filter_weights_.resize(num_output_signals_);
+  for (int m = 0; m < num_output_signals_; ++m)
+  {
+    int first = 0;
+    while (first < (int)mel_filter_bank_.rows() && mel_filter_bank_(first, m) == 0.0)
+    {
+      first++;
+    }
+    int last = (int)mel_filter_bank_.rows() - 1;
+    while (last >= first && mel_filter_bank_(last, m) == 0.0)
+    {
+      last--;
+    }
+    mel_filter_start_indices_[m] = (first <= last) ? first : 0;
+    mel_filter_weights_[m] = mel_filter_bank_.col(m).segment(mel_filter_start_indices_[m], std::max(last - first + 1, 0));
   }
 }
 
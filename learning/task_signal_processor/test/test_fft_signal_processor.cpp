@@ -0,0 +1,75 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks		...
+
+  \file		test_fft_signal_processor.cpp
+
+  \date		Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+// local includes
+#include <task_signal_processor/fft_signal_processor.h>
+
+using namespace task_signal_processor;
+
+const int NUM_FRAMES_PER_PERIOD = 200;
+const int NUM_OUTPUT_SIGNALS = 100;
+const double SAMPLE_RATE = 100.0;
+const double SIN_FREQUENCY = 25.0 * 2.0 * M_PI;
+const double SIN_FREQUENCY2 = 10.0 * 2.0 * M_PI;
+const int NUM_SAMPLES = 5 * NUM_FRAMES_PER_PERIOD + 37;
+
+/*! Feeds the same signal into a full FFT and a sliding DFT processor and compares their outputs sample by sample
+ */
+void compareSlidingToFullFFT(const bool apply_window)
+{
+  FFTSignalProcessor full_fft;
+  ASSERT_TRUE(full_fft.initialize(NUM_FRAMES_PER_PERIOD, NUM_OUTPUT_SIGNALS, SAMPLE_RATE, apply_window));
+  FFTSignalProcessor sliding_dft;
+  ASSERT_TRUE(sliding_dft.initialize(NUM_FRAMES_PER_PERIOD, NUM_OUTPUT_SIGNALS, SAMPLE_RATE, apply_window, 700.0, 2590.0, true));
+
+  std::vector<double> full_data(NUM_OUTPUT_SIGNALS, 0.0);
+  std::vector<double> sliding_data(NUM_OUTPUT_SIGNALS, 0.0);
+
+  srand(0);
+  for (int n = 0; n < NUM_SAMPLES; ++n)
+  {
+    const double t = static_cast<double> (n) / SAMPLE_RATE;
+    const double noise = 0.1 * (static_cast<double> (rand()) / static_cast<double> (RAND_MAX) - 0.5);
+    const double value = std::sin(SIN_FREQUENCY * t) + std::sin(SIN_FREQUENCY2 * t) + noise;
+
+    EXPECT_TRUE(full_fft.filter(value, full_data));
+    EXPECT_TRUE(sliding_dft.filter(value, sliding_data));
+
+    for (int i = 0; i < NUM_OUTPUT_SIGNALS; ++i)
+    {
+      EXPECT_NEAR(full_data[i], sliding_data[i], 1e-8 * (1.0 + std::fabs(full_data[i]))) << "sample " << n << ", output signal " << i;
+    }
+  }
+}
+
+TEST(fft_signal_processor_test, slidingDFTMatchesFullFFT)
+{
+  compareSlidingToFullFFT(false);
+}
+
+TEST(fft_signal_processor_test, slidingDFTMatchesFullFFTWithWindow)
+{
+  compareSlidingToFullFFT(true);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
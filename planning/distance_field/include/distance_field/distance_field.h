@@ -68,10 +68,11 @@ enum PlaneVisualizationType
 * radius.
 *
 * This is an abstract base class, current implementations include PropagationDistanceField
-* and PFDistanceField.
+* and PFDistanceField. The memory layout of the voxels is defined by the Storage policy
+* of the VoxelGrid.
 */
-template <typename T>
-class DistanceField: public VoxelGrid<T>
+template <typename T, typename Storage = LinearVoxelStorage>
+class DistanceField: public VoxelGrid<T, Storage>
 {
 public:
 
@@ -122,6 +123,29 @@ public:
    */
   double getDistanceGradient(double x, double y, double z, double& gradient_x, double& gradient_y, double& gradient_z) const;
 
+  /**
+   * \brief Gets the distances and the gradients of the field at a batch of locations.
+   *
+   * Same as calling getDistanceGradient() for each point.
+   * \param distances will be resized to the number of points
+   * \param gradients will be resized to the number of points
+   */
+  void getDistanceGradients(const std::vector<tf::Vector3>& points, std::vector<double>& distances,
+                            std::vector<tf::Vector3>& gradients) const;
+
+  /**
+   * \brief Gets trilinearly interpolated distances and their analytic gradients at a batch of locations.
+   *
+   * In contrast to getDistanceGradient(), the distance is continuous across cell boundaries.
+   * Locations outside of the grid are clamped to the grid, the gradient along the clamped axes is zero.
+   * \param points Locations, stored as x,y,z,x,y,z,...
+   * \param num_points Number of locations
+   * \param distances Output, num_points distances
+   * \param gradients Output, 3*num_points gradients stored as x,y,z,x,y,z,... or NULL if not needed
+   */
+  template <typename Scalar>
+  void getInterpolatedDistanceGradients(const Scalar* points, int num_points, Scalar* distances, Scalar* gradients) const;
+
   /**
    * \brief Gets the distance to the closest obstacle at the given integer cell location.
    */
@@ -166,33 +190,33 @@ protected:
   virtual double getDistance(const T& object) const=0;
 
 private:
-  int inv_twice_resolution_;
+  double inv_twice_resolution_;
 };
 
 //////////////////////////// template function definitions follow //////////////
 
-template <typename T>
-DistanceField<T>::~DistanceField()
+template <typename T, typename Storage>
+DistanceField<T, Storage>::~DistanceField()
 {
 
 }
 
-template <typename T>
-DistanceField<T>::DistanceField(double size_x, double size_y, double size_z, double resolution,
+template <typename T, typename Storage>
+DistanceField<T, Storage>::DistanceField(double size_x, double size_y, double size_z, double resolution,
     double origin_x, double origin_y, double origin_z, T default_object):
-      VoxelGrid<T>(size_x, size_y, size_z, resolution, origin_x, origin_y, origin_z, default_object)
+      VoxelGrid<T, Storage>(size_x, size_y, size_z, resolution, origin_x, origin_y, origin_z, default_object)
 {
   inv_twice_resolution_ = 1.0/(2.0*resolution);
 }
 
-template <typename T>
-double DistanceField<T>::getDistance(double x, double y, double z) const
+template <typename T, typename Storage>
+double DistanceField<T, Storage>::getDistance(double x, double y, double z) const
 {
   return getDistance((*this)(x,y,z));
 }
 
-template <typename T>
-double DistanceField<T>::getDistanceGradient(double x, double y, double z, double& gradient_x, double& gradient_y, double& gradient_z) const
+template <typename T, typename Storage>
+double DistanceField<T, Storage>::getDistanceGradient(double x, double y, double z, double& gradient_x, double& gradient_y, double& gradient_z) const
 {
   int gx, gy, gz;
 
@@ -216,14 +240,100 @@ double DistanceField<T>::getDistanceGradient(double x, double y, double z, doubl
 
 }
 
-template <typename T>
-double DistanceField<T>::getDistanceFromCell(int x, int y, int z) const
+template <typename T, typename Storage>
+void DistanceField<T, Storage>::getDistanceGradients(const std::vector<tf::Vector3>& points, std::vector<double>& distances,
+                                                     std::vector<tf::Vector3>& gradients) const
+{
+  distances.resize(points.size());
+  gradients.resize(points.size());
+  double gradient_x, gradient_y, gradient_z;
+  for (unsigned int i=0; i<points.size(); ++i)
+  {
+    distances[i] = getDistanceGradient(points[i].x(), points[i].y(), points[i].z(), gradient_x, gradient_y, gradient_z);
+    gradients[i] = tf::Vector3(gradient_x, gradient_y, gradient_z);
+  }
+}
+
+template <typename T, typename Storage>
+template <typename Scalar>
+void DistanceField<T, Storage>::getInterpolatedDistanceGradients(const Scalar* points, int num_points,
+                                                                 Scalar* distances, Scalar* gradients) const
+{
+  const Scalar inv_resolution = Scalar(1.0 / this->resolution_[this->DIM_X]);
+  Scalar origin[3];
+  int max_cell[3];
+  int next_cell[3];
+  for (int dim=0; dim<3; ++dim)
+  {
+    origin[dim] = Scalar(this->origin_[dim]);
+    max_cell[dim] = this->num_cells_[dim] - 1;
+    next_cell[dim] = (max_cell[dim] > 0) ? 1 : 0;
+  }
+
+  for (int i=0; i<num_points; ++i)
+  {
+    // lower corner of the surrounding cells and the location within
+    int cell[3];
+    Scalar frac[3];
+    Scalar inside[3];
+    for (int dim=0; dim<3; ++dim)
+    {
+      Scalar u = (points[3*i+dim] - origin[dim]) * inv_resolution;
+      inside[dim] = Scalar(1.0);
+      if (u < Scalar(0.0))
+      {
+        u = Scalar(0.0);
+        inside[dim] = Scalar(0.0);
+      }
+      else if (u > Scalar(max_cell[dim]))
+      {
+        u = Scalar(max_cell[dim]);
+        inside[dim] = Scalar(0.0);
+      }
+      cell[dim] = std::min(int(u), max_cell[dim] - next_cell[dim]);
+      frac[dim] = u - Scalar(cell[dim]);
+    }
+    const int x0 = cell[0], x1 = cell[0] + next_cell[0];
+    const int y0 = cell[1], y1 = cell[1] + next_cell[1];
+    const int z0 = cell[2], z1 = cell[2] + next_cell[2];
+
+    const Scalar c000 = Scalar(getDistanceFromCell(x0, y0, z0));
+    const Scalar c001 = Scalar(getDistanceFromCell(x0, y0, z1));
+    const Scalar c010 = Scalar(getDistanceFromCell(x0, y1, z0));
+    const Scalar c011 = Scalar(getDistanceFromCell(x0, y1, z1));
+    const Scalar c100 = Scalar(getDistanceFromCell(x1, y0, z0));
+    const Scalar c101 = Scalar(getDistanceFromCell(x1, y0, z1));
+    const Scalar c110 = Scalar(getDistanceFromCell(x1, y1, z0));
+    const Scalar c111 = Scalar(getDistanceFromCell(x1, y1, z1));
+
+    // interpolate along z, y and x
+    const Scalar d00 = c000 + frac[2] * (c001 - c000);
+    const Scalar d01 = c010 + frac[2] * (c011 - c010);
+    const Scalar d10 = c100 + frac[2] * (c101 - c100);
+    const Scalar d11 = c110 + frac[2] * (c111 - c110);
+    const Scalar d0 = d00 + frac[1] * (d01 - d00);
+    const Scalar d1 = d10 + frac[1] * (d11 - d10);
+    distances[i] = d0 + frac[0] * (d1 - d0);
+
+    if (gradients)
+    {
+      const Scalar dz0 = (c001 - c000) + frac[1] * ((c011 - c010) - (c001 - c000));
+      const Scalar dz1 = (c101 - c100) + frac[1] * ((c111 - c110) - (c101 - c100));
+      gradients[3*i+0] = inside[0] * inv_resolution * (d1 - d0);
+      gradients[3*i+1] = inside[1] * inv_resolution * ((d01 - d00) + frac[0] * ((d11 - d10) - (d01 - d00)));
+      gradients[3*i+2] = inside[2] * inv_resolution * (dz0 + frac[0] * (dz1 - dz0));
+    }
+  }
+}
+
+template <typename T, typename Storage>
+double DistanceField<T, Storage>::getDistanceFromCell(int x, int y, int z) const
 {
   return getDistance(this->getCell(x,y,z));
 }
 
-template <typename T>
-void DistanceField<T>::getIsoSurfaceMarkers(double min_radius, double max_radius,
+template <typename T, typename Storage>
+void DistanceField<T, Storage>::getIsoSurfaceMarkers(double min_radius, double max_radius,
                                             const std::string & frame_id, const ros::Time stamp,
                                             const tf::Transform& cur,
                                             visualization_msgs::Marker& inf_marker )
@@ -235,9 +345,9 @@ void DistanceField<T>::getIsoSurfaceMarkers(double min_radius, double max_radius
   inf_marker.id = 1;
   inf_marker.type = visualization_msgs::Marker::CUBE_LIST;
   inf_marker.action = 0;
-  inf_marker.scale.x = this->resolution_[VoxelGrid<T>::DIM_X];
-  inf_marker.scale.y = this->resolution_[VoxelGrid<T>::DIM_Y];
-  inf_marker.scale.z = this->resolution_[VoxelGrid<T>::DIM_Z];
+  inf_marker.scale.x = this->resolution_[VoxelGrid<T, Storage>::DIM_X];
+  inf_marker.scale.y = this->resolution_[VoxelGrid<T, Storage>::DIM_Y];
+  inf_marker.scale.z = this->resolution_[VoxelGrid<T, Storage>::DIM_Z];
   inf_marker.color.r = 1.0;
   inf_marker.color.g = 0.0;
   inf_marker.color.b = 0.0;
@@ -246,14 +356,14 @@ void DistanceField<T>::getIsoSurfaceMarkers(double min_radius, double max_radius
 
   inf_marker.points.reserve(100000);
   int num_total_cells =
-    this->num_cells_[VoxelGrid<T>::DIM_X]*
-    this->num_cells_[VoxelGrid<T>::DIM_Y]*
-    this->num_cells_[VoxelGrid<T>::DIM_Z];
-  for (int x = 0; x < this->num_cells_[VoxelGrid<T>::DIM_X]; ++x)
+    this->num_cells_[VoxelGrid<T, Storage>::DIM_X]*
+    this->num_cells_[VoxelGrid<T, Storage>::DIM_Y]*
+    this->num_cells_[VoxelGrid<T, Storage>::DIM_Z];
+  for (int x = 0; x < this->num_cells_[VoxelGrid<T, Storage>::DIM_X]; ++x)
   {
-    for (int y = 0; y < this->num_cells_[VoxelGrid<T>::DIM_Y]; ++y)
+    for (int y = 0; y < this->num_cells_[VoxelGrid<T, Storage>::DIM_Y]; ++y)
     {
-      for (int z = 0; z < this->num_cells_[VoxelGrid<T>::DIM_Z]; ++z)
+      for (int z = 0; z < this->num_cells_[VoxelGrid<T, Storage>::DIM_Z]; ++z)
       {
         double dist = getDistanceFromCell(x,y,z);
         double nx, ny, nz;
@@ -277,8 +387,8 @@ void DistanceField<T>::getIsoSurfaceMarkers(double min_radius, double max_radius
   }
 }
 
-template <typename T>
-void DistanceField<T>::getGradientMarkers( double min_radius, double max_radius,
+template <typename T, typename Storage>
+void DistanceField<T, Storage>::getGradientMarkers( double min_radius, double max_radius,
                                            const std::string & frame_id, const ros::Time stamp,
                                            std::vector<visualization_msgs::Marker>& markers )
 {
@@ -342,8 +452,8 @@ void DistanceField<T>::getGradientMarkers( double min_radius, double max_radius,
   }
 }
 
-template <typename T>
-void DistanceField<T>::addCollisionMapToField(const arm_navigation_msgs::CollisionMap &collision_map)
+template <typename T, typename Storage>
+void DistanceField<T, Storage>::addCollisionMapToField(const arm_navigation_msgs::CollisionMap &collision_map)
 {
   size_t num_boxes = collision_map.boxes.size();
   std::vector<tf::Vector3> points;
@@ -359,8 +469,8 @@ void DistanceField<T>::addCollisionMapToField(const arm_navigation_msgs::Collisi
   addPointsToField(points);
 }
 
-template <typename T>
-void DistanceField<T>::getPlaneMarkers(distance_field::PlaneVisualizationType type, double length, double width,
+template <typename T, typename Storage>
+void DistanceField<T, Storage>::getPlaneMarkers(distance_field::PlaneVisualizationType type, double length, double width,
                                       double height, tf::Vector3 origin,
                                       const std::string & frame_id, const ros::Time stamp,
                                       visualization_msgs::Marker& plane_marker )
@@ -371,9 +481,9 @@ void DistanceField<T>::getPlaneMarkers(distance_field::PlaneVisualizationType ty
   plane_marker.id = 1;
   plane_marker.type = visualization_msgs::Marker::CUBE_LIST;
   plane_marker.action = visualization_msgs::Marker::ADD;
-  plane_marker.scale.x = this->resolution_[VoxelGrid<T>::DIM_X];
-  plane_marker.scale.y = this->resolution_[VoxelGrid<T>::DIM_Y];
-  plane_marker.scale.z = this->resolution_[VoxelGrid<T>::DIM_Z];
+  plane_marker.scale.x = this->resolution_[VoxelGrid<T, Storage>::DIM_X];
+  plane_marker.scale.y = this->resolution_[VoxelGrid<T, Storage>::DIM_Y];
+  plane_marker.scale.z = this->resolution_[VoxelGrid<T, Storage>::DIM_Z];
   //plane_marker.lifetime = ros::Duration(30.0);
 
   plane_marker.points.reserve(100000);
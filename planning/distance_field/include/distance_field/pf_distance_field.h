@@ -60,15 +60,20 @@ public:
   typedef std::vector<float> FloatArray;
   typedef std::vector<int>   IntArray;
 
-  virtual void addPointsToField(const std::vector<tf::Vector3> points);
+  virtual void addPointsToField(const std::vector<tf::Vector3>& points);
   virtual void reset();
 
   const float DT_INF;
 
 private:
-  inline float sqr(float x) { return x*x; }
-  void dt(const FloatArray& f, size_t nn, FloatArray& ft, IntArray& v, FloatArray& z);
+  /// \brief Number of neighboring lines (along z) that are gathered into contiguous buffers at once
+  static const int DT_BLOCK_SIZE = 16;
+
+  inline float sqr(float x) const { return x*x; }
+  void dt(const float* f, int n, float* ft, int* v, float* z) const;
   void computeDT();
+  // transforms num_lines lines of length n, line j starts at block[j] and its elements are stride apart
+  void dtBlock(float* block, int stride, int n, int num_lines, float* f, float* ft, int* v, float* z) const;
   virtual double getDistance(const float& object) const;
 
 };
@@ -45,6 +45,7 @@
 #include <ros/ros.h>
 #include <eigen3/Eigen/Core>
 #include <set>
+#include <algorithm>
 
 namespace distance_field
 {
@@ -69,6 +70,10 @@ struct compareInt3
 };
 
 
+/// \brief Memory layout of the propagation distance fields, the propagation visits
+/// neighboring voxels, hence they are stored in bricks of 8x8x8 voxels
+typedef BrickedVoxelStorage<3> PropDistanceFieldStorage;
+
 /**
  * \brief Structure that holds voxel information for the DistanceField.
  */
@@ -105,7 +110,7 @@ struct SignedPropDistanceFieldVoxel : public PropDistanceFieldVoxel
  * and the gradient of the field at a point. Expansion of obstacles is performed upto a given
  * radius.
  */
-class PropagationDistanceField: public DistanceField<PropDistanceFieldVoxel>
+class PropagationDistanceField: public DistanceField<PropDistanceFieldVoxel, PropDistanceFieldStorage>
 {
 public:
 
@@ -138,12 +143,43 @@ public:
   using DistanceField::getDistance;
 
 private:
-  /// \brief The set of all the obstacle voxels
-  typedef std::set<int3, compareInt3> VoxelSet;
-  VoxelSet object_voxel_locations_;
+  /// \brief A list of voxel locations
+  typedef std::vector<int3> VoxelList;
+
+  /// \brief Bits of obstacle_flags_
+  enum ObstacleFlag
+  {
+    OBSTACLE = 1,     /**< The voxel is an obstacle voxel */
+    SEEN = 2          /**< The voxel has been seen in the current update */
+  };
+
+  /// \brief The list of all the obstacle voxels
+  VoxelList object_voxel_locations_;
+  /// \brief Per voxel obstacle flags (indexed like data_), used to diff obstacle sets in O(1) per point
+  std::vector<unsigned char> obstacle_flags_;
+
+  /// \brief A pending update of a neighboring voxel found while propagating
+  struct PropagationCandidate
+  {
+    PropDistanceFieldVoxel* voxel_;
+    int3 location_;
+    int3 closest_point_;
+    int distance_square_;
+    int update_direction_;
+  };
+
+  /// \brief Structure used to hold propogation frontier, one bucket queue per thread
+  std::vector<std::vector<std::vector<PropDistanceFieldVoxel*> > > bucket_queues_;
+  /// \brief The voxels of the bucket that is currently being propagated
+  std::vector<PropDistanceFieldVoxel*> current_bucket_;
+  /// \brief Candidate updates found by thread [i] for voxels owned by thread [j]
+  std::vector<std::vector<std::vector<PropagationCandidate> > > candidates_;
+  /// \brief Preallocated stack used when removing obstacle voxels
+  VoxelList remove_stack_;
+  int num_threads_;
+  /// \brief Buckets with less voxels (per thread) are propagated single threaded
+  static const int MIN_VOXELS_PER_THREAD = 512;
 
-  /// \brief Structure used to hold propogation frontier
-  std::vector<std::vector<PropDistanceFieldVoxel*> > bucket_queue_;
   double max_distance_;
   int max_distance_sq_;
 
@@ -158,10 +194,18 @@ private:
 
   std::vector<int3 > direction_number_to_direction_;
 
-  void addNewObstacleVoxels(const VoxelSet& points);
-  void removeObstacleVoxels(const VoxelSet& points);
+  void addNewObstacleVoxels(const VoxelList& points);
+  void removeObstacleVoxels(const VoxelList& points);
+  // marks the voxel as obstacle (and SEEN if mark_seen), returns false if it already was one
+  bool insertObstacleVoxel(const int3& loc, bool mark_seen);
   // starting with the voxels on the queue, propogate values to neighbors up to a certain distance.
   void propogate();
+  // moves the voxels of bucket i of all threads into current_bucket_, returns false if there are none
+  bool gatherBucket(int i);
+  // computes the updates of the neighbors of this thread's chunk of current_bucket_, only writes to the grid if num_threads is 1
+  void collectCandidates(int i, int thread, int num_threads);
+  // applies the candidates of all threads that fall into this thread's x-slab of the grid
+  void applyCandidates(int thread, int num_threads);
   virtual double getDistance(const PropDistanceFieldVoxel& object) const;
   int getDirectionNumber(int dx, int dy, int dz) const;
   int3 getLocationDifference(int directionNumber) const;	// TODO- separate out neighborhoods
@@ -189,7 +233,7 @@ inline double PropagationDistanceField::getDistance(const PropDistanceFieldVoxel
 }
 
 
-class SignedPropagationDistanceField : public DistanceField<SignedPropDistanceFieldVoxel>
+class SignedPropagationDistanceField : public DistanceField<SignedPropDistanceFieldVoxel, PropDistanceFieldStorage>
 {
   public:
 
@@ -0,0 +1,141 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2009, Willow Garage, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef DF_SHAPE_VOXELIZER_H_
+#define DF_SHAPE_VOXELIZER_H_
+
+#include <vector>
+#include <cmath>
+#include <arm_navigation_msgs/Shape.h>
+#include <geometric_shapes/shapes.h>
+#include <geometric_shapes/bodies.h>
+#include <tf/LinearMath/Transform.h>
+#include <tf/LinearMath/Vector3.h>
+
+namespace distance_field
+{
+
+/**
+ * \brief Computes the cells of a voxel grid that are occupied by a shape.
+ *
+ * A cell is occupied when its center is inside the shape padded by half the diagonal of a cell. This makes
+ * the coverage conservative: every cell that overlaps a sphere, box or cylinder is occupied, and shapes
+ * that are thinner than a cell (e.g. a board) do not fall through the grid.
+ *
+ * Spheres, boxes and cylinders get the occupied interval of each (x,y) column in closed form. Any other
+ * shape is converted into a padded body and intersected with one ray per column along each axis, the cells
+ * between pairs of intersections are occupied. Cells outside the grid are skipped.
+ */
+class ShapeVoxelizer
+{
+public:
+
+  ShapeVoxelizer(double origin_x, double origin_y, double origin_z, double resolution,
+                 int num_cells_x, int num_cells_y, int num_cells_z);
+
+  /**
+   * \brief Uses the geometry of a VoxelGrid (e.g. a distance field), the resolution needs to be equal in all dimensions
+   */
+  template <typename Grid>
+  explicit ShapeVoxelizer(const Grid& grid);
+
+  /**
+   * \brief Adds the centers of the cells occupied by a sphere, box or cylinder.
+   * \return false if the shape is of any other type or has an invalid number of dimensions, nothing is added in that case
+   */
+  bool getVoxelsInShape(const arm_navigation_msgs::Shape& shape, const tf::Transform& pose, std::vector<tf::Vector3>& voxels) const;
+
+  /**
+   * \brief Adds the centers of the cells occupied by an arbitrary shape (e.g. a mesh) by casting one ray per column
+   */
+  void getVoxelsInBody(const shapes::Shape& shape, const tf::Transform& pose, std::vector<tf::Vector3>& voxels) const;
+
+  /**
+   * \brief Gets the distance by which shapes are padded, half the diagonal of a cell
+   */
+  double getPadding() const;
+
+private:
+
+  double origin_[3];
+  double resolution_;
+  int num_cells_[3];
+
+  /**
+   * \brief Gets the range of the columns (x,y) within radius of center, returns false if empty
+   */
+  bool getColumnRange(const tf::Vector3& center, double radius, int& x_min, int& x_max, int& y_min, int& y_max) const;
+
+  /**
+   * \brief Adds the cell centers of column (x,y) between z_min and z_max
+   */
+  void addVoxelColumn(int x, int y, double z_min, double z_max, std::vector<tf::Vector3>& voxels) const;
+
+  /**
+   * \brief Gets the range of cells of dimension dim whose centers are between min and max, returns false if empty
+   */
+  bool getCellRange(int dim, double min, double max, int& cell_min, int& cell_max) const;
+
+  /**
+   * \brief Gets the world coordinate of a cell center
+   */
+  double getLocationFromCell(int dim, int cell) const;
+};
+
+///////////////////////////// inline functions follow ///////////////////////////////////
+
+template <typename Grid>
+ShapeVoxelizer::ShapeVoxelizer(const Grid& grid)
+{
+  origin_[0] = grid.getOrigin(Grid::DIM_X);
+  origin_[1] = grid.getOrigin(Grid::DIM_Y);
+  origin_[2] = grid.getOrigin(Grid::DIM_Z);
+  resolution_ = grid.getResolution(Grid::DIM_X);
+  num_cells_[0] = grid.getNumCells(Grid::DIM_X);
+  num_cells_[1] = grid.getNumCells(Grid::DIM_Y);
+  num_cells_[2] = grid.getNumCells(Grid::DIM_Z);
+}
+
+inline double ShapeVoxelizer::getPadding() const
+{
+  return 0.5*sqrt(3.0)*resolution_;
+}
+
+inline double ShapeVoxelizer::getLocationFromCell(int dim, int cell) const
+{
+  return origin_[dim] + resolution_*double(cell);
+}
+
+} // namespace distance_field
+#endif /* DF_SHAPE_VOXELIZER_H_ */
@@ -38,14 +38,72 @@
 #define DF_VOXEL_GRID_H_
 
 #include <algorithm>
+#include <cmath>
 
 namespace distance_field
 {
 
+/**
+ * \brief Storage policy of the VoxelGrid that stores the cells in one flat array (x major, z minor).
+ */
+class LinearVoxelStorage
+{
+public:
+  void initialize(const int num_cells[3]);
+
+  /**
+   * \brief Gets the index of the given integer x,y,z location
+   */
+  int ref(int x, int y, int z) const;
+
+  /**
+   * \brief Gets the number of cells that need to be allocated
+   */
+  int getNumAllocatedCells() const;
+
+private:
+  int num_cells_total_;
+  int stride1_;
+  int stride2_;
+};
+
+/**
+ * \brief Storage policy of the VoxelGrid that stores the cells in bricks of 2^LOG2_BRICK_SIZE cells
+ * along each axis. Cells are stored in Morton order within a brick, such that all neighbors of most
+ * cells share one or two cache lines. LOG2_BRICK_SIZE=2 yields 4x4x4 bricks, LOG2_BRICK_SIZE=3 8x8x8 bricks.
+ */
+template <int LOG2_BRICK_SIZE>
+class BrickedVoxelStorage
+{
+public:
+  static const int BRICK_SIZE = 1 << LOG2_BRICK_SIZE;
+
+  void initialize(const int num_cells[3]);
+
+  /**
+   * \brief Gets the index of the given integer x,y,z location
+   */
+  int ref(int x, int y, int z) const;
+
+  /**
+   * \brief Gets the number of cells that need to be allocated (all bricks are complete)
+   */
+  int getNumAllocatedCells() const;
+
+private:
+  static const int BRICK_MASK = BRICK_SIZE - 1;
+  int num_bricks_[3];
+  /// \brief Bits of the cell index within a brick, interleaved to the Morton code of each axis
+  int morton_[3][BRICK_SIZE];
+};
+
 /**
  * \brief Generic container for a discretized 3D voxel grid for any class/structure
+ *
+ * The memory layout of the cells is defined by the Storage policy, either LinearVoxelStorage
+ * or BrickedVoxelStorage.
  */
-template <typename T>
+template <typename T, typename Storage = LinearVoxelStorage>
 class VoxelGrid
 {
 public:
@@ -136,8 +194,10 @@ protected:
   double origin_[3];
   int num_cells_[3];
   int num_cells_total_;
-  int stride1_;
+  int num_cells_allocated_;	/**< Size of data_, larger than num_cells_total_ for bricked storage */
+  int stride1_;			/**< Strides of the linear layout, only valid for LinearVoxelStorage */
   int stride2_;
+  Storage storage_;
 
   /**
    * \brief Gets the reference in the data_ array for the given integer x,y,z location
@@ -165,10 +225,64 @@ protected:
   bool isCellValid(Dimension dim, int cell) const;
 };
 
+//////////////////////////// storage policy definitions follow //////////////////
+
+inline void LinearVoxelStorage::initialize(const int num_cells[3])
+{
+  num_cells_total_ = num_cells[0]*num_cells[1]*num_cells[2];
+  stride1_ = num_cells[1]*num_cells[2];
+  stride2_ = num_cells[2];
+}
+
+inline int LinearVoxelStorage::ref(int x, int y, int z) const
+{
+  return x*stride1_ + y*stride2_ + z;
+}
+
+inline int LinearVoxelStorage::getNumAllocatedCells() const
+{
+  return num_cells_total_;
+}
+
+template<int LOG2_BRICK_SIZE>
+void BrickedVoxelStorage<LOG2_BRICK_SIZE>::initialize(const int num_cells[3])
+{
+  for (int dim=0; dim<3; ++dim)
+    num_bricks_[dim] = (num_cells[dim] + BRICK_SIZE - 1) >> LOG2_BRICK_SIZE;
+
+  // bit b of the x, y, z coordinate goes to bit 3b+2, 3b+1, 3b of the Morton code
+  for (int i=0; i<BRICK_SIZE; ++i)
+  {
+    for (int dim=0; dim<3; ++dim)
+    {
+      morton_[dim][i] = 0;
+      for (int b=0; b<LOG2_BRICK_SIZE; ++b)
+      {
+        if (i & (1 << b))
+          morton_[dim][i] |= 1 << (3*b + 2 - dim);
+      }
+    }
+  }
+}
+
+template<int LOG2_BRICK_SIZE>
+inline int BrickedVoxelStorage<LOG2_BRICK_SIZE>::ref(int x, int y, int z) const
+{
+  int brick = ((x >> LOG2_BRICK_SIZE)*num_bricks_[1] + (y >> LOG2_BRICK_SIZE))*num_bricks_[2] + (z >> LOG2_BRICK_SIZE);
+  return (brick << (3*LOG2_BRICK_SIZE)) |
+      morton_[0][x & BRICK_MASK] | morton_[1][y & BRICK_MASK] | morton_[2][z & BRICK_MASK];
+}
+
+template<int LOG2_BRICK_SIZE>
+inline int BrickedVoxelStorage<LOG2_BRICK_SIZE>::getNumAllocatedCells() const
+{
+  return (num_bricks_[0]*num_bricks_[1]*num_bricks_[2]) << (3*LOG2_BRICK_SIZE);
+}
+
 //////////////////////////// template function definitions follow //////////////////
 
-template<typename T>
-VoxelGrid<T>::VoxelGrid(double size_x, double size_y, double size_z, double resolution,
+template<typename T, typename Storage>
+VoxelGrid<T, Storage>::VoxelGrid(double size_x, double size_y, double size_z, double resolution,
     double origin_x, double origin_y, double origin_z, T default_object)
 {
   size_[DIM_X] = size_x;
@@ -188,20 +302,22 @@ VoxelGrid<T>::VoxelGrid(double size_x, double size_y, double size_z, double reso
 
   stride1_ = num_cells_[DIM_Y]*num_cells_[DIM_Z];
   stride2_ = num_cells_[DIM_Z];
+  storage_.initialize(num_cells_);
+  num_cells_allocated_ = storage_.getNumAllocatedCells();
 
   // initialize the data:
-  data_ = new T[num_cells_total_];
+  data_ = new T[num_cells_allocated_];
 
 }
 
-template<typename T>
-VoxelGrid<T>::~VoxelGrid()
+template<typename T, typename Storage>
+VoxelGrid<T, Storage>::~VoxelGrid()
 {
   delete[] data_;
 }
 
-template<typename T>
-inline bool VoxelGrid<T>::isCellValid(int x, int y, int z) const
+template<typename T, typename Storage>
+inline bool VoxelGrid<T, Storage>::isCellValid(int x, int y, int z) const
 {
   return (
       x>=0 && x<num_cells_[DIM_X] &&
@@ -209,44 +325,44 @@ inline bool VoxelGrid<T>::isCellValid(int x, int y, int z) const
       z>=0 && z<num_cells_[DIM_Z]);
 }
 
-template<typename T>
-inline bool VoxelGrid<T>::isCellValid(Dimension dim, int cell) const
+template<typename T, typename Storage>
+inline bool VoxelGrid<T, Storage>::isCellValid(Dimension dim, int cell) const
 {
   return cell>=0 && cell<num_cells_[dim];
 }
 
-template<typename T>
-inline int VoxelGrid<T>::ref(int x, int y, int z) const
+template<typename T, typename Storage>
+inline int VoxelGrid<T, Storage>::ref(int x, int y, int z) const
 {
-  return x*stride1_ + y*stride2_ + z;
+  return storage_.ref(x,y,z);
 }
 
-template<typename T>
-inline double VoxelGrid<T>::getSize(Dimension dim) const
+template<typename T, typename Storage>
+inline double VoxelGrid<T, Storage>::getSize(Dimension dim) const
 {
   return size_[dim];
 }
 
-template<typename T>
-inline double VoxelGrid<T>::getResolution(Dimension dim) const
+template<typename T, typename Storage>
+inline double VoxelGrid<T, Storage>::getResolution(Dimension dim) const
 {
   return resolution_[dim];
 }
 
-template<typename T>
-inline double VoxelGrid<T>::getOrigin(Dimension dim) const
+template<typename T, typename Storage>
+inline double VoxelGrid<T, Storage>::getOrigin(Dimension dim) const
 {
   return origin_[dim];
 }
 
-template<typename T>
-inline int VoxelGrid<T>::getNumCells(Dimension dim) const
+template<typename T, typename Storage>
+inline int VoxelGrid<T, Storage>::getNumCells(Dimension dim) const
 {
   return num_cells_[dim];
 }
 
-template<typename T>
-inline const T& VoxelGrid<T>::operator()(double x, double y, double z) const
+template<typename T, typename Storage>
+inline const T& VoxelGrid<T, Storage>::operator()(double x, double y, double z) const
 {
   int cellX = getCellFromLocation(DIM_X, x);
   int cellY = getCellFromLocation(DIM_Y, y);
@@ -256,45 +372,45 @@ inline const T& VoxelGrid<T>::operator()(double x, double y, double z) const
   return getCell(cellX, cellY, cellZ);
 }
 
-template<typename T>
-inline T& VoxelGrid<T>::getCell(int x, int y, int z)
+template<typename T, typename Storage>
+inline T& VoxelGrid<T, Storage>::getCell(int x, int y, int z)
 {
   return data_[ref(x,y,z)];
 }
 
-template<typename T>
-inline const T& VoxelGrid<T>::getCell(int x, int y, int z) const
+template<typename T, typename Storage>
+inline const T& VoxelGrid<T, Storage>::getCell(int x, int y, int z) const
 {
   return data_[ref(x,y,z)];
 }
 
-template<typename T>
-inline void VoxelGrid<T>::setCell(int x, int y, int z, T& obj)
+template<typename T, typename Storage>
+inline void VoxelGrid<T, Storage>::setCell(int x, int y, int z, T& obj)
 {
   data_[ref(x,y,z)] = obj;
 }
 
-template<typename T>
-inline int VoxelGrid<T>::getCellFromLocation(Dimension dim, double loc) const
+template<typename T, typename Storage>
+inline int VoxelGrid<T, Storage>::getCellFromLocation(Dimension dim, double loc) const
 {
   return int(round((loc-origin_[dim])/resolution_[dim]));
 }
 
-template<typename T>
-inline double VoxelGrid<T>::getLocationFromCell(Dimension dim, int cell) const
+template<typename T, typename Storage>
+inline double VoxelGrid<T, Storage>::getLocationFromCell(Dimension dim, int cell) const
 {
   return origin_[dim] + resolution_[dim]*(double(cell));
 }
 
 
-template<typename T>
-inline void VoxelGrid<T>::reset(T initial)
+template<typename T, typename Storage>
+inline void VoxelGrid<T, Storage>::reset(T initial)
 {
-  std::fill(data_, data_+num_cells_total_, initial);
+  std::fill(data_, data_+num_cells_allocated_, initial);
 }
 
-template<typename T>
-inline bool VoxelGrid<T>::gridToWorld(int x, int y, int z, double& world_x, double& world_y, double& world_z) const
+template<typename T, typename Storage>
+inline bool VoxelGrid<T, Storage>::gridToWorld(int x, int y, int z, double& world_x, double& world_y, double& world_z) const
 {
   world_x = getLocationFromCell(DIM_X, x);
   world_y = getLocationFromCell(DIM_Y, y);
@@ -302,8 +418,8 @@ inline bool VoxelGrid<T>::gridToWorld(int x, int y, int z, double& world_x, doub
   return true;
 }
 
-template<typename T>
-inline bool VoxelGrid<T>::worldToGrid(double world_x, double world_y, double world_z, int& x, int& y, int& z) const
+template<typename T, typename Storage>
+inline bool VoxelGrid<T, Storage>::worldToGrid(double world_x, double world_y, double world_z, int& x, int& y, int& z) const
 {
   x = getCellFromLocation(DIM_X, world_x);
   y = getCellFromLocation(DIM_Y, world_y);
@@ -36,6 +36,7 @@
 
 #include <distance_field/pf_distance_field.h>
 #include <limits>
+#include <algorithm>
 
 namespace distance_field
 {
@@ -52,7 +53,7 @@ PFDistanceField::~PFDistanceField()
 {
 }
 
-void PFDistanceField::addPointsToField(const std::vector<tf::Vector3> points)
+void PFDistanceField::addPointsToField(const std::vector<tf::Vector3>& points)
 {
   int x, y, z;
   float init = 0.0;
@@ -68,69 +69,82 @@ void PFDistanceField::addPointsToField(const std::vector<tf::Vector3> points)
 
 void PFDistanceField::computeDT()
 {
+  const int nx = num_cells_[DIM_X];
+  const int ny = num_cells_[DIM_Y];
+  const int nz = num_cells_[DIM_Z];
 
-  size_t nx = num_cells_[DIM_X];
-  size_t ny = num_cells_[DIM_Y];
-  size_t nz = num_cells_[DIM_Z];
+  const int maxdim = std::max( nx, std::max(ny, nz) );
+  const int num_z_blocks = (nz + DT_BLOCK_SIZE - 1) / DT_BLOCK_SIZE;
 
-    size_t     maxdim = std::max( nx, std::max(ny, nz) );
-    FloatArray f(maxdim), ft(maxdim), zz(maxdim+1);
+  // The lines of each pass are independent, so they are distributed over threads.
+  // Lines along z are contiguous in memory. Lines along y and x are gathered in blocks
+  // of DT_BLOCK_SIZE neighboring z lines such that every cache line is read only once.
+#pragma omp parallel
+  {
+    FloatArray f(DT_BLOCK_SIZE*maxdim), ft(maxdim), zz(maxdim+1);
     IntArray   v(maxdim);
 
     // along z
-    for (size_t y=0; y<ny; ++y) {
-        for (size_t x=0; x<nx; ++x) {
-            for (size_t z=0; z<nz; ++z) {
-                f[z] = getCell(x,y,z);
-            }
-            dt(f, nz, ft, v, zz);
-            for (size_t z=0; z<nz; ++z) {
-                setCell(x,y,z,ft[z]);
-            }
-        }
+#pragma omp for schedule(static)
+    for (int xy=0; xy<nx*ny; ++xy)
+    {
+      float* line = data_ + xy*stride2_;
+      dt(line, nz, &ft[0], &v[0], &zz[0]);
+      std::copy(ft.begin(), ft.begin()+nz, line);
     }
 
     // along y
-    for (size_t z=0; z<nz; ++z) {
-        for (size_t x=0; x<nx; ++x) {
-            for (size_t y=0; y<ny; ++y) {
-                f[y] = getCell(x,y,z);
-            }
-            dt(f, ny, ft, v, zz);
-            for (size_t y=0; y<ny; ++y) {
-                setCell(x,y,z,ft[y]);
-            }
-        }
+#pragma omp for schedule(static)
+    for (int b=0; b<nx*num_z_blocks; ++b)
+    {
+      int x = b / num_z_blocks;
+      int z = (b % num_z_blocks) * DT_BLOCK_SIZE;
+      dtBlock(data_ + ref(x,0,z), stride2_, ny, std::min(DT_BLOCK_SIZE, nz-z), &f[0], &ft[0], &v[0], &zz[0]);
     }
 
     // along x
-    for (size_t z=0; z<nz; ++z) {
-        for (size_t y=0; y<ny; ++y) {
-            for (size_t x=0; x<nx; ++x) {
-                f[x] = getCell(x,y,z);
-            }
-            dt(f, nx, ft, v, zz);
-            for (size_t x=0; x<nx; ++x) {
-                setCell(x,y,z,ft[x]);
-            }
-        }
+#pragma omp for schedule(static)
+    for (int b=0; b<ny*num_z_blocks; ++b)
+    {
+      int y = b / num_z_blocks;
+      int z = (b % num_z_blocks) * DT_BLOCK_SIZE;
+      dtBlock(data_ + ref(0,y,z), stride1_, nx, std::min(DT_BLOCK_SIZE, nz-z), &f[0], &ft[0], &v[0], &zz[0]);
     }
+  }
 
 }
 
+void PFDistanceField::dtBlock(float* block, int stride, int n, int num_lines,
+                              float* f, float* ft, int* v, float* z) const
+{
+  // gather, line j goes to f[j*n]
+  for (int i=0; i<n; ++i) {
+    const float* row = block + i*stride;
+    for (int j=0; j<num_lines; ++j) {
+      f[j*n+i] = row[j];
+    }
+  }
+
+  for (int j=0; j<num_lines; ++j) {
+    dt(f+j*n, n, ft, v, z);
+    std::copy(ft, ft+n, f+j*n);
+  }
+
+  // scatter
+  for (int i=0; i<n; ++i) {
+    float* row = block + i*stride;
+    for (int j=0; j<num_lines; ++j) {
+      row[j] = f[j*n+i];
+    }
+  }
+}
 
-void PFDistanceField::dt(const FloatArray& f,
-        size_t nn,
-        FloatArray& ft,
-        IntArray& v,
-        FloatArray& z) {
 
-/*    assert(f.size() >= nn);
-    assert(ft.size() >= nn);
-    assert(v.size() >= nn);
-    assert(z.size() >= nn+1);
-*/
-    int n = nn;
+void PFDistanceField::dt(const float* f,
+        int n,
+        float* ft,
+        int* v,
+        float* z) const {
 
     int k = 0;
 
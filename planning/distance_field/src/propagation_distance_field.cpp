@@ -36,6 +36,9 @@
 
 #include <distance_field/propagation_distance_field.h>
 #include <visualization_msgs/Marker.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace distance_field
 {
@@ -46,14 +49,26 @@ PropagationDistanceField::~PropagationDistanceField()
 
 PropagationDistanceField::PropagationDistanceField(double size_x, double size_y, double size_z, double resolution,
     double origin_x, double origin_y, double origin_z, double max_distance):
-      DistanceField<PropDistanceFieldVoxel>(size_x, size_y, size_z, resolution, origin_x, origin_y, origin_z, PropDistanceFieldVoxel(max_distance))
+      DistanceField<PropDistanceFieldVoxel, PropDistanceFieldStorage>(size_x, size_y, size_z, resolution, origin_x, origin_y, origin_z, PropDistanceFieldVoxel(max_distance))
 {
   max_distance_ = max_distance;
   int max_dist_int = ceil(max_distance_/resolution);
   max_distance_sq_ = (max_dist_int*max_dist_int);
   initNeighborhoods();
 
-  bucket_queue_.resize(max_distance_sq_+1);
+  num_threads_ = 1;
+#ifdef _OPENMP
+  num_threads_ = omp_get_max_threads();
+#endif
+  bucket_queues_.resize(num_threads_);
+  candidates_.resize(num_threads_);
+  for (int t=0; t<num_threads_; ++t)
+  {
+    bucket_queues_[t].resize(max_distance_sq_+1);
+    candidates_[t].resize(num_threads_);
+  }
+
+  obstacle_flags_.resize(num_cells_allocated_, 0);
 
   // create a sqrt table:
   sqrt_table_.resize(max_distance_sq_+1);
@@ -69,15 +84,30 @@ int PropagationDistanceField::eucDistSq(int3 point1, int3 point2)
   return dx*dx + dy*dy + dz*dz;
 }
 
+bool PropagationDistanceField::insertObstacleVoxel(const int3& loc, bool mark_seen)
+{
+  unsigned char& flags = obstacle_flags_[ref(loc.x(), loc.y(), loc.z())];
+  const unsigned char seen = mark_seen ? SEEN : 0;
+  if (flags & OBSTACLE)
+  {
+    flags |= seen;
+    return false;
+  }
+  flags = OBSTACLE | seen;
+  object_voxel_locations_.push_back(loc);
+  return true;
+}
+
 void PropagationDistanceField::updatePointsInField(const std::vector<tf::Vector3>& points, bool iterative)
 {
   if( iterative )
   {
-    VoxelSet points_added;
-    VoxelSet points_removed(object_voxel_locations_);
+    VoxelList points_added;
+    VoxelList points_removed;
+    const unsigned int num_old_voxels = object_voxel_locations_.size();
 
-    // Compare and figure out what points are new,
-    // and what points are to be deleted
+    // Mark all points that are obstacles now (SEEN), new obstacles
+    // are appended to object_voxel_locations_
     for( unsigned int i=0; i<points.size(); i++)
     {
       // Convert to voxel coordinates
@@ -86,38 +116,43 @@ void PropagationDistanceField::updatePointsInField(const std::vector<tf::Vector3
                                 voxel_loc.x(), voxel_loc.y(), voxel_loc.z() );
       if( valid )
       {
-        if( iterative )
+        if( insertObstacleVoxel(voxel_loc, true) )
         {
-          bool already_obstacle_voxel = ( object_voxel_locations_.find(voxel_loc) != object_voxel_locations_.end() );
-          if( !already_obstacle_voxel )
-          {
-            // Not already in set of existing obstacles, so add to voxel list
-            object_voxel_locations_.insert(voxel_loc);
-
-            // Add point to the set or expansion
-            points_added.insert(voxel_loc);
-          }
-          else
-          {
-            // Already an existing obstacle, so take off removal list
-            points_removed.erase(voxel_loc);
-          }
-        }
-        else
-        {
-          object_voxel_locations_.insert(voxel_loc);
-          points_added.insert(voxel_loc);
+          // Add point to the set or expansion
+          points_added.push_back(voxel_loc);
         }
       }
     }
 
+    // Old obstacles that have not been seen are to be deleted
+    unsigned int num_kept = 0;
+    for( unsigned int i=0; i<object_voxel_locations_.size(); i++)
+    {
+      const int3& loc = object_voxel_locations_[i];
+      unsigned char& flags = obstacle_flags_[ref(loc.x(), loc.y(), loc.z())];
+      if( i < num_old_voxels && !(flags & SEEN) )
+      {
+        flags = 0;
+        points_removed.push_back(loc);
+      }
+      else
+      {
+        flags = OBSTACLE;
+        object_voxel_locations_[num_kept++] = loc;
+      }
+    }
+    object_voxel_locations_.resize(num_kept);
+
+    // keep the (z,y,x) processing order of the previous set based implementation
+    std::sort(points_removed.begin(), points_removed.end(), compareInt3());
+    std::sort(points_added.begin(), points_added.end(), compareInt3());
+
    removeObstacleVoxels( points_removed );
    addNewObstacleVoxels( points_added );
   }
 
   else	// !iterative
   {
-    VoxelSet points_added;
     reset();
 
     for( unsigned int i=0; i<points.size(); i++)
@@ -128,17 +163,18 @@ void PropagationDistanceField::updatePointsInField(const std::vector<tf::Vector3
                                 voxel_loc.x(), voxel_loc.y(), voxel_loc.z() );
       if( valid )
       {
-        object_voxel_locations_.insert(voxel_loc);
-        points_added.insert(voxel_loc);
+        insertObstacleVoxel(voxel_loc, false);
       }
     }
+    VoxelList points_added(object_voxel_locations_);
+    std::sort(points_added.begin(), points_added.end(), compareInt3());
     addNewObstacleVoxels( points_added );
   }
 }
 
 void PropagationDistanceField::addPointsToField(const std::vector<tf::Vector3>& points)
 {
-  VoxelSet voxel_locs;
+  VoxelList voxel_locs;
 
   for( unsigned int i=0; i<points.size(); i++)
   {
@@ -150,31 +186,29 @@ void PropagationDistanceField::addPointsToField(const std::vector<tf::Vector3>&
     if( valid )
     {
       //ROS_INFO("Adding %f, %f, %f to DF", points[i].x(), points[i].y(), points[i].z());
-      bool already_obstacle_voxel = ( object_voxel_locations_.find(voxel_loc) != object_voxel_locations_.end() );
-      if( !already_obstacle_voxel )
+      // do not mark SEEN here, a stale SEEN bit would keep the voxel alive in the next iterative update
+      if( insertObstacleVoxel(voxel_loc, false) )
       {
-        // Not already in set of existing obstacles, so add to voxel list
-        object_voxel_locations_.insert(voxel_loc);
-
         // Add point to the queue for expansion
-        voxel_locs.insert(voxel_loc);
+        voxel_locs.push_back(voxel_loc);
       }
     }
   }
 
+  std::sort(voxel_locs.begin(), voxel_locs.end(), compareInt3());
   addNewObstacleVoxels( voxel_locs );
 }
 
-void PropagationDistanceField::addNewObstacleVoxels(const VoxelSet& locations)
+void PropagationDistanceField::addNewObstacleVoxels(const VoxelList& locations)
 {
   int x, y, z;
   int initial_update_direction = getDirectionNumber(0,0,0);
-  bucket_queue_[0].reserve(locations.size());
+  std::vector<PropDistanceFieldVoxel*>& bucket = bucket_queues_[0][0];
+  bucket.reserve(bucket.size() + locations.size());
 
-  VoxelSet::const_iterator it = locations.begin();
-  for( it=locations.begin(); it!=locations.end(); ++it)
+  for( unsigned int i=0; i<locations.size(); i++)
   {
-    int3 loc = *it;
+    const int3& loc = locations[i];
     x = loc.x();
     y = loc.y();
     z = loc.z();
@@ -186,25 +220,25 @@ void PropagationDistanceField::addNewObstacleVoxels(const VoxelSet& locations)
     voxel.closest_point_ = loc;
     voxel.location_ = loc;
     voxel.update_direction_ = initial_update_direction;
-    bucket_queue_[0].push_back(&voxel);
+    bucket.push_back(&voxel);
   }
 
   propogate();
 }
 
-void PropagationDistanceField::removeObstacleVoxels(const VoxelSet& locations )
+void PropagationDistanceField::removeObstacleVoxels(const VoxelList& locations )
 {
-  std::vector<int3> stack;
+  VoxelList& stack = remove_stack_;
   int initial_update_direction = getDirectionNumber(0,0,0);
+  std::vector<PropDistanceFieldVoxel*>& bucket = bucket_queues_[0][0];
 
-  stack.reserve( num_cells_[DIM_X] * num_cells_[DIM_Y] * num_cells_[DIM_Z] );
-  bucket_queue_[0].reserve(locations.size());
+  stack.clear();
+  bucket.reserve(bucket.size() + locations.size());
 
   // First reset the obstacle voxels,
-  VoxelSet::const_iterator it = locations.begin();
-  for( it=locations.begin(); it!=locations.end(); ++it)
+  for( unsigned int i=0; i<locations.size(); i++)
   {
-    int3 loc = *it;
+    const int3& loc = locations[i];
     bool valid = isCellValid( loc.x(), loc.y(), loc.z());
     if (!valid)
       continue;
@@ -231,6 +265,8 @@ void PropagationDistanceField::removeObstacleVoxels(const VoxelSet& locations )
       {
         PropDistanceFieldVoxel& nvoxel = getCell(nloc.x(), nloc.y(), nloc.z());
         int3& close_point = nvoxel.closest_point_;
+        if( !isCellValid(close_point.x(), close_point.y(), close_point.z()) )
+          continue;
         PropDistanceFieldVoxel& closest_point_voxel = getCell( close_point.x(), close_point.y(), close_point.z() );
 
         if( closest_point_voxel.distance_square_ != 0 )
@@ -246,7 +282,7 @@ void PropagationDistanceField::removeObstacleVoxels(const VoxelSet& locations )
         }
         else
         {	// add to queue so we can propogate the values
-          bucket_queue_[0].push_back(&nvoxel);
+          bucket.push_back(&nvoxel);
         }
       }
     }
@@ -255,81 +291,167 @@ void PropagationDistanceField::removeObstacleVoxels(const VoxelSet& locations )
   propogate();
 }
 
-void PropagationDistanceField::propogate()
+bool PropagationDistanceField::gatherBucket(int i)
+{
+  current_bucket_.clear();
+  for (int t=0; t<num_threads_; ++t)
+  {
+    std::vector<PropDistanceFieldVoxel*>& bucket = bucket_queues_[t][i];
+    current_bucket_.insert(current_bucket_.end(), bucket.begin(), bucket.end());
+    bucket.clear();
+  }
+  return !current_bucket_.empty();
+}
+
+void PropagationDistanceField::collectCandidates(int i, int thread, int num_threads)
 {
   int x, y, z, nx, ny, nz;
   int3 loc;
+  PropagationCandidate candidate;
 
-  // now process the queue:
-  for (unsigned int i=0; i<bucket_queue_.size(); ++i)
+  std::vector<std::vector<PropagationCandidate> >& candidates = candidates_[thread];
+  for (int t=0; t<num_threads; ++t)
+    candidates[t].clear();
+
+  // select the neighborhood list based on the update direction:
+  int D = i;
+  if (D>1)
+    D=1;
+
+  // contiguous chunk of the bucket, such that candidates of thread 0, 1, ... are in queue order
+  const int bucket_size = current_bucket_.size();
+  const int begin = (bucket_size * thread) / num_threads;
+  const int end = (bucket_size * (thread + 1)) / num_threads;
+  const int num_cells_x = num_cells_[DIM_X];
+
+  for (int b=begin; b<end; ++b)
   {
-    std::vector<PropDistanceFieldVoxel*>::iterator list_it = bucket_queue_[i].begin();
-    while(list_it!=bucket_queue_[i].end())
+    PropDistanceFieldVoxel* vptr = current_bucket_[b];
+
+    x = vptr->location_.x();
+    y = vptr->location_.y();
+    z = vptr->location_.z();
+
+    // avoid a possible segfault situation:
+    if (vptr->update_direction_<0 || vptr->update_direction_>26)
     {
-      PropDistanceFieldVoxel* vptr = *list_it;
+ //     ROS_WARN("Invalid update direction detected: %d", vptr->update_direction_);
+      continue;
+    }
 
-      x = vptr->location_.x();
-      y = vptr->location_.y();
-      z = vptr->location_.z();
+    const std::vector<int3>& neighborhood = neighborhoods_[D][vptr->update_direction_];
 
-      // select the neighborhood list based on the update direction:
-      std::vector<int3 >* neighborhood;
-      int D = i;
-      if (D>1)
-        D=1;
-      // avoid a possible segfault situation:
-      if (vptr->update_direction_<0 || vptr->update_direction_>26)
-      {
-   //     ROS_WARN("Invalid update direction detected: %d", vptr->update_direction_);
-        ++list_it;
+    for (unsigned int n=0; n<neighborhood.size(); n++)
+    {
+      int dx = neighborhood[n].x();
+      int dy = neighborhood[n].y();
+      int dz = neighborhood[n].z();
+      nx = x + dx;
+      ny = y + dy;
+      nz = z + dz;
+      if (!isCellValid(nx,ny,nz))
         continue;
-      }
-
-      neighborhood = &neighborhoods_[D][vptr->update_direction_];
 
-      for (unsigned int n=0; n<neighborhood->size(); n++)
+      // calculate the neighbor's new distance based on my closest filled voxel:
+      PropDistanceFieldVoxel* neighbor = &getCell(nx, ny, nz);
+      loc.x() = nx;
+      loc.y() = ny;
+      loc.z() = nz;
+      int new_distance_sq = eucDistSq(vptr->closest_point_, loc);
+      if (new_distance_sq > max_distance_sq_)
+        continue;
+      if (new_distance_sq < neighbor->distance_square_)
       {
-        int dx = (*neighborhood)[n].x();
-        int dy = (*neighborhood)[n].y();
-        int dz = (*neighborhood)[n].z();
-        nx = x + dx;
-        ny = y + dy;
-        nz = z + dz;
-        if (!isCellValid(nx,ny,nz))
-          continue;
-
-        // the real update code:
-        // calculate the neighbor's new distance based on my closest filled voxel:
-        PropDistanceFieldVoxel* neighbor = &getCell(nx, ny, nz);
-        loc.x() = nx;
-        loc.y() = ny;
-        loc.z() = nz;
-        int new_distance_sq = eucDistSq(vptr->closest_point_, loc);
-        if (new_distance_sq > max_distance_sq_)
-          continue;
-        if (new_distance_sq < neighbor->distance_square_)
+        if (num_threads == 1)
         {
-          // update the neighboring voxel
+          // no other thread reads the grid, update the neighboring voxel right away
           neighbor->distance_square_ = new_distance_sq;
           neighbor->closest_point_ = vptr->closest_point_;
           neighbor->location_ = loc;
           neighbor->update_direction_ = getDirectionNumber(dx, dy, dz);
-
-          // and put it in the queue:
-          bucket_queue_[new_distance_sq].push_back(neighbor);
+          bucket_queues_[thread][new_distance_sq].push_back(neighbor);
+          continue;
         }
+        candidate.voxel_ = neighbor;
+        candidate.location_ = loc;
+        candidate.closest_point_ = vptr->closest_point_;
+        candidate.distance_square_ = new_distance_sq;
+        candidate.update_direction_ = getDirectionNumber(dx, dy, dz);
+        candidates[(nx * num_threads) / num_cells_x].push_back(candidate);
       }
+    }
+  }
+}
 
-      ++list_it;
+void PropagationDistanceField::applyCandidates(int thread, int num_threads)
+{
+  std::vector<std::vector<PropDistanceFieldVoxel*> >& bucket_queue = bucket_queues_[thread];
+  for (int t=0; t<num_threads; ++t)
+  {
+    const std::vector<PropagationCandidate>& candidates = candidates_[t][thread];
+    for (unsigned int c=0; c<candidates.size(); ++c)
+    {
+      const PropagationCandidate& candidate = candidates[c];
+      PropDistanceFieldVoxel* neighbor = candidate.voxel_;
+      // the real update code:
+      if (candidate.distance_square_ < neighbor->distance_square_)
+      {
+        // update the neighboring voxel
+        neighbor->distance_square_ = candidate.distance_square_;
+        neighbor->closest_point_ = candidate.closest_point_;
+        neighbor->location_ = candidate.location_;
+        neighbor->update_direction_ = candidate.update_direction_;
+
+        // and put it in the queue:
+        bucket_queue[candidate.distance_square_].push_back(neighbor);
+      }
     }
-    bucket_queue_[i].clear();
   }
+}
+
+void PropagationDistanceField::propogate()
+{
+  // now process the queue. Each bucket is processed in two phases: first, the
+  // voxels of the bucket are split into contiguous chunks and each thread collects
+  // the updates of the neighbors of its chunk. Second, each thread applies the
+  // updates that fall into its own slab along x, in the order of the bucket.
+  // Hence, no two threads write to the same voxel and the result does not depend
+  // on thread scheduling. Small buckets are propagated by a single thread, which
+  // updates the neighbors directly.
+  for (int i=0; i<=max_distance_sq_; ++i)
+  {
+    // voxels that are updated to the same distance are appended to the current bucket
+    while (gatherBucket(i))
+    {
+      int num_threads = std::min(num_threads_, std::min(num_cells_[DIM_X],
+                                 static_cast<int>(current_bucket_.size()) / MIN_VOXELS_PER_THREAD));
+      if (num_threads < 1)
+        num_threads = 1;
 
+#pragma omp parallel num_threads(num_threads) if(num_threads > 1)
+      {
+        int thread = 0;
+        int team_size = 1;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+        team_size = omp_get_num_threads();
+#endif
+        collectCandidates(i, thread, team_size);
+#pragma omp barrier
+        applyCandidates(thread, team_size);
+      }
+    }
+  }
 }
 
 void PropagationDistanceField::reset()
 {
-  VoxelGrid<PropDistanceFieldVoxel>::reset(PropDistanceFieldVoxel(max_distance_sq_));
+  VoxelGrid<PropDistanceFieldVoxel, PropDistanceFieldStorage>::reset(PropDistanceFieldVoxel(max_distance_sq_));
+  std::fill(obstacle_flags_.begin(), obstacle_flags_.end(), 0);
+  object_voxel_locations_.clear();
+  for (int t=0; t<num_threads_; ++t)
+    for (unsigned int i=0; i<bucket_queues_[t].size(); ++i)
+      bucket_queues_[t][i].clear();
 }
 
 void PropagationDistanceField::initNeighborhoods()
@@ -406,7 +528,7 @@ SignedPropagationDistanceField::~SignedPropagationDistanceField()
 
 SignedPropagationDistanceField::SignedPropagationDistanceField(double size_x, double size_y, double size_z, double resolution,
     double origin_x, double origin_y, double origin_z, double max_distance):
-      DistanceField<SignedPropDistanceFieldVoxel>(size_x, size_y, size_z, resolution, origin_x, origin_y, origin_z, SignedPropDistanceFieldVoxel(max_distance,0))
+      DistanceField<SignedPropDistanceFieldVoxel, PropDistanceFieldStorage>(size_x, size_y, size_z, resolution, origin_x, origin_y, origin_z, SignedPropDistanceFieldVoxel(max_distance,0))
 {
   max_distance_ = max_distance;
   int max_dist_int = ceil(max_distance_/resolution);
@@ -642,7 +764,7 @@ void SignedPropagationDistanceField::addPointsToField(const std::vector<tf::Vect
 
 void SignedPropagationDistanceField::reset()
 {
-  VoxelGrid<SignedPropDistanceFieldVoxel>::reset(SignedPropDistanceFieldVoxel(max_distance_sq_, 0));
+  VoxelGrid<SignedPropDistanceFieldVoxel, PropDistanceFieldStorage>::reset(SignedPropDistanceFieldVoxel(max_distance_sq_, 0));
 }
 
 void SignedPropagationDistanceField::initNeighborhoods()
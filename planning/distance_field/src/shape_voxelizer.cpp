@@ -0,0 +1,270 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2009, Willow Garage, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <distance_field/shape_voxelizer.h>
+#include <limits>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace distance_field
+{
+
+// restricts [z_min, z_max] to the z for which |q + z*d| <= h, returns false if the result is empty
+static bool clipToSlab(double q, double d, double h, double& z_min, double& z_max)
+{
+  if (fabs(d) < 1e-12)
+    return fabs(q) <= h;
+  double z0 = (-h - q) / d;
+  double z1 = (h - q) / d;
+  if (z0 > z1)
+    std::swap(z0, z1);
+  z_min = std::max(z_min, z0);
+  z_max = std::min(z_max, z1);
+  return z_min <= z_max;
+}
+
+// restricts [z_min, z_max] to the z for which (qx + z*dx)^2 + (qy + z*dy)^2 <= r^2, returns false if the result is empty
+static bool clipToDisk(double qx, double qy, double dx, double dy, double r, double& z_min, double& z_max)
+{
+  double a = dx*dx + dy*dy;
+  double b = 2.0*(qx*dx + qy*dy);
+  double c = qx*qx + qy*qy - r*r;
+  if (a < 1e-12)
+    return c <= 0.0;
+  double discriminant = b*b - 4.0*a*c;
+  if (discriminant < 0.0)
+    return false;
+  double sqrt_discriminant = sqrt(discriminant);
+  z_min = std::max(z_min, (-b - sqrt_discriminant) / (2.0*a));
+  z_max = std::min(z_max, (-b + sqrt_discriminant) / (2.0*a));
+  return z_min <= z_max;
+}
+
+ShapeVoxelizer::ShapeVoxelizer(double origin_x, double origin_y, double origin_z, double resolution,
+                               int num_cells_x, int num_cells_y, int num_cells_z)
+{
+  origin_[0] = origin_x;
+  origin_[1] = origin_y;
+  origin_[2] = origin_z;
+  resolution_ = resolution;
+  num_cells_[0] = num_cells_x;
+  num_cells_[1] = num_cells_y;
+  num_cells_[2] = num_cells_z;
+}
+
+bool ShapeVoxelizer::getCellRange(int dim, double min, double max, int& cell_min, int& cell_max) const
+{
+  cell_min = std::max(0, (int)ceil((min - origin_[dim]) / resolution_));
+  cell_max = std::min(num_cells_[dim] - 1, (int)floor((max - origin_[dim]) / resolution_));
+  return cell_min <= cell_max;
+}
+
+bool ShapeVoxelizer::getColumnRange(const tf::Vector3& center, double radius, int& x_min, int& x_max, int& y_min, int& y_max) const
+{
+  return getCellRange(0, center.x() - radius, center.x() + radius, x_min, x_max)
+      && getCellRange(1, center.y() - radius, center.y() + radius, y_min, y_max);
+}
+
+void ShapeVoxelizer::addVoxelColumn(int x, int y, double z_min, double z_max, std::vector<tf::Vector3>& voxels) const
+{
+  int cell_min, cell_max;
+  if (!getCellRange(2, z_min, z_max, cell_min, cell_max))
+    return;
+  double xw = getLocationFromCell(0, x);
+  double yw = getLocationFromCell(1, y);
+  for (int z=cell_min; z<=cell_max; ++z)
+    voxels.push_back(tf::Vector3(xw, yw, getLocationFromCell(2, z)));
+}
+
+bool ShapeVoxelizer::getVoxelsInShape(const arm_navigation_msgs::Shape& shape, const tf::Transform& pose,
+                                      std::vector<tf::Vector3>& voxels) const
+{
+  const double padding = getPadding();
+  double bounding_radius;
+  tf::Vector3 half_extents(0.0, 0.0, 0.0);
+  double radius = 0.0;
+  if (shape.type == arm_navigation_msgs::Shape::SPHERE && shape.dimensions.size() == 1)
+  {
+    radius = shape.dimensions[0] + padding;
+    bounding_radius = radius;
+  }
+  else if (shape.type == arm_navigation_msgs::Shape::BOX && shape.dimensions.size() == 3)
+  {
+    half_extents = tf::Vector3(shape.dimensions[0]/2.0 + padding, shape.dimensions[1]/2.0 + padding, shape.dimensions[2]/2.0 + padding);
+    bounding_radius = half_extents.length();
+  }
+  else if (shape.type == arm_navigation_msgs::Shape::CYLINDER && shape.dimensions.size() == 2)
+  {
+    radius = shape.dimensions[0] + padding;
+    half_extents = tf::Vector3(radius, radius, shape.dimensions[1]/2.0 + padding);
+    bounding_radius = sqrt(radius*radius + half_extents.z()*half_extents.z());
+  }
+  else
+  {
+    return false;
+  }
+
+  int x_min, x_max, y_min, y_max;
+  if (!getColumnRange(pose.getOrigin(), bounding_radius, x_min, x_max, y_min, y_max))
+    return true;
+
+  // the center line of column (x,y) is p(z) = (xw, yw, z), in the frame of the shape
+  // it is q(z) = q + z*d.
+  tf::Transform inverse_pose = pose.inverse();
+  tf::Vector3 d = inverse_pose.getBasis() * tf::Vector3(0.0, 0.0, 1.0);
+  for (int x=x_min; x<=x_max; ++x)
+  {
+    double xw = getLocationFromCell(0, x);
+    for (int y=y_min; y<=y_max; ++y)
+    {
+      double yw = getLocationFromCell(1, y);
+      tf::Vector3 q = inverse_pose * tf::Vector3(xw, yw, 0.0);
+      double z_min = -std::numeric_limits<double>::max();
+      double z_max = std::numeric_limits<double>::max();
+      bool inside = true;
+      if (shape.type == arm_navigation_msgs::Shape::SPHERE)
+      {
+        double dx = xw - pose.getOrigin().x();
+        double dy = yw - pose.getOrigin().y();
+        double dz2 = radius*radius - dx*dx - dy*dy;
+        inside = (dz2 >= 0.0);
+        if (inside)
+        {
+          z_min = pose.getOrigin().z() - sqrt(dz2);
+          z_max = pose.getOrigin().z() + sqrt(dz2);
+        }
+      }
+      else if (shape.type == arm_navigation_msgs::Shape::BOX)
+      {
+        inside = clipToSlab(q.x(), d.x(), half_extents.x(), z_min, z_max)
+            && clipToSlab(q.y(), d.y(), half_extents.y(), z_min, z_max)
+            && clipToSlab(q.z(), d.z(), half_extents.z(), z_min, z_max);
+      }
+      else // CYLINDER, the axis is the z axis of the shape
+      {
+        inside = clipToSlab(q.z(), d.z(), half_extents.z(), z_min, z_max)
+            && clipToDisk(q.x(), q.y(), d.x(), d.y(), radius, z_min, z_max);
+      }
+      if (inside)
+        addVoxelColumn(x, y, z_min, z_max, voxels);
+    }
+  }
+  return true;
+}
+
+void ShapeVoxelizer::getVoxelsInBody(const shapes::Shape& shape, const tf::Transform& pose, std::vector<tf::Vector3>& voxels) const
+{
+  bodies::Body* body = bodies::createBodyFromShape(&shape);
+  if (body == NULL)
+    return;
+  // the body is padded, the intersections of the rays already include the padding
+  body->setPadding(getPadding());
+  body->setPose(pose);
+  bodies::BoundingSphere bounding_sphere;
+  body->computeBoundingSphere(bounding_sphere);
+
+  // cells of the bounding box of the body
+  int cell_min[3], cell_max[3];
+  for (int dim=0; dim<3; ++dim)
+  {
+    if (!getCellRange(dim, bounding_sphere.center[dim] - bounding_sphere.radius,
+                      bounding_sphere.center[dim] + bounding_sphere.radius, cell_min[dim], cell_max[dim]))
+    {
+      delete body;
+      return;
+    }
+  }
+  int num_cells[3];
+  for (int dim=0; dim<3; ++dim)
+    num_cells[dim] = cell_max[dim] - cell_min[dim] + 1;
+  std::vector<char> occupied(num_cells[0]*num_cells[1]*num_cells[2], 0);
+
+  // one ray per column along each axis, the cells between consecutive pairs of intersections are occupied.
+  // Casting along all axes makes sure that thin parts are hit by at least one set of rays. The columns of
+  // one axis do not share any cell, therefore they can be processed in parallel.
+  for (int axis=0; axis<3; ++axis)
+  {
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+    const int num_columns = num_cells[u] * num_cells[v];
+    tf::Vector3 direction(0.0, 0.0, 0.0);
+    direction[axis] = 1.0;
+    const double start = bounding_sphere.center[axis] - bounding_sphere.radius - resolution_;
+
+#pragma omp parallel
+    {
+      std::vector<tf::Vector3> intersections;
+      std::vector<double> t;
+      int cell[3];
+
+#pragma omp for schedule(static)
+      for (int c=0; c<num_columns; ++c)
+      {
+        cell[u] = cell_min[u] + c / num_cells[v];
+        cell[v] = cell_min[v] + c % num_cells[v];
+        tf::Vector3 origin;
+        origin[axis] = start;
+        origin[u] = getLocationFromCell(u, cell[u]);
+        origin[v] = getLocationFromCell(v, cell[v]);
+
+        intersections.clear();
+        body->intersectsRay(origin, direction, &intersections, 0);
+        t.resize(intersections.size());
+        for (unsigned int i=0; i<intersections.size(); ++i)
+          t[i] = intersections[i][axis];
+        std::sort(t.begin(), t.end());
+        for (unsigned int i=0; i+1<t.size(); i+=2)
+        {
+          int first, last;
+          if (!getCellRange(axis, t[i], t[i+1], first, last))
+            continue;
+          for (cell[axis]=std::max(first, cell_min[axis]); cell[axis]<=std::min(last, cell_max[axis]); ++cell[axis])
+            occupied[((cell[0] - cell_min[0])*num_cells[1] + (cell[1] - cell_min[1]))*num_cells[2] + (cell[2] - cell_min[2])] = 1;
+        }
+      }
+    }
+  }
+  delete body;
+
+  for (int x=0; x<num_cells[0]; ++x)
+    for (int y=0; y<num_cells[1]; ++y)
+      for (int z=0; z<num_cells[2]; ++z)
+        if (occupied[(x*num_cells[1] + y)*num_cells[2] + z])
+          voxels.push_back(tf::Vector3(getLocationFromCell(0, cell_min[0] + x), getLocationFromCell(1, cell_min[1] + y),
+                                       getLocationFromCell(2, cell_min[2] + z)));
+}
+
+} // namespace distance_field
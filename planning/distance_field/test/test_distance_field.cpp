@@ -35,9 +35,11 @@
 /** \author Mrinal Kalakrishnan, Ken Anderson */
 
 #include <gtest/gtest.h>
+#include <limits>
 
 #include <distance_field/voxel_grid.h>
 #include <distance_field/propagation_distance_field.h>
+#include <distance_field/pf_distance_field.h>
 #include <ros/ros.h>
 
 using namespace distance_field;
@@ -150,6 +152,165 @@ TEST(TestPropagationDistanceField, TestAddPoints)
 
 }
 
+TEST(TestPropagationDistanceField, TestIterativeUpdate)
+{
+  // large enough such that the buckets of the wall are propagated in parallel
+  const double size = 2.0;
+  const double res = 0.05;
+  PropagationDistanceField df_iterative( size, size, size, res, origin_x, origin_y, origin_z, max_dist);
+  PropagationDistanceField df_full( size, size, size, res, origin_x, origin_y, origin_z, max_dist);
+  df_iterative.reset();
+
+  int numX = df_iterative.getNumCells(PropagationDistanceField::DIM_X);
+  int numY = df_iterative.getNumCells(PropagationDistanceField::DIM_Y);
+  int numZ = df_iterative.getNumCells(PropagationDistanceField::DIM_Z);
+
+  std::vector<tf::Vector3> points;
+  for (int i=0; i<4; i++)
+  {
+    // a wall that moves along z and a few points that come and go
+    points.clear();
+    for (int x=0; x<numX; x++)
+      for (int y=0; y<numY; y++)
+        points.push_back(tf::Vector3(x*res, y*res, (10+i)*res));
+    points.push_back(tf::Vector3((5+i)*res, 30*res, 30*res));
+    points.push_back(tf::Vector3(30*res, (5+2*i)*res, 35*res));
+    if (i%2 == 0)
+      points.push_back(tf::Vector3(20*res, 20*res, 25*res));
+
+    df_iterative.updatePointsInField(points, true);
+    df_full.updatePointsInField(points, false);
+
+    std::vector<tf::Vector3> query_points;
+    for (int x=0; x<numX; x+=3)
+      query_points.push_back(tf::Vector3(x*res, 0.5*x*res, 12*res));
+    std::vector<double> distances;
+    std::vector<tf::Vector3> gradients;
+    df_iterative.getDistanceGradients(query_points, distances, gradients);
+    ASSERT_EQ(distances.size(), query_points.size());
+    ASSERT_EQ(gradients.size(), query_points.size());
+    for (unsigned int j=0; j<query_points.size(); j++)
+    {
+      double gx, gy, gz;
+      EXPECT_EQ(distances[j], df_full.getDistanceGradient(query_points[j].x(), query_points[j].y(), query_points[j].z(), gx, gy, gz));
+      EXPECT_EQ(gradients[j].x(), gx);
+      EXPECT_EQ(gradients[j].y(), gy);
+      EXPECT_EQ(gradients[j].z(), gz);
+    }
+
+    for (int x=0; x<numX; x++)
+      for (int y=0; y<numY; y++)
+        for (int z=0; z<numZ; z++)
+          ASSERT_EQ(df_iterative.getCell(x,y,z).distance_square_, df_full.getCell(x,y,z).distance_square_);
+  }
+}
+
+TEST(TestPropagationDistanceField, TestAddPointsThenIterativeUpdate)
+{
+  PropagationDistanceField df( width, height, depth, resolution, origin_x, origin_y, origin_z, max_dist);
+  df.reset();
+
+  int numX = df.getNumCells(PropagationDistanceField::DIM_X);
+  int numY = df.getNumCells(PropagationDistanceField::DIM_Y);
+  int numZ = df.getNumCells(PropagationDistanceField::DIM_Z);
+
+  // add point1 twice, the second call re-adds an existing obstacle voxel
+  std::vector<tf::Vector3> points;
+  points.push_back(point1);
+  df.addPointsToField(points);
+  points.push_back(point2);
+  df.addPointsToField(points);
+  check_distance_field( df, points, numX, numY, numZ);
+
+  // an iterative update without point1 has to remove it again
+  points.clear();
+  points.push_back(point2);
+  df.updatePointsInField(points, true);
+  check_distance_field( df, points, numX, numY, numZ);
+}
+
+TEST(TestPFDistanceField, TestAddPoints)
+{
+  // different number of cells along each axis, not a multiple of the block size
+  PFDistanceField df( 1.0, 0.7, 0.45, resolution/2.0, origin_x, origin_y, origin_z);
+  df.reset();
+
+  int numX = df.getNumCells(PFDistanceField::DIM_X);
+  int numY = df.getNumCells(PFDistanceField::DIM_Y);
+  int numZ = df.getNumCells(PFDistanceField::DIM_Z);
+
+  std::vector<tf::Vector3> points;
+  points.push_back(tf::Vector3(0.1, 0.1, 0.1));
+  points.push_back(tf::Vector3(0.8, 0.55, 0.3));
+  points.push_back(tf::Vector3(0.45, 0.0, 0.4));
+  df.addPointsToField(points);
+
+  for (int x=0; x<numX; x++) {
+    for (int y=0; y<numY; y++) {
+      for (int z=0; z<numZ; z++) {
+        int min_dist_square = std::numeric_limits<int>::max();
+        for( unsigned int i=0; i<points.size(); i++) {
+          int px, py, pz;
+          ASSERT_TRUE(df.worldToGrid(points[i].x(), points[i].y(), points[i].z(), px, py, pz));
+          min_dist_square = std::min(dist_sq(px - x, py - y, pz - z), min_dist_square);
+        }
+        ASSERT_FLOAT_EQ(df.getCell(x,y,z), min_dist_square);
+      }
+    }
+  }
+}
+
+TEST(TestPropagationDistanceField, TestInterpolatedDistanceGradients)
+{
+  PropagationDistanceField df( 1.0, 1.0, 1.0, resolution, origin_x, origin_y, origin_z, max_dist);
+  df.reset();
+
+  std::vector<tf::Vector3> points;
+  points.push_back(tf::Vector3(0.3, 0.4, 0.5));
+  points.push_back(tf::Vector3(0.7, 0.6, 0.4));
+  df.addPointsToField(points);
+
+  // at the cell centers, the interpolated distance is the distance of the cell
+  std::vector<double> locations;
+  for (int x=0; x<10; x++)
+    for (int y=0; y<10; y+=3)
+      for (int z=0; z<10; z+=2)
+      {
+        locations.push_back(x*resolution);
+        locations.push_back(y*resolution);
+        locations.push_back(z*resolution);
+      }
+  int num_points = locations.size() / 3;
+  std::vector<double> distances(num_points);
+  df.getInterpolatedDistanceGradients(&locations[0], num_points, &distances[0], (double*)NULL);
+  for (int i=0; i<num_points; i++)
+    EXPECT_NEAR(distances[i], df.getDistance(locations[3*i], locations[3*i+1], locations[3*i+2]), 1e-12);
+
+  // the gradient matches finite differences of the interpolated distance within a cell
+  const double eps = 1e-6;
+  double location[3] = {0.43, 0.52, 0.37};
+  double distance, gradient[3];
+  df.getInterpolatedDistanceGradients(location, 1, &distance, gradient);
+  for (int d=0; d<3; d++)
+  {
+    double shifted[3] = {location[0], location[1], location[2]};
+    double distance_plus, distance_minus;
+    shifted[d] += eps;
+    df.getInterpolatedDistanceGradients(shifted, 1, &distance_plus, (double*)NULL);
+    shifted[d] -= 2.0*eps;
+    df.getInterpolatedDistanceGradients(shifted, 1, &distance_minus, (double*)NULL);
+    EXPECT_NEAR(gradient[d], (distance_plus - distance_minus) / (2.0*eps), 1e-6);
+  }
+
+  // float precision
+  float location_f[3] = {0.43f, 0.52f, 0.37f};
+  float distance_f, gradient_f[3];
+  df.getInterpolatedDistanceGradients(location_f, 1, &distance_f, gradient_f);
+  EXPECT_NEAR(distance_f, distance, 1e-5);
+  for (int d=0; d<3; d++)
+    EXPECT_NEAR(gradient_f[d], gradient[d], 1e-4);
+}
+
 int main(int argc, char **argv){
   testing::InitGoogleTest(&argc, argv);
 
@@ -0,0 +1,261 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2009, Willow Garage, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <set>
+#include <cstdlib>
+#include <cmath>
+
+#include <distance_field/shape_voxelizer.h>
+#include <distance_field/voxel_grid.h>
+
+using namespace distance_field;
+
+static const double RESOLUTION = 0.02;
+static const int NUM_CELLS = 50;
+static const int NUM_RANDOM_SHAPES = 20;
+static const int NUM_SAMPLES = 2000;
+
+typedef std::set<std::vector<int> > CellSet;
+
+static double getRandom(double min, double max)
+{
+  return min + (max - min) * double(rand()) / double(RAND_MAX);
+}
+
+static tf::Transform getRandomPose()
+{
+  tf::Quaternion rotation;
+  rotation.setRPY(getRandom(-M_PI, M_PI), getRandom(-M_PI, M_PI), getRandom(-M_PI, M_PI));
+  return tf::Transform(rotation, tf::Vector3(getRandom(0.3, 0.7), getRandom(0.3, 0.7), getRandom(0.3, 0.7)));
+}
+
+static arm_navigation_msgs::Shape createShape(int type, double d0, double d1 = 0.0, double d2 = 0.0)
+{
+  arm_navigation_msgs::Shape shape;
+  shape.type = type;
+  shape.dimensions.push_back(d0);
+  if (type != arm_navigation_msgs::Shape::SPHERE)
+    shape.dimensions.push_back(d1);
+  if (type == arm_navigation_msgs::Shape::BOX)
+    shape.dimensions.push_back(d2);
+  return shape;
+}
+
+class TestShapeVoxelizer : public testing::Test
+{
+protected:
+
+  TestShapeVoxelizer() :
+    grid_(NUM_CELLS*RESOLUTION, NUM_CELLS*RESOLUTION, NUM_CELLS*RESOLUTION, RESOLUTION, 0.0, 0.0, 0.0, 0),
+    voxelizer_(grid_)
+  {
+  }
+
+  bool getCell(const tf::Vector3& point, std::vector<int>& cell) const
+  {
+    cell.resize(3);
+    return grid_.worldToGrid(point.x(), point.y(), point.z(), cell[0], cell[1], cell[2]);
+  }
+
+  void getCells(const std::vector<tf::Vector3>& voxels, CellSet& cells) const
+  {
+    std::vector<int> cell;
+    for (unsigned int i=0; i<voxels.size(); ++i)
+    {
+      ASSERT_TRUE(getCell(voxels[i], cell));
+      cells.insert(cell);
+    }
+  }
+
+  // point in the frame of the shape, inside the shape padded by padding
+  bool isInside(const arm_navigation_msgs::Shape& shape, const tf::Vector3& q, double padding) const
+  {
+    if (shape.type == arm_navigation_msgs::Shape::SPHERE)
+      return q.length() <= shape.dimensions[0] + padding;
+    if (shape.type == arm_navigation_msgs::Shape::BOX)
+      return fabs(q.x()) <= shape.dimensions[0]/2.0 + padding && fabs(q.y()) <= shape.dimensions[1]/2.0 + padding
+          && fabs(q.z()) <= shape.dimensions[2]/2.0 + padding;
+    return sqrt(q.x()*q.x() + q.y()*q.y()) <= shape.dimensions[0] + padding && fabs(q.z()) <= shape.dimensions[1]/2.0 + padding;
+  }
+
+  // tests the containment of every cell center
+  void getCellsBruteForce(const arm_navigation_msgs::Shape& shape, const tf::Transform& pose, CellSet& cells) const
+  {
+    tf::Transform inverse_pose = pose.inverse();
+    std::vector<int> cell(3);
+    double xw, yw, zw;
+    for (cell[0]=0; cell[0]<NUM_CELLS; ++cell[0])
+      for (cell[1]=0; cell[1]<NUM_CELLS; ++cell[1])
+        for (cell[2]=0; cell[2]<NUM_CELLS; ++cell[2])
+        {
+          grid_.gridToWorld(cell[0], cell[1], cell[2], xw, yw, zw);
+          if (isInside(shape, inverse_pose * tf::Vector3(xw, yw, zw), voxelizer_.getPadding()))
+            cells.insert(cell);
+        }
+  }
+
+  // checks that the cells of random points inside the shape are occupied
+  void expectCovered(const arm_navigation_msgs::Shape& shape, const tf::Transform& pose, const CellSet& cells) const
+  {
+    double extent = shape.dimensions[0];
+    for (unsigned int i=1; i<shape.dimensions.size(); ++i)
+      extent = std::max(extent, shape.dimensions[i]);
+    std::vector<int> cell;
+    int num_samples = 0;
+    while (num_samples < NUM_SAMPLES)
+    {
+      tf::Vector3 q(getRandom(-extent, extent), getRandom(-extent, extent), getRandom(-extent, extent));
+      if (!isInside(shape, q, 0.0))
+        continue;
+      ++num_samples;
+      if (getCell(pose * q, cell))
+      {
+        EXPECT_TRUE(cells.find(cell) != cells.end()) << "Cell " << cell[0] << " " << cell[1] << " " << cell[2] << " is not occupied";
+      }
+    }
+  }
+
+  void testShape(const arm_navigation_msgs::Shape& shape, const tf::Transform& pose)
+  {
+    std::vector<tf::Vector3> voxels;
+    ASSERT_TRUE(voxelizer_.getVoxelsInShape(shape, pose, voxels));
+    CellSet cells;
+    getCells(voxels, cells);
+    EXPECT_EQ(voxels.size(), cells.size()) << "Duplicate voxels";
+    CellSet expected_cells;
+    getCellsBruteForce(shape, pose, expected_cells);
+    EXPECT_TRUE(cells == expected_cells) << "Voxelized " << cells.size() << " cells, brute force " << expected_cells.size();
+    expectCovered(shape, pose, cells);
+  }
+
+  VoxelGrid<int> grid_;
+  ShapeVoxelizer voxelizer_;
+};
+
+TEST_F(TestShapeVoxelizer, TestSpheres)
+{
+  srand(0);
+  for (int i=0; i<NUM_RANDOM_SHAPES; ++i)
+    testShape(createShape(arm_navigation_msgs::Shape::SPHERE, getRandom(0.005, 0.2)), getRandomPose());
+}
+
+TEST_F(TestShapeVoxelizer, TestBoxes)
+{
+  srand(1);
+  for (int i=0; i<NUM_RANDOM_SHAPES; ++i)
+    testShape(createShape(arm_navigation_msgs::Shape::BOX, getRandom(0.005, 0.3), getRandom(0.005, 0.3), getRandom(0.005, 0.3)), getRandomPose());
+}
+
+TEST_F(TestShapeVoxelizer, TestCylinders)
+{
+  srand(2);
+  for (int i=0; i<NUM_RANDOM_SHAPES; ++i)
+    testShape(createShape(arm_navigation_msgs::Shape::CYLINDER, getRandom(0.005, 0.2), getRandom(0.005, 0.3)), getRandomPose());
+}
+
+TEST_F(TestShapeVoxelizer, TestSubResolutionBox)
+{
+  // a 1cm board between two layers of cell centers
+  arm_navigation_msgs::Shape board = createShape(arm_navigation_msgs::Shape::BOX, 0.3, 0.3, 0.01);
+  tf::Transform pose(tf::Quaternion(0.0, 0.0, 0.0, 1.0), tf::Vector3(0.5, 0.5, 0.51));
+  testShape(board, pose);
+
+  std::vector<tf::Vector3> voxels;
+  ASSERT_TRUE(voxelizer_.getVoxelsInShape(board, pose, voxels));
+  CellSet cells;
+  getCells(voxels, cells);
+  std::vector<int> cell(3, 25);
+  EXPECT_TRUE(cells.find(cell) != cells.end());
+  cell[2] = 26;
+  EXPECT_TRUE(cells.find(cell) != cells.end());
+
+  // rotated boards
+  srand(3);
+  for (int i=0; i<NUM_RANDOM_SHAPES; ++i)
+    testShape(createShape(arm_navigation_msgs::Shape::BOX, getRandom(0.1, 0.3), getRandom(0.1, 0.3), 0.005), getRandomPose());
+}
+
+TEST_F(TestShapeVoxelizer, TestBody)
+{
+  // boxes and thin boards voxelized through ray casting, the padding must only be applied once
+  srand(4);
+  for (int i=0; i<NUM_RANDOM_SHAPES; ++i)
+  {
+    double thickness = (i%2 == 0) ? 0.005 : getRandom(0.005, 0.3);
+    arm_navigation_msgs::Shape box_shape = createShape(arm_navigation_msgs::Shape::BOX, getRandom(0.1, 0.3), getRandom(0.1, 0.3), thickness);
+    tf::Transform pose = getRandomPose();
+    shapes::Box box(box_shape.dimensions[0], box_shape.dimensions[1], box_shape.dimensions[2]);
+    std::vector<tf::Vector3> voxels;
+    voxelizer_.getVoxelsInBody(box, pose, voxels);
+    CellSet cells;
+    getCells(voxels, cells);
+    EXPECT_EQ(voxels.size(), cells.size()) << "Duplicate voxels";
+
+    std::vector<tf::Vector3> shape_voxels;
+    ASSERT_TRUE(voxelizer_.getVoxelsInShape(box_shape, pose, shape_voxels));
+    CellSet shape_cells;
+    getCells(shape_voxels, shape_cells);
+    EXPECT_TRUE(cells == shape_cells) << "Body voxelized " << cells.size() << " cells, shape " << shape_cells.size();
+    CellSet expected_cells;
+    getCellsBruteForce(box_shape, pose, expected_cells);
+    EXPECT_TRUE(cells == expected_cells) << "Body voxelized " << cells.size() << " cells, brute force " << expected_cells.size();
+    expectCovered(box_shape, pose, cells);
+  }
+}
+
+TEST_F(TestShapeVoxelizer, TestUnsupportedShapes)
+{
+  std::vector<tf::Vector3> voxels;
+  arm_navigation_msgs::Shape mesh;
+  mesh.type = arm_navigation_msgs::Shape::MESH;
+  tf::Transform pose(tf::Quaternion(0.0, 0.0, 0.0, 1.0), tf::Vector3(0.5, 0.5, 0.5));
+  EXPECT_FALSE(voxelizer_.getVoxelsInShape(mesh, pose, voxels));
+  arm_navigation_msgs::Shape box = createShape(arm_navigation_msgs::Shape::BOX, 0.1, 0.1, 0.1);
+  box.dimensions.pop_back();
+  EXPECT_FALSE(voxelizer_.getVoxelsInShape(box, pose, voxels));
+  EXPECT_TRUE(voxels.empty());
+
+  // shapes outside of the grid
+  box = createShape(arm_navigation_msgs::Shape::BOX, 0.1, 0.1, 0.1);
+  pose.setOrigin(tf::Vector3(-1.0, 0.5, 0.5));
+  EXPECT_TRUE(voxelizer_.getVoxelsInShape(box, pose, voxels));
+  EXPECT_TRUE(voxels.empty());
+}
+
+int main(int argc, char **argv){
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -91,6 +91,40 @@ TEST(TestVoxelGrid, TestReadWrite)
 
 }
 
+TEST(TestVoxelGrid, TestBrickedReadWrite)
+{
+  // number of cells is not a multiple of the brick size
+  typedef VoxelGrid<int, BrickedVoxelStorage<2> > BrickedVoxelGrid;
+  BrickedVoxelGrid vg(0.1,0.06,0.11,0.01,0,0,0, -100);
+
+  int numX = vg.getNumCells(BrickedVoxelGrid::DIM_X);
+  int numY = vg.getNumCells(BrickedVoxelGrid::DIM_Y);
+  int numZ = vg.getNumCells(BrickedVoxelGrid::DIM_Z);
+
+  vg.reset(-1);
+
+  // Set values
+  int i=0;
+  for (int x=0; x<numX; x++)
+    for (int y=0; y<numY; y++)
+      for (int z=0; z<numZ; z++)
+      {
+        EXPECT_EQ(-1, vg.getCell(x,y,z));
+        vg.getCell(x,y,z) = i;
+        i++;
+      }
+
+  // every cell needs to have its own storage
+  i=0;
+  for (int x=0; x<numX; x++)
+    for (int y=0; y<numY; y++)
+      for (int z=0; z<numZ; z++)
+      {
+        EXPECT_EQ(i, vg.getCell(x,y,z));
+        i++;
+      }
+}
+
 int main(int argc, char **argv){
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
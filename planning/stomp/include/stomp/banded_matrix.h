@@ -0,0 +1,127 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2010, Willow Garage, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef STOMP_BANDED_MATRIX_H_
+#define STOMP_BANDED_MATRIX_H_
+
+#include <Eigen/Core>
+
+namespace stomp
+{
+
+/**
+ * \brief Symmetric positive definite matrix with a limited number of non-zero sub-diagonals
+ *
+ * Only the lower band is stored, column-wise: band_(k, j) = A(j+k, j) for k = 0..bandwidth.
+ * After factorize() the banded Cholesky factor L (A = LL^T) is available in the same layout,
+ * and products, solves and samples cost O(size*bandwidth) instead of O(size^2).
+ */
+class BandedMatrix
+{
+public:
+  BandedMatrix();
+  virtual ~BandedMatrix();
+
+  /**
+   * Extracts the lower band of a dense symmetric matrix
+   * @param symmetric_matrix (input) square matrix, entries outside the band are ignored
+   * @param bandwidth (input) number of non-zero sub-diagonals
+   * @return true on success, false on failure
+   */
+  bool initialize(const Eigen::MatrixXd& symmetric_matrix, const int bandwidth);
+
+  /**
+   * Computes the banded Cholesky factorization A = LL^T in O(size*bandwidth^2)
+   * @return true on success, false if the matrix is not positive definite
+   */
+  bool factorize();
+
+  /**
+   * Computes output = A * input
+   */
+  void multiply(const Eigen::VectorXd& input, Eigen::VectorXd& output) const;
+
+  /**
+   * Solves A * x = b in place (requires factorize())
+   * @param b (input) right hand side, (output) solution x
+   */
+  void solve(Eigen::VectorXd& b) const;
+
+  /**
+   * Solves L^T * x = b in place (requires factorize()). If b is standard normal, x is
+   * distributed with covariance A^-1.
+   * @param b (input) right hand side, (output) solution x
+   */
+  void solveFactorTranspose(Eigen::VectorXd& b) const;
+
+  /**
+   * Computes the dense inverse column by column using the banded factor, O(size^2*bandwidth)
+   * @param inverse (output) size x size matrix
+   */
+  void computeInverse(Eigen::MatrixXd& inverse) const;
+
+  int getSize() const;
+  int getBandwidth() const;
+  bool isFactorized() const;
+
+private:
+  int size_;
+  int bandwidth_;
+  bool factorized_;
+  Eigen::MatrixXd band_;        /**< (bandwidth+1) x size: lower band of A */
+  Eigen::MatrixXd factor_;      /**< (bandwidth+1) x size: lower band of the Cholesky factor L */
+
+  void solveFactor(Eigen::VectorXd& b) const;
+};
+
+// inline functions follow
+
+inline int BandedMatrix::getSize() const
+{
+  return size_;
+}
+
+inline int BandedMatrix::getBandwidth() const
+{
+  return bandwidth_;
+}
+
+inline bool BandedMatrix::isFactorized() const
+{
+  return factorized_;
+}
+
+}
+
+#endif /* STOMP_BANDED_MATRIX_H_ */
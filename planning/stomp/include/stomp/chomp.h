@@ -43,7 +43,7 @@ private:
   double max_update_;
 
   Rollout noiseless_rollout_;
-  std::vector<Eigen::MatrixXd> inv_control_costs_;
+  std::vector<BandedMatrix> banded_control_costs_;
   std::vector<Eigen::MatrixXd> control_costs_;
   std::vector<Eigen::VectorXd> gradients_;
   std::vector<Eigen::VectorXd> control_cost_gradients_;
@@ -40,6 +40,7 @@
 #include <ros/ros.h>
 #include <Eigen/Core>
 #include <stomp/stomp_utils.h>
+#include <stomp/banded_matrix.h>
 
 namespace stomp
 {
@@ -119,6 +120,15 @@ public:
     bool getControlCosts(std::vector<Eigen::MatrixXd>& control_costs);
 
     bool getInvControlCosts(std::vector<Eigen::MatrixXd>& control_costs);
+
+    /**
+     * Gets the control cost matrices in banded form, already factorized (bandwidth DIFF_RULE_LENGTH-1)
+     *
+     * @param control_costs (output) Array of banded, positive definite matrices: num_params x num_params
+     * @return true on success, false on failure
+     */
+    bool getBandedControlCosts(std::vector<BandedMatrix>& control_costs);
+
     /**
      * Update the policy parameters based on the updates per timestep
      * @param updates (input) parameter updates per time-step, num_time_steps x num_parameters
@@ -196,6 +206,7 @@ private:
     std::vector<Eigen::MatrixXd> basis_functions_;
     std::vector<Eigen::MatrixXd> control_costs_;
     std::vector<Eigen::MatrixXd> inv_control_costs_;
+    std::vector<BandedMatrix> banded_control_costs_;
     std::vector<Eigen::MatrixXd> control_costs_all_;
 
     std::vector<Eigen::VectorXd> linear_control_costs_;
@@ -269,6 +280,12 @@ inline bool CovariantMovementPrimitive::getInvControlCosts(std::vector<Eigen::Ma
   return true;
 }
 
+inline bool CovariantMovementPrimitive::getBandedControlCosts(std::vector<BandedMatrix>& control_costs)
+{
+  control_costs = banded_control_costs_;
+  return true;
+}
+
 inline bool CovariantMovementPrimitive::getNumTimeSteps(int& num_time_steps)
 {
     num_time_steps = num_time_steps_;
@@ -44,6 +44,8 @@
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/shared_ptr.hpp>
 #include <cstdlib>
+#include <ros/assert.h>
+#include <stomp/banded_matrix.h>
 
 namespace stomp
 {
@@ -57,6 +59,14 @@ public:
   template <typename Derived1, typename Derived2>
   MultivariateGaussian(const Eigen::MatrixBase<Derived1>& mean, const Eigen::MatrixBase<Derived2>& covariance);
 
+  /**
+   * Gaussian whose covariance is the inverse of the given banded precision matrix. Samples are
+   * drawn by a banded back substitution in O(size*bandwidth) instead of a dense O(size^2) product.
+   * @param precision (input) factorized banded matrix
+   */
+  template <typename Derived>
+  MultivariateGaussian(const Eigen::MatrixBase<Derived>& mean, const BandedMatrix& precision);
+
   template <typename Derived>
   void sample(Eigen::MatrixBase<Derived>& output);
 
@@ -64,6 +74,9 @@ private:
   Eigen::VectorXd mean_;                /**< Mean of the gaussian distribution */
   Eigen::MatrixXd covariance_;          /**< Covariance of the gaussian distribution */
   Eigen::MatrixXd covariance_cholesky_; /**< Cholesky decomposition (LL^T) of the covariance */
+  bool use_precision_;                  /**< Sample using the banded precision instead of the dense covariance */
+  BandedMatrix precision_;              /**< Banded inverse of the covariance, factorized */
+  Eigen::VectorXd tmp_sample_;          /**< Pre-allocated sample for the banded solve */
 
   int size_;
   boost::mt19937 rng_;
@@ -78,6 +91,7 @@ MultivariateGaussian::MultivariateGaussian(const Eigen::MatrixBase<Derived1>& me
   mean_(mean),
   covariance_(covariance),
   covariance_cholesky_(covariance_.llt().matrixL()),
+  use_precision_(false),
   normal_dist_(0.0,1.0)
 {
 
@@ -91,9 +105,33 @@ MultivariateGaussian::MultivariateGaussian(const Eigen::MatrixBase<Derived1>& me
   gaussian_.reset(new boost::variate_generator<boost::mt19937, boost::normal_distribution<> >(rng_, normal_dist_));
 }
 
+template <typename Derived>
+MultivariateGaussian::MultivariateGaussian(const Eigen::MatrixBase<Derived>& mean, const BandedMatrix& precision):
+  mean_(mean),
+  use_precision_(true),
+  precision_(precision),
+  tmp_sample_(Eigen::VectorXd::Zero(mean.rows())),
+  normal_dist_(0.0,1.0)
+{
+  ROS_ASSERT(precision_.isFactorized());
+  ROS_ASSERT(precision_.getSize() == mean.rows());
+  rng_.seed(rand());
+  size_ = mean.rows();
+  gaussian_.reset(new boost::variate_generator<boost::mt19937, boost::normal_distribution<> >(rng_, normal_dist_));
+}
+
 template <typename Derived>
 void MultivariateGaussian::sample(Eigen::MatrixBase<Derived>& output)
 {
+  if (use_precision_)
+  {
+    // with precision = LL^T, x = L^-T z has covariance (LL^T)^-1
+    for (int i=0; i<size_; ++i)
+      tmp_sample_(i) = (*gaussian_)();
+    precision_.solveFactorTranspose(tmp_sample_);
+    output = mean_ + tmp_sample_;
+    return;
+  }
   for (int i=0; i<size_; ++i)
     output(i) = (*gaussian_)();
   output = mean_ + covariance_cholesky_*output;
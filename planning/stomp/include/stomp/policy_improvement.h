@@ -196,8 +196,8 @@ private:
 
     std::vector<Eigen::MatrixXd> control_costs_;                            /**< [num_dimensions] num_parameters x num_parameters */
     std::vector<Eigen::MatrixXd> inv_control_costs_;                        /**< [num_dimensions] num_parameters x num_parameters */
-    std::vector<Eigen::MatrixXd> projection_matrix_;                        /**< [num_dimensions] num_parameters x num_parameters */
-    std::vector<Eigen::MatrixXd> inv_projection_matrix_;                    /**< [num_dimensions] num_parameters x num_parameters */
+    std::vector<BandedMatrix> banded_control_costs_;                        /**< [num_dimensions] factorized, num_parameters x num_parameters */
+    std::vector<Eigen::VectorXd> projection_scaling_;                       /**< [num_dimensions] num_parameters: projection matrix = inv_control_costs * diag(projection_scaling) */
     double control_cost_weight_;
 
     std::vector<Eigen::MatrixXd> basis_functions_;                          /**< [num_dimensions] num_time_steps x num_parameters */
@@ -231,6 +231,17 @@ private:
     Eigen::VectorXd tmp_max_minus_min_cost_;                /**< num_time_steps */
     Eigen::VectorXd tmp_sum_rollout_probabilities_;         /**< num_time_steps */
     std::vector<std::pair<double, int> > rollout_cost_sorter_;  /**< vector used for sorting rollouts by their cost */
+
+    // rollout data packed contiguously per dimension (rollout index changes fastest) for computing the update:
+    std::vector<Eigen::MatrixXd> packed_cumulative_costs_;  /**< [num_dimensions] num_rollouts x num_time_steps */
+    std::vector<Eigen::MatrixXd> packed_probabilities_;     /**< [num_dimensions] num_rollouts x num_time_steps */
+    std::vector<Eigen::MatrixXd> packed_noise_;             /**< [num_dimensions] num_rollouts x num_parameters */
+    Eigen::MatrixXd packed_full_costs_;                     /**< num_rollouts x num_dimensions */
+    Eigen::MatrixXd packed_full_probabilities_;             /**< num_rollouts x num_dimensions */
+    Eigen::VectorXd packed_importance_weights_;             /**< num_rollouts */
+    bool packRollouts();
+    bool unpackRolloutProbabilities();
+
     bool preAllocateTempVariables();
     bool preComputeProjectionMatrices();
 
@@ -40,6 +40,7 @@
 
 #include <kdl/jntarray.hpp>
 #include <iostream>
+#include <algorithm>
 #include <Eigen/Core>
 
 namespace stomp
@@ -86,6 +87,35 @@ static inline void differentiate(const Eigen::VectorXd& input,
   }
 }
 
+/**
+ * Differentiates each column of input (one trajectory per column) with the same clamped
+ * boundary handling as above. The rule is applied on shifted blocks of rows, so the work
+ * is vectorized over time and over all columns at once.
+ */
+static inline void differentiate(const Eigen::MatrixXd& input,
+                                 CostComponents order, Eigen::MatrixXd& output,
+                                 double dt)
+{
+  double multiplier = 1.0/pow(dt,(int)order);
+  int T = input.rows();
+  output.setZero(T, input.cols());
+  for (int j=-DIFF_RULE_LENGTH/2; j<=DIFF_RULE_LENGTH/2; ++j)
+  {
+    double coefficient = multiplier * DIFF_RULES[order][j+DIFF_RULE_LENGTH/2];
+    if (coefficient == 0.0)
+      continue;
+    // rows [0, begin) and [end, T) have index i+j clamped to the first and last row
+    int begin = std::min(std::max(0, -j), T);
+    int end = std::max(std::min(T, T-j), begin);
+    for (int i=0; i<begin; ++i)
+      output.row(i) += coefficient * input.row(0);
+    if (end > begin)
+      output.middleRows(begin, end-begin) += coefficient * input.middleRows(begin+j, end-begin);
+    for (int i=end; i<T; ++i)
+      output.row(i) += coefficient * input.row(T-1);
+  }
+}
+
 } //namespace stomp
 
 #endif /* STOMP_UTILS_H_ */
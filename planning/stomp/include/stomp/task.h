@@ -79,6 +79,13 @@ public:
                          std::vector<Eigen::VectorXd>& gradients,
                          bool& validity) = 0;
 
+    /**
+     * Sets the maximum number of rollouts executed per iteration, allows the task to pre-allocate per-rollout data
+     * @param max_rollouts
+     * @return
+     */
+    virtual bool setMaxRollouts(int max_rollouts){return true;};
+
     /**
      * Filters the given parameters - for eg, clipping of joint limits
      * @param parameters
@@ -0,0 +1,180 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2010, Willow Garage, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <stomp/banded_matrix.h>
+#include <ros/ros.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace Eigen;
+
+namespace stomp
+{
+
+BandedMatrix::BandedMatrix():
+  size_(0),
+  bandwidth_(0),
+  factorized_(false)
+{
+}
+
+BandedMatrix::~BandedMatrix()
+{
+}
+
+bool BandedMatrix::initialize(const Eigen::MatrixXd& symmetric_matrix, const int bandwidth)
+{
+  if (symmetric_matrix.rows() != symmetric_matrix.cols() || bandwidth < 0)
+  {
+    ROS_ERROR("Cannot create banded matrix of bandwidth %d from %d x %d matrix.",
+              bandwidth, int(symmetric_matrix.rows()), int(symmetric_matrix.cols()));
+    return false;
+  }
+  size_ = symmetric_matrix.rows();
+  bandwidth_ = std::min(bandwidth, std::max(size_-1, 0));
+  factorized_ = false;
+
+  band_ = MatrixXd::Zero(bandwidth_+1, size_);
+  for (int j=0; j<size_; ++j)
+  {
+    for (int k=0; k<=bandwidth_ && j+k<size_; ++k)
+    {
+      band_(k,j) = symmetric_matrix(j+k,j);
+    }
+  }
+  factor_ = MatrixXd::Zero(bandwidth_+1, size_);
+  return true;
+}
+
+bool BandedMatrix::factorize()
+{
+  factorized_ = false;
+  for (int j=0; j<size_; ++j)
+  {
+    // L(i,j) = (A(i,j) - sum_k L(i,k) L(j,k)) / L(j,j), only k within the band of both rows
+    const int start = std::max(0, j-bandwidth_);
+    double diagonal = band_(0,j);
+    for (int k=start; k<j; ++k)
+    {
+      diagonal -= factor_(j-k,k) * factor_(j-k,k);
+    }
+    if (diagonal <= 0.0)
+    {
+      ROS_ERROR("Banded matrix is not positive definite (pivot %d is %f).", j, diagonal);
+      return false;
+    }
+    factor_(0,j) = sqrt(diagonal);
+
+    const int end = std::min(size_-1, j+bandwidth_);
+    for (int i=j+1; i<=end; ++i)
+    {
+      double value = band_(i-j,j);
+      for (int k=std::max(0, i-bandwidth_); k<j; ++k)
+      {
+        value -= factor_(i-k,k) * factor_(j-k,k);
+      }
+      factor_(i-j,j) = value / factor_(0,j);
+    }
+  }
+  return (factorized_ = true);
+}
+
+void BandedMatrix::multiply(const Eigen::VectorXd& input, Eigen::VectorXd& output) const
+{
+  ROS_ASSERT(input.rows() == size_);
+  output = band_.row(0).transpose().cwiseProduct(input);
+  for (int j=0; j<size_; ++j)
+  {
+    const int end = std::min(bandwidth_, size_-1-j);
+    for (int k=1; k<=end; ++k)
+    {
+      output(j+k) += band_(k,j) * input(j);
+      output(j) += band_(k,j) * input(j+k);
+    }
+  }
+}
+
+void BandedMatrix::solveFactor(Eigen::VectorXd& b) const
+{
+  // forward substitution, column oriented so that the band is traversed contiguously
+  for (int j=0; j<size_; ++j)
+  {
+    b(j) /= factor_(0,j);
+    const int end = std::min(bandwidth_, size_-1-j);
+    for (int k=1; k<=end; ++k)
+    {
+      b(j+k) -= factor_(k,j) * b(j);
+    }
+  }
+}
+
+void BandedMatrix::solveFactorTranspose(Eigen::VectorXd& b) const
+{
+  ROS_ASSERT(factorized_);
+  ROS_ASSERT(b.rows() == size_);
+  for (int j=size_-1; j>=0; --j)
+  {
+    double value = b(j);
+    const int end = std::min(bandwidth_, size_-1-j);
+    for (int k=1; k<=end; ++k)
+    {
+      value -= factor_(k,j) * b(j+k);
+    }
+    b(j) = value / factor_(0,j);
+  }
+}
+
+void BandedMatrix::solve(Eigen::VectorXd& b) const
+{
+  ROS_ASSERT(factorized_);
+  ROS_ASSERT(b.rows() == size_);
+  solveFactor(b);
+  solveFactorTranspose(b);
+}
+
+void BandedMatrix::computeInverse(Eigen::MatrixXd& inverse) const
+{
+  ROS_ASSERT(factorized_);
+  inverse = MatrixXd::Zero(size_, size_);
+  VectorXd column = VectorXd::Zero(size_);
+  for (int j=0; j<size_; ++j)
+  {
+    column.setZero();
+    column(j) = 1.0;
+    solve(column);
+    inverse.col(j) = column;
+  }
+}
+
+}
@@ -32,7 +32,7 @@ bool CHOMP::initialize(ros::NodeHandle& node_handle, boost::shared_ptr<Task> tas
   control_cost_weight_ = task_->getControlCostWeight();
   policy_->getNumDimensions(num_dimensions_);
   policy_->getControlCosts(control_costs_);
-  policy_->getInvControlCosts(inv_control_costs_);
+  policy_->getBandedControlCosts(banded_control_costs_);
   policy_->getParameters(parameters_);
   update_.resize(num_dimensions_, Eigen::VectorXd(num_time_steps_));
   noiseless_rollout_.noise_.resize(num_time_steps_, Eigen::VectorXd::Zero(num_time_steps_));
@@ -61,7 +61,8 @@ bool CHOMP::runSingleIteration(int iteration_number)
   for (int d=0; d<num_dimensions_; ++d)
   {
     //std::cout << "Dimension " << d << "gradient = \n" << (gradients_[d] + control_cost_gradients_[d]);
-    update_[d] = -learning_rate_ * inv_control_costs_[d] * (gradients_[d] + control_cost_gradients_[d]);
+    update_[d] = -learning_rate_ * (gradients_[d] + control_cost_gradients_[d]);
+    banded_control_costs_[d].solve(update_[d]);
     // scale the update
     double max = update_[d].array().abs().matrix().maxCoeff();
     if (max > max_update_)
@@ -133,8 +133,10 @@ bool CovariantMovementPrimitive::computeMinControlCostParameters()
 {
   for (int d=0; d<num_dimensions_; ++d)
   {
-    parameters_all_[d].segment(free_vars_start_index_, num_vars_free_) =
-        -0.5 * inv_control_costs_[d] * linear_control_costs_[d];
+    // solve R x = -0.5 * linear costs on the banded factor of R
+    VectorXd min_control_cost_parameters = -0.5 * linear_control_costs_[d];
+    banded_control_costs_[d].solve(min_control_cost_parameters);
+    parameters_all_[d].segment(free_vars_start_index_, num_vars_free_) = min_control_cost_parameters;
   }
   return true;
 }
@@ -172,6 +174,7 @@ bool CovariantMovementPrimitive::initializeCosts()
   control_costs_all_.clear();
   control_costs_.clear();
   inv_control_costs_.clear();
+  banded_control_costs_.clear();
   derivative_costs_sqrt_.clear();
   for (int d=0; d<num_dimensions_; ++d)
   {
@@ -193,7 +196,15 @@ bool CovariantMovementPrimitive::initializeCosts()
     MatrixXd cost_free = cost_all.block(DIFF_RULE_LENGTH-1, DIFF_RULE_LENGTH-1, num_vars_free_, num_vars_free_);
     control_costs_.push_back(cost_free);
 
-    inv_control_costs_.push_back(cost_free.fullPivLu().inverse());
+    // the finite differencing rules make the cost matrix banded
+    BandedMatrix banded_cost_free;
+    ROS_VERIFY(banded_cost_free.initialize(cost_free, DIFF_RULE_LENGTH-1));
+    ROS_VERIFY(banded_cost_free.factorize());
+    banded_control_costs_.push_back(banded_cost_free);
+
+    MatrixXd inv_cost_free;
+    banded_cost_free.computeInverse(inv_cost_free);
+    inv_control_costs_.push_back(inv_cost_free);
   }
 
   computeLinearControlCosts();
@@ -253,7 +264,8 @@ bool CovariantMovementPrimitive::computeControlCostGradient(const std::vector<Ei
 
   for (int d=0; d<num_dimensions_; ++d)
   {
-    gradient[d] = weight * (2.0 * control_costs_[d] * parameters[d] + linear_control_costs_[d]);
+    banded_control_costs_[d].multiply(parameters[d], gradient[d]);
+    gradient[d] = weight * (2.0 * gradient[d] + linear_control_costs_[d]);
   }
 
   return true;
@@ -84,6 +84,7 @@ bool PolicyImprovement::initialize(const int num_time_steps,
   ROS_VERIFY(policy_->getBasisFunctions(basis_functions_));
   ROS_VERIFY(policy_->getParameters(parameters_));
   ROS_VERIFY(policy_->getInvControlCosts(inv_control_costs_));
+  ROS_VERIFY(policy_->getBandedControlCosts(banded_control_costs_));
 
   // invert the control costs, initialize noise generators:
   noise_generators_.clear();
@@ -91,7 +92,7 @@ bool PolicyImprovement::initialize(const int num_time_steps,
   adapted_covariances_.clear();
   for (int d=0; d<num_dimensions_; ++d)
   {
-    MultivariateGaussian mvg(VectorXd::Zero(num_parameters_[d]), inv_control_costs_[d]);
+    MultivariateGaussian mvg(VectorXd::Zero(num_parameters_[d]), banded_control_costs_[d]);
     noise_generators_.push_back(mvg);
     adapted_covariances_.push_back(inv_control_costs_[d]);
   }
@@ -151,6 +152,20 @@ bool PolicyImprovement::setNumRollouts(const int min_rollouts,
 
   rollout_cost_sorter_.reserve(max_rollouts_);
 
+  // the noiseless rollout may be added as well
+  packed_cumulative_costs_.clear();
+  packed_probabilities_.clear();
+  packed_noise_.clear();
+  for (int d=0; d<num_dimensions_; ++d)
+  {
+    packed_cumulative_costs_.push_back(MatrixXd::Zero(max_rollouts_+1, num_time_steps_));
+    packed_probabilities_.push_back(MatrixXd::Zero(max_rollouts_+1, num_time_steps_));
+    packed_noise_.push_back(MatrixXd::Zero(max_rollouts_+1, num_parameters_[d]));
+  }
+  packed_full_costs_ = MatrixXd::Zero(max_rollouts_+1, num_dimensions_);
+  packed_full_probabilities_ = MatrixXd::Zero(max_rollouts_+1, num_dimensions_);
+  packed_importance_weights_ = VectorXd::Zero(max_rollouts_+1);
+
   return true;
 }
 
@@ -212,7 +227,9 @@ bool PolicyImprovement::generateRollouts(const std::vector<double>& noise_stddev
       {
         // parameters_noise_projected remains the same, compute everything else from it.
         rollouts_[r].noise_projected_[d] = rollouts_[r].parameters_noise_projected_[d] - parameters_[d];
-        rollouts_[r].noise_[d] = inv_projection_matrix_[d] * rollouts_[r].noise_projected_[d];
+        // inverse projection: diag(projection_scaling)^-1 * control_costs * noise_projected
+        banded_control_costs_[d].multiply(rollouts_[r].noise_projected_[d], rollouts_[r].noise_[d]);
+        rollouts_[r].noise_[d].array() /= projection_scaling_[d].array();
         rollouts_[r].parameters_noise_[d] = parameters_[d] + rollouts_[r].noise_[d];
 
 //        new_log_likelihood +=  -num_time_steps_*log(adapted_stddevs_[d])
@@ -410,7 +427,8 @@ bool PolicyImprovement::computeProjectedNoise(Rollout& rollout)
   //ros::WallTime start_time = ros::WallTime::now();
   for (int d=0; d<num_dimensions_; ++d)
   {
-    rollout.noise_projected_[d] = projection_matrix_[d] * rollout.noise_[d];
+    rollout.noise_projected_[d] = (projection_scaling_[d].array() * rollout.noise_[d].array()).matrix();
+    banded_control_costs_[d].solve(rollout.noise_projected_[d]);
     rollout.parameters_noise_projected_[d] = rollout.parameters_[d] + rollout.noise_projected_[d];
   }
   //ROS_INFO("Noise projection took %f seconds", (ros::WallTime::now() - start_time).toSec());
@@ -471,164 +489,107 @@ bool PolicyImprovement::computeRolloutCumulativeCosts(std::vector<double>& rollo
     return true;
 }
 
+bool PolicyImprovement::packRollouts()
+{
+  for (int r=0; r<num_rollouts_; ++r)
+  {
+    packed_importance_weights_(r) = rollouts_[r].importance_weight_;
+    for (int d=0; d<num_dimensions_; ++d)
+    {
+      packed_cumulative_costs_[d].row(r) = rollouts_[r].cumulative_costs_[d].transpose();
+      packed_noise_[d].row(r) = rollouts_[r].noise_[d].transpose();
+      packed_full_costs_(r,d) = rollouts_[r].full_costs_[d];
+    }
+  }
+  return true;
+}
+
+bool PolicyImprovement::unpackRolloutProbabilities()
+{
+  for (int r=0; r<num_rollouts_; ++r)
+  {
+    for (int d=0; d<num_dimensions_; ++d)
+    {
+      rollouts_[r].probabilities_[d] = packed_probabilities_[d].row(r).transpose();
+      rollouts_[r].full_probabilities_[d] = packed_full_probabilities_(r,d);
+    }
+  }
+  return true;
+}
+
 bool PolicyImprovement::computeRolloutProbabilities()
 {
+#pragma omp parallel for
     for (int d=0; d<num_dimensions_; ++d)
     {
+      const Block<MatrixXd> costs(packed_cumulative_costs_[d], 0, 0, num_rollouts_, num_time_steps_);
+      Block<MatrixXd> probabilities(packed_probabilities_[d], 0, 0, num_rollouts_, num_time_steps_);
+      const VectorBlock<VectorXd> importance_weights(packed_importance_weights_, 0, num_rollouts_);
+
       // find min and max cost over all rollouts:
-      double min_cost = rollouts_[0].cumulative_costs_[d].minCoeff();
-      double max_cost = rollouts_[0].cumulative_costs_[d].maxCoeff();
-      for (int r=1; r<num_rollouts_; ++r)
+      double min_cost = costs.minCoeff();
+      double max_cost = costs.maxCoeff();
+      double denom = max_cost - min_cost;
+
+      time_step_weights_[d].setOnes();
+
+      // prevent divide by zero:
+      if (denom < 1e-8)
+        denom = 1e-8;
+
+      // each column holds the costs of all rollouts at one time step
+      probabilities = ((-cost_scaling_h_ * (costs.array() - min_cost)) / denom).exp();
+      probabilities.array().colwise() *= importance_weights.array();
+      for (int t=0; t<num_time_steps_; ++t)
       {
-        double min_r = rollouts_[r].cumulative_costs_[d].minCoeff();
-        double max_r = rollouts_[r].cumulative_costs_[d].maxCoeff();
-        if (min_cost > min_r)
-          min_cost = min_r;
-        if (max_cost < max_r)
-          max_cost = max_r;
+        probabilities.col(t) /= probabilities.col(t).sum();
       }
 
-        for (int t=0; t<num_time_steps_; t++)
-        {
-
-//            // find min and max cost over all rollouts:
-//            double min_cost = rollouts_[0].cumulative_costs_[d](t);
-//            double max_cost = min_cost;
-//            for (int r=1; r<num_rollouts_; ++r)
-//            {
-//                double c = rollouts_[r].cumulative_costs_[d](t);
-//                if (c < min_cost)
-//                    min_cost = c;
-//                if (c > max_cost)
-//                    max_cost = c;
-//            }
-
-            double denom = max_cost - min_cost;
-
-            //time_step_weights_[d][t] = denom;
-            time_step_weights_[d][t] = 1.0;
-
-            // prevent divide by zero:
-            if (denom < 1e-8)
-                denom = 1e-8;
-
-            double p_sum = 0.0;
-            for (int r=0; r<num_rollouts_; ++r)
-            {
-                rollouts_[r].probabilities_[d](t) = rollouts_[r].importance_weight_ *
-                    exp(-cost_scaling_h_*(rollouts_[r].cumulative_costs_[d](t) - min_cost)/denom);
-                p_sum += rollouts_[r].probabilities_[d](t);
-            }
-            for (int r=0; r<num_rollouts_; ++r)
-            {
-                rollouts_[r].probabilities_[d](t) /= p_sum;
-            }
-
-        }
-
-        // now the "total" probabilities
-
-        min_cost = rollouts_[0].full_costs_[d];
-        max_cost = min_cost;
-        for (int r=1; r<num_rollouts_; ++r)
-        {
-          double c = rollouts_[r].full_costs_[d];
-          if (c < min_cost)
-            min_cost = c;
-          if (c > max_cost)
-            max_cost = c;
-        }
-        double cost_denom = max_cost - min_cost;
-        if (cost_denom < 1e-8)
-          cost_denom = 1e-8;
-
-        double p_sum = 0.0;
-        for (int r=0; r<num_rollouts_; ++r)
-        {
-          rollouts_[r].full_probabilities_[d] = rollouts_[r].importance_weight_ * exp(-cost_scaling_h_*(rollouts_[r].full_costs_[d] - min_cost)/cost_denom);
-          p_sum += rollouts_[r].full_probabilities_[d];
-        }
-        for (int r=0; r<num_rollouts_; ++r)
-        {
-            rollouts_[r].full_probabilities_[d] /= p_sum;
-        }
-
+      // now the "total" probabilities
+      const Block<MatrixXd, Dynamic, 1> full_costs(packed_full_costs_, 0, d, num_rollouts_, 1);
+      Block<MatrixXd, Dynamic, 1> full_probabilities(packed_full_probabilities_, 0, d, num_rollouts_, 1);
+      min_cost = full_costs.minCoeff();
+      max_cost = full_costs.maxCoeff();
+      double cost_denom = max_cost - min_cost;
+      if (cost_denom < 1e-8)
+        cost_denom = 1e-8;
+
+      full_probabilities = importance_weights.array()
+          * ((-cost_scaling_h_ * (full_costs.array() - min_cost)) / cost_denom).exp();
+      full_probabilities /= full_probabilities.sum();
     }
     return true;
 }
 
 bool PolicyImprovement::computeParameterUpdates()
 {
+  bool adapted_covariance_valid = false;
+#pragma omp parallel for reduction(||:adapted_covariance_valid)
   for (int d=0; d<num_dimensions_; ++d)
   {
-    parameter_updates_[d] = MatrixXd::Zero(num_time_steps_, num_parameters_[d]);
+    const Block<MatrixXd> noise(packed_noise_[d], 0, 0, num_rollouts_, num_parameters_[d]);
+    const Block<MatrixXd> probabilities(packed_probabilities_[d], 0, 0, num_rollouts_, num_time_steps_);
 
-    for (int r=0; r<num_rollouts_; ++r)
-    {
-      parameter_updates_[d].row(0).transpose() +=
-          (rollouts_[r].noise_[d].array() * rollouts_[r].probabilities_[d].array()).matrix();
-    }
+    parameter_updates_[d] = MatrixXd::Zero(num_time_steps_, num_parameters_[d]);
+    parameter_updates_[d].row(0) = (noise.array() * probabilities.array()).colwise().sum();
 
     if (use_covariance_matrix_adaptation_)
     {
-
-      // true CMA method
-//      adapted_covariances_[d] = Eigen::MatrixXd::Zero(num_time_steps_, num_time_steps_);
-//      for (int r=0; r<num_rollouts_; ++r)
-//      {
-//        adapted_covariances_[d] += rollouts_[r].full_probabilities_[d] *
-//            rollouts_[r].noise_[d] * rollouts_[r].noise_[d].transpose();
-//      }
-//
-//      ROS_INFO_STREAM("Covariance for dimension " << d << " = " << adapted_covariances_[d]);
-//      adapted_stddevs_[d] = 1.0;
-//      adapted_covariance_inverse_[d] = adapted_covariances_[d].fullPivLu().inverse();
-//      noise_generators_[d] = MultivariateGaussian(VectorXd::Zero(num_parameters_[d]), adapted_covariances_[d]);
-
-      // one-dimensional CMA-ish
-//      double var = 0.0;
-//      for (int r=0; r<num_rollouts_; ++r)
-//      {
-//        double dist = rollouts_[r].noise_[d].transpose() *
-//            adapted_covariance_inverse_[d] * rollouts_[r].noise_[d];
-//        var += rollouts_[r].full_probabilities_[d] * dist;
-//        //printf("Rollout %d, dist = %f", r, dist);
-//      }
-//      var /= num_time_steps_;
-//      adapted_stddevs_[d] = 0.8 * adapted_stddevs_[d] + 0.2 * sqrt(var);
-//      ROS_INFO("Dimension %d: new stddev = %f", d, adapted_stddevs_[d]);
-
       // true CMA method + minimization of frobenius norm
-      adapted_covariances_[d] = Eigen::MatrixXd::Zero(num_time_steps_, num_time_steps_);
-      for (int r=0; r<num_rollouts_; ++r)
-      {
-        adapted_covariances_[d] += rollouts_[r].full_probabilities_[d] *
-            rollouts_[r].noise_[d] * rollouts_[r].noise_[d].transpose();
-      }
+      const Block<MatrixXd, Dynamic, 1> full_probabilities(packed_full_probabilities_, 0, d, num_rollouts_, 1);
+      adapted_covariances_[d] = noise.transpose() * full_probabilities.asDiagonal() * noise;
+
       // minimize frobenius norm of diff between a_c and std_dev^2 * inv_control_cost
-      double numer = 0.0;
-      double denom = 0.0;
-      for (int i=0; i<num_time_steps_; ++i)
-      {
-        for (int j=0; j<num_time_steps_; ++j)
-        {
-          numer += adapted_covariances_[d](i,j) * inv_control_costs_[d](i,j);
-          denom += inv_control_costs_[d](i,j) * inv_control_costs_[d](i,j);
-        }
-      }
+      double numer = (adapted_covariances_[d].array() * inv_control_costs_[d].array()).sum();
+      double denom = inv_control_costs_[d].squaredNorm();
       double frob_stddev = sqrt(numer/denom);
 
-//      double kl_stddev = sqrt((control_costs_[d]*adapted_covariances_[d]).trace() / num_parameters_[d]);
-//      ROS_INFO("frob = %lf, kl = %lf", frob_stddev, kl_stddev);
-
       adapted_stddevs_[d] = 0.8 * adapted_stddevs_[d] + 0.2 * frob_stddev;
 
       if (adapted_stddevs_[d] < noise_min_stddev_[d])
         adapted_stddevs_[d] = noise_min_stddev_[d];
-//      ROS_INFO("Dimension %d: new stddev = %f", d, adapted_stddevs_[d]);
-
-      adapted_covariance_valid_ = true;
 
+      adapted_covariance_valid = true;
     }
 
     // reweighting the updates per time-step
@@ -654,9 +615,13 @@ bool PolicyImprovement::computeParameterUpdates()
     }
     parameter_updates_[d].row(0) /= divisor;
 
-    parameter_updates_[d].row(0).transpose() = projection_matrix_[d]*parameter_updates_[d].row(0).transpose();
+    tmp_parameters_[d] = (projection_scaling_[d].array() * parameter_updates_[d].row(0).transpose().array()).matrix();
+    banded_control_costs_[d].solve(tmp_parameters_[d]);
+    parameter_updates_[d].row(0) = tmp_parameters_[d].transpose();
 
   }
+  if (adapted_covariance_valid)
+    adapted_covariance_valid_ = true;
 
   return true;
 }
@@ -669,10 +634,12 @@ bool PolicyImprovement::improvePolicy(std::vector<Eigen::MatrixXd>& parameter_up
     //computeRolloutCumulativeCosts();
     //ROS_INFO("Cumulative costs took %f seconds", (ros::WallTime::now() - start_time).toSec());
     //start_time = ros::WallTime::now();
+    packRollouts();
     computeRolloutProbabilities();
     //ROS_INFO("Probabilities took %f seconds", (ros::WallTime::now() - start_time).toSec());
     //start_time = ros::WallTime::now();
     computeParameterUpdates();
+    unpackRolloutProbabilities();
     //ROS_INFO("Updates took %f seconds", (ros::WallTime::now() - start_time).toSec());
     parameter_updates = parameter_updates_;
 
@@ -701,36 +668,12 @@ bool PolicyImprovement::preAllocateTempVariables()
 bool PolicyImprovement::preComputeProjectionMatrices()
 {
 //  ROS_INFO("Precomputing projection matrices..");
-  projection_matrix_.resize(num_dimensions_);
-  inv_projection_matrix_.resize(num_dimensions_);
+  // the projection matrix is inv_control_costs with each column divided by (num_parameters * diagonal element),
+  // it is applied through banded solves with the control costs instead of being stored densely
+  projection_scaling_.resize(num_dimensions_);
   for (int d=0; d<num_dimensions_; ++d)
   {
-    projection_matrix_[d] = inv_control_costs_[d];
-
-    // scale each column separately - divide by max element
-//    for (int p=0; p<num_parameters_[d]; ++p)
-//    {
-//      double column_max = fabs(inv_control_costs_[d](0,p));
-//      for (int p2 = 1; p2 < num_parameters_[d]; ++p2)
-//      {
-//        if (fabs(inv_control_costs_[d](p2,p)) > column_max)
-//          column_max = fabs(inv_control_costs_[d](p2,p));
-//      }
-//      projection_matrix_[d].col(p) *= (1.0/(num_parameters_[d]*column_max));
-//    }
-
-    // scale each column separately - divide by diagonal element
-    for (int p=0; p<num_parameters_[d]; ++p)
-    {
-      double column_max = projection_matrix_[d](p,p);
-      projection_matrix_[d].col(p) *= (1.0/(num_parameters_[d]*column_max));
-    }
-
-//    double max_entry = inv_control_costs_[d].maxCoeff();
-//    projection_matrix_[d] /= max_entry*num_parameters_[d];
-
-    //ROS_INFO_STREAM("Projection matrix = \n" << projection_matrix_[d]);
-    inv_projection_matrix_[d] = projection_matrix_[d].fullPivLu().inverse();
+    projection_scaling_[d] = (inv_control_costs_[d].diagonal() * num_parameters_[d]).cwiseInverse();
   }
 //  ROS_INFO("Done precomputing projection matrices.");
   return true;
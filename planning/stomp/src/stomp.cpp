@@ -65,6 +65,7 @@ bool STOMP::initialize(ros::NodeHandle& node_handle, boost::shared_ptr<stomp::Ta
   task_ = task;
   ROS_VERIFY(task_->getPolicy(policy_));
   ROS_VERIFY(policy_->getNumTimeSteps(num_time_steps_));
+  ROS_VERIFY(task_->setMaxRollouts(max_rollouts_));
   control_cost_weight_ = task_->getControlCostWeight();
 
   ROS_VERIFY(policy_->getNumDimensions(num_dimensions_));
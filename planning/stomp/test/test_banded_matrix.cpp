@@ -0,0 +1,230 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2010, Willow Garage, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <algorithm>
+
+#include <Eigen/Core>
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
+
+#include <stomp/banded_matrix.h>
+#include <stomp/multivariate_gaussian.h>
+
+using namespace stomp;
+using namespace Eigen;
+
+static const double TOLERANCE = 1e-9;
+
+/**
+ * Random symmetric diagonally dominant (hence positive definite) matrix that is zero outside the band
+ */
+static MatrixXd createBandedMatrix(int size, int bandwidth)
+{
+  MatrixXd matrix = MatrixXd::Zero(size, size);
+  for (int j=0; j<size; ++j)
+  {
+    for (int k=1; k<=bandwidth && j+k<size; ++k)
+    {
+      matrix(j+k,j) = matrix(j,j+k) = 2.0*(rand()/double(RAND_MAX)) - 1.0;
+    }
+  }
+  for (int i=0; i<size; ++i)
+  {
+    matrix(i,i) = matrix.row(i).cwiseAbs().sum() + 1.0 + rand()/double(RAND_MAX);
+  }
+  return matrix;
+}
+
+/**
+ * Compares all operations of the banded matrix against the dense Eigen equivalents
+ */
+static void checkAgainstDense(const MatrixXd& dense, int bandwidth)
+{
+  const int size = dense.rows();
+  BandedMatrix banded;
+  ASSERT_TRUE(banded.initialize(dense, bandwidth));
+  EXPECT_EQ(size, banded.getSize());
+  EXPECT_EQ(std::min(bandwidth, std::max(size-1, 0)), banded.getBandwidth());
+  EXPECT_FALSE(banded.isFactorized());
+
+  // multiplication does not need the factorization
+  VectorXd input = VectorXd::Random(size);
+  VectorXd output;
+  banded.multiply(input, output);
+  ASSERT_EQ(size, output.rows());
+  EXPECT_LT((output - dense*input).cwiseAbs().maxCoeff(), TOLERANCE);
+
+  ASSERT_TRUE(banded.factorize());
+  EXPECT_TRUE(banded.isFactorized());
+  LLT<MatrixXd> llt(dense);
+  ASSERT_EQ(Success, llt.info());
+
+  // the Cholesky factor is unique, hence L^T x = b has to match the dense factor
+  VectorXd rhs = VectorXd::Random(size);
+  VectorXd solution = rhs;
+  banded.solveFactorTranspose(solution);
+  MatrixXd factor_transpose = llt.matrixU();
+  EXPECT_LT((factor_transpose*solution - rhs).cwiseAbs().maxCoeff(), TOLERANCE);
+
+  solution = rhs;
+  banded.solve(solution);
+  EXPECT_LT((solution - llt.solve(rhs)).cwiseAbs().maxCoeff(), TOLERANCE);
+  EXPECT_LT((dense*solution - rhs).cwiseAbs().maxCoeff(), TOLERANCE);
+
+  MatrixXd inverse;
+  banded.computeInverse(inverse);
+  ASSERT_EQ(size, inverse.rows());
+  ASSERT_EQ(size, inverse.cols());
+  EXPECT_LT((inverse - dense.inverse()).cwiseAbs().maxCoeff(), TOLERANCE);
+}
+
+TEST(TestBandedMatrix, TestRandomMatrices)
+{
+  srand(0);
+  const int sizes[] = {2, 7, 25, 60};
+  const int bandwidths[] = {1, 2, 3, 6};
+  for (int s=0; s<4; ++s)
+  {
+    for (int b=0; b<4; ++b)
+    {
+      if (bandwidths[b] >= sizes[s])
+        continue;
+      SCOPED_TRACE(testing::Message() << "size " << sizes[s] << ", bandwidth " << bandwidths[b]);
+      checkAgainstDense(createBandedMatrix(sizes[s], bandwidths[b]), bandwidths[b]);
+    }
+  }
+}
+
+TEST(TestBandedMatrix, TestBandwidthEdgeCases)
+{
+  srand(1);
+  {
+    SCOPED_TRACE("diagonal");
+    checkAgainstDense(createBandedMatrix(10, 0), 0);
+  }
+  {
+    SCOPED_TRACE("single element");
+    checkAgainstDense(createBandedMatrix(1, 0), 0);
+  }
+  {
+    SCOPED_TRACE("single element, bandwidth clamped");
+    checkAgainstDense(createBandedMatrix(1, 0), 3);
+  }
+  {
+    SCOPED_TRACE("full matrix");
+    checkAgainstDense(createBandedMatrix(12, 11), 11);
+  }
+  {
+    SCOPED_TRACE("full matrix, bandwidth clamped");
+    checkAgainstDense(createBandedMatrix(12, 11), 20);
+  }
+}
+
+TEST(TestBandedMatrix, TestEntriesOutsideBandIgnored)
+{
+  srand(2);
+  const int size = 15;
+  const int bandwidth = 2;
+  MatrixXd dense = createBandedMatrix(size, bandwidth);
+  MatrixXd full = dense;
+  for (int i=0; i<size; ++i)
+  {
+    for (int j=0; j<size; ++j)
+    {
+      if (abs(i-j) > bandwidth)
+        full(i,j) = 100.0;
+    }
+  }
+
+  BandedMatrix banded;
+  ASSERT_TRUE(banded.initialize(full, bandwidth));
+  VectorXd input = VectorXd::Random(size);
+  VectorXd output;
+  banded.multiply(input, output);
+  EXPECT_LT((output - dense*input).cwiseAbs().maxCoeff(), TOLERANCE);
+}
+
+TEST(TestBandedMatrix, TestInvalidInput)
+{
+  BandedMatrix banded;
+  EXPECT_FALSE(banded.initialize(MatrixXd::Identity(3,4), 1));
+  EXPECT_FALSE(banded.initialize(MatrixXd::Identity(3,3), -1));
+
+  // symmetric, but with a negative eigenvalue
+  MatrixXd indefinite = MatrixXd::Identity(4,4);
+  indefinite(1,0) = indefinite(0,1) = 2.0;
+  ASSERT_TRUE(banded.initialize(indefinite, 1));
+  EXPECT_FALSE(banded.factorize());
+  EXPECT_FALSE(banded.isFactorized());
+}
+
+TEST(TestBandedMatrix, TestSample)
+{
+  srand(3);
+  const int size = 6;
+  const int bandwidth = 2;
+  const int num_samples = 200000;
+  MatrixXd precision = createBandedMatrix(size, bandwidth);
+  BandedMatrix banded;
+  ASSERT_TRUE(banded.initialize(precision, bandwidth));
+  ASSERT_TRUE(banded.factorize());
+
+  VectorXd mean = VectorXd::LinSpaced(size, -1.0, 1.0);
+  MultivariateGaussian gaussian(mean, banded);
+  VectorXd sample = VectorXd::Zero(size);
+  VectorXd sample_mean = VectorXd::Zero(size);
+  MatrixXd sample_covariance = MatrixXd::Zero(size, size);
+  for (int i=0; i<num_samples; ++i)
+  {
+    gaussian.sample(sample);
+    sample_mean += sample;
+    sample_covariance += (sample - mean) * (sample - mean).transpose();
+  }
+  sample_mean /= num_samples;
+  sample_covariance /= num_samples;
+
+  // the covariance of the samples is the inverse of the precision, variances are below 1,
+  // hence the standard errors of the estimates are below 3e-3
+  const MatrixXd covariance = precision.inverse();
+  EXPECT_LT((sample_mean - mean).cwiseAbs().maxCoeff(), 1e-2);
+  EXPECT_LT((sample_covariance - covariance).cwiseAbs().maxCoeff(), 1e-2);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
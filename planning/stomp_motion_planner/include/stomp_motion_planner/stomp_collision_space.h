@@ -112,7 +112,12 @@ private:
   double field_bias_y_;
   double field_bias_z_;
 
-  void getVoxelsInBody(const bodies::Body &body, std::vector<tf::Vector3> &voxels);
+  /**
+   * \brief Adds the voxels of the distance field occupied by the shape (see distance_field::ShapeVoxelizer), shapes
+   * other than spheres, boxes and cylinders are voxelized as meshes.
+   */
+  void getVoxelsInShape(const arm_navigation_msgs::Shape& shape, const tf::Transform& pose, std::vector<tf::Vector3>& voxels);
+
   void addCollisionObjectToPoints(std::vector<tf::Vector3>& points, const arm_navigation_msgs::CollisionObject& object);
 
 };
@@ -36,6 +36,7 @@
 
 #include <stomp_motion_planner/stomp_collision_space.h>
 #include <planning_environment/util/construct_object.h>
+#include <distance_field/shape_voxelizer.h>
 #include <planning_environment/models/model_utils.h>
 #include <sstream>
 
@@ -93,17 +94,7 @@ void StompCollisionSpace::setPlanningScene(const arm_navigation_msgs::PlanningSc
   {
     const arm_navigation_msgs::CollisionObject& object = planning_scene.collision_objects[i];
     ROS_ASSERT(object.shapes.size() == object.poses.size());
-    for (unsigned int j=0; j<object.shapes.size(); ++j)
-    {
-      shapes::Shape* shape = planning_environment::constructObject(object.shapes[j]);
-      bodies::Body *body = bodies::createBodyFromShape(shape);
-      tf::Transform body_pose;
-      tf::poseMsgToTF(object.poses[j], body_pose);
-      body->setPose(body_pose);
-      getVoxelsInBody(*body, all_points);
-      delete body;
-      delete shape;
-    }
+    addCollisionObjectToPoints(all_points, object);
   }
 
   ROS_DEBUG_STREAM("All points size " << all_points.size());
@@ -118,22 +109,9 @@ void StompCollisionSpace::addCollisionObjectToPoints(std::vector<tf::Vector3>& p
 {
   for (unsigned int j=0; j<object.shapes.size(); ++j)
   {
-    // TODO everything handled using MESH method, could be much faster for primitive types!!
-    //if (object.shapes[j].type == arm_navigation_msgs::Shape::MESH)
-    {
-      shapes::Shape* shape = planning_environment::constructObject(object.shapes[j]);
-      bodies::Body *body = bodies::createBodyFromShape(shape);
-      tf::Transform body_pose;
-      tf::poseMsgToTF(object.poses[j], body_pose);
-      body->setPose(body_pose);
-      getVoxelsInBody(*body, points);
-      delete body;
-      delete shape;
-    }
-    //else if (object.shapes[j].type == arm_navigation_msgs::Shape::BOX)
-    {
-
-    }
+    tf::Transform pose;
+    tf::poseMsgToTF(object.poses[j], pose);
+    getVoxelsInShape(object.shapes[j], pose, points);
   }
 /*
 
@@ -220,45 +198,19 @@ void StompCollisionSpace::addCollisionObjectToPoints(std::vector<tf::Vector3>& p
   }*/
 }
 
-void StompCollisionSpace::getVoxelsInBody(const bodies::Body &body, std::vector<tf::Vector3> &voxels)
+void StompCollisionSpace::getVoxelsInShape(const arm_navigation_msgs::Shape& shape, const tf::Transform& pose,
+                                           std::vector<tf::Vector3>& voxels)
 {
-  bodies::BoundingSphere bounding_sphere;
-
-  body.computeBoundingSphere(bounding_sphere);
-  int x,y,z,x_min,x_max,y_min,y_max,z_min,z_max;
-  double xw,yw,zw;
-  tf::Vector3 v;
-	
-  worldToGrid(bounding_sphere.center,bounding_sphere.center.x()-bounding_sphere.radius,bounding_sphere.center.y()-bounding_sphere.radius,	
-              bounding_sphere.center.z()-bounding_sphere.radius, x_min,y_min,z_min);
-  worldToGrid(bounding_sphere.center,bounding_sphere.center.x()+bounding_sphere.radius,bounding_sphere.center.y()+bounding_sphere.radius,	
-              bounding_sphere.center.z()+bounding_sphere.radius, x_max,y_max,z_max);
-	
-  for(x = x_min; x <= x_max; ++x)
-  {
-    for(y = y_min; y <= y_max; ++y)
-    {
-      for(z = z_min; z <= z_max; ++z)
-      {
-        gridToWorld(bounding_sphere.center,x,y,z,xw,yw,zw);
-
-        v.setX(xw);
-        v.setY(yw);
-        v.setZ(zw);
-        // compute all intersections
-        int count=0;
-        std::vector<tf::Vector3> pts;
-        body.intersectsRay(v, tf::Vector3(0, 0, 1), &pts, count);
-
-        // if we have an odd number of intersections, we are inside
-        if (pts.size() % 2 == 1)
-          voxels.push_back(v);
-      }
-    }
-  }
-
-
-  // 	ROS_INFO("number of occupied voxels in bounding sphere: %i", voxels.size());
+  distance_field::ShapeVoxelizer voxelizer(*distance_field_);
+  if (voxelizer.getVoxelsInShape(shape, pose, voxels))
+    return;
+  if (shape.type != arm_navigation_msgs::Shape::MESH)
+    ROS_WARN("Shape of type %d has an invalid number of dimensions, voxelizing it as a mesh.", shape.type);
+  shapes::Shape* mesh = planning_environment::constructObject(shape);
+  if (mesh == NULL)
+    return;
+  voxelizer.getVoxelsInBody(*mesh, pose, voxels);
+  delete mesh;
 }
 
 }
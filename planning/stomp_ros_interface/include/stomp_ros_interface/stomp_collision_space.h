@@ -78,6 +78,11 @@ public:
 
   double getDistance(double x, double y, double z) const;
 
+  /**
+   * \brief Gets the interpolated distances (and gradients if not NULL) at a batch of points stored as x,y,z,x,y,z,...
+   */
+  void getInterpolatedDistanceGradients(const double* points, int num_points, double* distances, double* gradients) const;
+
   void setPlanningScene(const arm_navigation_msgs::PlanningScene& planning_scene);
 
   const arm_navigation_msgs::PlanningScene& getPlanningScene();
@@ -117,7 +122,12 @@ private:
 
   arm_navigation_msgs::PlanningScene planning_scene_;
 
-  void getVoxelsInBody(const bodies::Body &body, std::vector<tf::Vector3> &voxels);
+  /**
+   * \brief Adds the voxels of the distance field occupied by the shape (see distance_field::ShapeVoxelizer), shapes
+   * other than spheres, boxes and cylinders are voxelized as meshes.
+   */
+  void getVoxelsInShape(const arm_navigation_msgs::Shape& shape, const tf::Transform& pose, std::vector<tf::Vector3>& voxels);
+
   void addCollisionObjectToPoints(std::vector<tf::Vector3>& points, const arm_navigation_msgs::CollisionObject& object);
 
 };
@@ -136,6 +146,12 @@ inline double StompCollisionSpace::getDistance(double x, double y, double z) con
   //return distance_field_->get
 }
 
+inline void StompCollisionSpace::getInterpolatedDistanceGradients(const double* points, int num_points,
+                                                                  double* distances, double* gradients) const
+{
+  distance_field_->getInterpolatedDistanceGradients(points, num_points, distances, gradients);
+}
+
 inline bool StompCollisionSpace::getCollisionPointDistance(const StompCollisionPoint& collision_point, const KDL::Vector& collision_point_pos, double& distance) const
 {
   distance = getDistance(collision_point_pos.x(), collision_point_pos.y(), collision_point_pos.z());
@@ -38,6 +38,7 @@ public:
   std::vector<KDL::Vector> collision_point_pos_;
   std::vector<KDL::Vector> collision_point_vel_;
   std::vector<KDL::Vector> collision_point_acc_;
+  std::vector<double> collision_point_distance_;  /**< interpolated distance field value at each collision point */
   //KDL::Twist
   double time_;
   int time_index_;
@@ -46,7 +47,12 @@ public:
   boost::shared_ptr<StompRobotModel const> robot_model_;
   const StompRobotModel::StompPlanningGroup* planning_group_;
 
-  void doFK(boost::shared_ptr<KDL::TreeFkSolverJointPosAxisPartial> fk_solver);
+  /**
+   * Computes forward kinematics for joint_angles_. If the input of the previous time step is given,
+   * only the part of the chain that moved since then is recomputed.
+   */
+  void doFK(boost::shared_ptr<KDL::TreeFkSolverJointPosAxisPartial> fk_solver,
+            const StompCostFunctionInput* previous = NULL);
 
   void publishVizMarkers(const ros::Time& stamp, ros::Publisher& publisher);
 
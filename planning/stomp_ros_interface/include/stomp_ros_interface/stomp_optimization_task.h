@@ -46,6 +46,8 @@ public:
 
   virtual bool filter(std::vector<Eigen::VectorXd>& parameters, int thread_id);
 
+  virtual bool setMaxRollouts(int max_rollouts);
+
   void computeFeatures(std::vector<Eigen::VectorXd>& parameters,
                        Eigen::MatrixXd& features,
                        int thread_id,
@@ -81,13 +83,13 @@ public:
     Eigen::MatrixXd weighted_features_; // num_time x num_features
     Eigen::VectorXd costs_;
 
-    // temp data structures for differentiation
-    std::vector<Eigen::VectorXd> tmp_joint_angles_;     // one per dimension
-    std::vector<Eigen::VectorXd> tmp_joint_angles_vel_; // one per dimension
-    std::vector<Eigen::VectorXd> tmp_joint_angles_acc_; // one per dimension
-    std::vector<std::vector<Eigen::VectorXd> > tmp_collision_point_pos_; // [collision_point_index][x/y/z]
-    std::vector<std::vector<Eigen::VectorXd> > tmp_collision_point_vel_; // [collision_point_index][x/y/z]
-    std::vector<std::vector<Eigen::VectorXd> > tmp_collision_point_acc_; // [collision_point_index][x/y/z]
+    // temp data structures for differentiation, contiguous over time
+    Eigen::MatrixXd tmp_joint_angles_;          // num_time x num_joints
+    Eigen::MatrixXd tmp_joint_angles_vel_;      // num_time x num_joints
+    Eigen::MatrixXd tmp_joint_angles_acc_;      // num_time x num_joints
+    Eigen::MatrixXd tmp_collision_point_pos_;   // num_time x (num_collision_points * 3), column 3*collision_point_index + x/y/z
+    Eigen::MatrixXd tmp_collision_point_vel_;   // num_time x (num_collision_points * 3)
+    Eigen::MatrixXd tmp_collision_point_acc_;   // num_time x (num_collision_points * 3)
 
     void differentiate(double dt);
     void publishMarkers(ros::Publisher& viz_pub, int id, bool noiseless);
@@ -106,12 +108,15 @@ public:
   void setTrajectoryVizPublisher(ros::Publisher& viz_trajectory_pub);
 
 private:
+  void allocateRolloutData(PerThreadData& data);
+
   boost::shared_ptr<stomp::CovariantMovementPrimitive> policy_;
   boost::shared_ptr<learnable_cost_function::FeatureSet> feature_set_;
   double control_cost_weight_;
   std::vector<PerThreadData> per_thread_data_;
-  std::vector<PerThreadData> noisy_rollout_data_;
+  std::vector<PerThreadData> noisy_rollout_data_;   // pre-allocated pool, one per rollout
   PerThreadData noiseless_rollout_data_;
+  int max_rollouts_;
   boost::shared_ptr<StompCollisionSpace> collision_space_;
   ros::NodeHandle node_handle_;
 
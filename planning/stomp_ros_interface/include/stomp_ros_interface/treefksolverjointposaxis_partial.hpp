@@ -59,6 +59,14 @@ public:
   int JntToCartFull(const JntArray& q_in, std::vector<Vector>& joint_pos, std::vector<Vector>& joint_axis, std::vector<Frame>& segment_frames);
   int JntToCartPartial(const JntArray& q_in, std::vector<Vector>& joint_pos, std::vector<Vector>& joint_axis, std::vector<Frame>& segment_frames) const;
 
+  /**
+   * Partial FK starting from the result for a previous joint configuration (eg. the previous time step of a trajectory).
+   * Active segments whose joint and parent frame did not change are copied from prev_segment_frames instead of recomputed.
+   * Inactive segments are expected to already be in segment_frames. Falls back to full FK if it was never done.
+   */
+  int JntToCartPartial(const JntArray& q_in, const JntArray& q_prev, const std::vector<Frame>& prev_segment_frames,
+                       std::vector<Vector>& joint_pos, std::vector<Vector>& joint_axis, std::vector<Frame>& segment_frames);
+
   const std::vector<std::string> getSegmentNames() const;
   const std::map<std::string, int> getSegmentNameToIndex() const;
 
@@ -87,6 +95,7 @@ private:
   std::vector<const TreeElement*> joint_parent_;            /**< the parent segment for each joint */
   std::vector<bool> active_joints_;             /**< which are the joints that will change in calls to partial FK */
   std::vector<bool> joint_calc_pos_axis_;       /**< which joints should we calculate the position and axis for */
+  std::vector<bool> segment_changed_;           /**< scratch space: which segments changed since the previous configuration */
 
   void assignSegmentNumber(const SegmentMap::const_iterator this_segment);
 
@@ -75,9 +75,9 @@ void CollisionFeature::computeValuesAndGradients(boost::shared_ptr<learnable_cos
 //    bool in_collision = input->collision_space_->getCollisionPointPotential(
 //        input->planning_group_->collision_points_[i], input->collision_point_pos_[i], potential);
 
-    double distance = 0.0;
-    bool in_collision = input->collision_space_->getCollisionPointDistance(
-        input->planning_group_->collision_points_[i], input->collision_point_pos_[i], distance);
+    // interpolated field distance, looked up for all collision points in StompOptimizationTask::computeFeatures
+    double distance = input->collision_point_distance_[i] - input->planning_group_->collision_points_[i].getRadius();
+    bool in_collision = (distance <= 0.0);
 
     double potential = 0.0;
     double clearance = input->planning_group_->collision_points_[i].getClearance();
@@ -36,6 +36,7 @@
 
 #include <stomp_ros_interface/stomp_collision_space.h>
 #include <planning_environment/util/construct_object.h>
+#include <distance_field/shape_voxelizer.h>
 #include <planning_environment/models/model_utils.h>
 #include <sstream>
 
@@ -118,43 +119,9 @@ void StompCollisionSpace::addCollisionObjectToPoints(std::vector<tf::Vector3>& p
   ROS_ASSERT(object.shapes.size() == object.poses.size());
   for (unsigned int j=0; j<object.shapes.size(); ++j)
   {
-    // TODO everything handled using MESH method, could be much faster for primitive types!!
-
     tf::Transform pose;
     tf::poseMsgToTF(object.poses[j], pose);
-
-    if (object.shapes[j].type == arm_navigation_msgs::Shape::BOX)
-    {
-      double x_extent = object.shapes[j].dimensions[0]/2.0;
-      double y_extent = object.shapes[j].dimensions[1]/2.0;
-      double z_extent = object.shapes[j].dimensions[2]/2.0;
-
-      for(double x = -x_extent; x <= x_extent+resolution_; x += resolution_)
-      {
-        for(double y = -y_extent; y <= y_extent+resolution_; y += resolution_)
-        {
-          for(double z = -z_extent; z <= z_extent+resolution_; z += resolution_)
-          {
-            tf::Vector3 p(x, y, z);
-            tf::Vector3 pp = pose*p;
-            //ROS_INFO("Point: %f, %f, %f", pp.x(), pp.y(), pp.z());
-            points.push_back(pp);
-          }
-        }
-      }
-
-    }
-    else if (object.shapes[j].type == arm_navigation_msgs::Shape::MESH)
-    {
-      shapes::Shape* shape = planning_environment::constructObject(object.shapes[j]);
-      bodies::Body *body = bodies::createBodyFromShape(shape);
-      tf::Transform body_pose;
-      tf::poseMsgToTF(object.poses[j], body_pose);
-      body->setPose(body_pose);
-      getVoxelsInBody(*body, points);
-      delete body;
-      delete shape;
-    }
+    getVoxelsInShape(object.shapes[j], pose, points);
   }
 /*
 
@@ -241,45 +208,19 @@ void StompCollisionSpace::addCollisionObjectToPoints(std::vector<tf::Vector3>& p
   }*/
 }
 
-void StompCollisionSpace::getVoxelsInBody(const bodies::Body &body, std::vector<tf::Vector3> &voxels)
+void StompCollisionSpace::getVoxelsInShape(const arm_navigation_msgs::Shape& shape, const tf::Transform& pose,
+                                           std::vector<tf::Vector3>& voxels)
 {
-  bodies::BoundingSphere bounding_sphere;
-
-  body.computeBoundingSphere(bounding_sphere);
-  int x,y,z,x_min,x_max,y_min,y_max,z_min,z_max;
-  double xw,yw,zw;
-  tf::Vector3 v;
-	
-  worldToGrid(bounding_sphere.center,bounding_sphere.center.x()-bounding_sphere.radius,bounding_sphere.center.y()-bounding_sphere.radius,	
-              bounding_sphere.center.z()-bounding_sphere.radius, x_min,y_min,z_min);
-  worldToGrid(bounding_sphere.center,bounding_sphere.center.x()+bounding_sphere.radius,bounding_sphere.center.y()+bounding_sphere.radius,	
-              bounding_sphere.center.z()+bounding_sphere.radius, x_max,y_max,z_max);
-	
-  for(x = x_min; x <= x_max; ++x)
-  {
-    for(y = y_min; y <= y_max; ++y)
-    {
-      for(z = z_min; z <= z_max; ++z)
-      {
-        gridToWorld(bounding_sphere.center,x,y,z,xw,yw,zw);
-
-        v.setX(xw);
-        v.setY(yw);
-        v.setZ(zw);
-        // compute all intersections
-        int count=0;
-        std::vector<tf::Vector3> pts;
-        body.intersectsRay(v, tf::Vector3(0, 0, 1), &pts, count);
-
-        // if we have an odd number of intersections, we are inside
-        if (pts.size() % 2 == 1)
-          voxels.push_back(v);
-      }
-    }
-  }
-
-
-  // 	ROS_INFO("number of occupied voxels in bounding sphere: %i", voxels.size());
+  distance_field::ShapeVoxelizer voxelizer(*distance_field_);
+  if (voxelizer.getVoxelsInShape(shape, pose, voxels))
+    return;
+  if (shape.type != arm_navigation_msgs::Shape::MESH)
+    ROS_WARN("Shape of type %d has an invalid number of dimensions, voxelizing it as a mesh.", shape.type);
+  shapes::Shape* mesh = planning_environment::constructObject(shape);
+  if (mesh == NULL)
+    return;
+  voxelizer.getVoxelsInBody(*mesh, pose, voxels);
+  delete mesh;
 }
 
 }
@@ -34,6 +34,7 @@ StompCostFunctionInput::StompCostFunctionInput(boost::shared_ptr<StompCollisionS
   collision_point_pos_.resize(nc);
   collision_point_vel_.resize(nc);
   collision_point_acc_.resize(nc);
+  collision_point_distance_.resize(nc, 0.0);
   full_fk_done_ = false;
 }
 
@@ -46,7 +47,8 @@ int StompCostFunctionInput::getNumDimensions() const
   return planning_group_->num_joints_;
 }
 
-void StompCostFunctionInput::doFK(boost::shared_ptr<KDL::TreeFkSolverJointPosAxisPartial> fk_solver)
+void StompCostFunctionInput::doFK(boost::shared_ptr<KDL::TreeFkSolverJointPosAxisPartial> fk_solver,
+                                  const StompCostFunctionInput* previous)
 {
   // first copy the group joints into all_joints:
   for (int i=0; i<planning_group_->num_joints_; ++i)
@@ -56,15 +58,21 @@ void StompCostFunctionInput::doFK(boost::shared_ptr<KDL::TreeFkSolverJointPosAxi
     all_joint_angles_(kdl_index) = joint_angles_(i);
   }
 
-  //  if (!full_fk_done_)
+  if (!full_fk_done_)
   {
+    // fills in the frames of the segments that are not moved by this group
     fk_solver->JntToCartFull(all_joint_angles_, joint_pos_, joint_axis_, segment_frames_);
     full_fk_done_ = true;
   }
-//  else
-//  {
-//    fk_solver->JntToCartPartial(joint_angles_, joint_pos_, joint_axis_, segment_frames_);
-//  }
+  else if (previous != NULL && previous->full_fk_done_)
+  {
+    fk_solver->JntToCartPartial(all_joint_angles_, previous->all_joint_angles_, previous->segment_frames_,
+                                joint_pos_, joint_axis_, segment_frames_);
+  }
+  else
+  {
+    fk_solver->JntToCartPartial(all_joint_angles_, joint_pos_, joint_axis_, segment_frames_);
+  }
 
 //  for (unsigned int i=0; i<segment_frames_.size(); ++i)
 //  {
@@ -26,6 +26,8 @@ StompOptimizationTask::StompOptimizationTask(ros::NodeHandle node_handle,
 {
   viz_pub_ = node_handle_.advertise<visualization_msgs::MarkerArray>("robot_model_array", 10, true);
   max_rollout_markers_published_ = 0;
+  max_rollouts_ = 0;
+  last_executed_rollout_ = -1;
 }
 
 StompOptimizationTask::~StompOptimizationTask()
@@ -157,85 +159,84 @@ bool StompOptimizationTask::execute(std::vector<Eigen::VectorXd>& parameters,
   computeFeatures(parameters, per_thread_data_[thread_id].features_, thread_id, validity);
   computeCosts(per_thread_data_[thread_id].features_, costs, weighted_feature_values);
 
-  // copying it to per_rollout_data
+  // hand the data over to the per-rollout storage by swapping buffers, the thread
+  // gets the previously stored buffers back as scratch space for its next rollout
   PerThreadData* rdata = &noiseless_rollout_data_;
   if (rollout_number >= 0)
   {
-    if ((int)noisy_rollout_data_.size() <= rollout_number)
-    {
-      noisy_rollout_data_.resize(rollout_number+1);
-    }
+    ROS_ASSERT_MSG(rollout_number < (int)noisy_rollout_data_.size(),
+                   "Rollout %d exceeds the pre-allocated %d rollouts, call setMaxRollouts() first.",
+                   rollout_number, (int)noisy_rollout_data_.size());
     rdata = &(noisy_rollout_data_[rollout_number]);
     last_executed_rollout_ = rollout_number;
   }
-  *rdata = per_thread_data_[thread_id];
-  // duplicate the cost function inputs
-  for (unsigned int i=0; i<rdata->cost_function_input_.size(); ++i)
-  {
-    boost::shared_ptr<StompCostFunctionInput> input(new StompCostFunctionInput(
-        collision_space_, rdata->robot_model_, rdata->planning_group_));
-    *input = *rdata->cost_function_input_[i];
-    rdata->cost_function_input_[i] = input;
-  }
+  rdata->cost_function_input_.swap(per_thread_data_[thread_id].cost_function_input_);
+  rdata->features_.swap(per_thread_data_[thread_id].features_);
   return true;
 }
 
-void StompOptimizationTask::PerThreadData::differentiate(double dt)
+bool StompOptimizationTask::setMaxRollouts(int max_rollouts)
 {
-  int num_time_steps = cost_function_input_.size();
-  int num_joint_angles = planning_group_->num_joints_;
-  int num_collision_points = planning_group_->collision_points_.size();
-
-  // copy to temp structures
-  for (int t=0; t<num_time_steps; ++t)
+  max_rollouts_ = max_rollouts;
+  // the noiseless rollout may be added on top of max_rollouts
+  noisy_rollout_data_.resize(max_rollouts_+1);
+  for (unsigned int r=0; r<noisy_rollout_data_.size(); ++r)
   {
-    for (int c=0; c<num_collision_points; ++c)
-    {
-      for (int d=0; d<3; ++d)
-      {
-        tmp_collision_point_pos_[c][d](t) = cost_function_input_[t]->collision_point_pos_[c][d];
-      }
-    }
-    for (int j=0; j<num_joint_angles; ++j)
-    {
-      tmp_joint_angles_[j](t) = cost_function_input_[t]->joint_angles_(j);
-    }
+    allocateRolloutData(noisy_rollout_data_[r]);
   }
+  return true;
+}
 
-  // do differentiation
-  for (int j=0; j<num_joint_angles; ++j)
-  {
-    stomp::differentiate(tmp_joint_angles_[j], stomp::STOMP_VELOCITY,
-                         tmp_joint_angles_vel_[j], dt);
-    stomp::differentiate(tmp_joint_angles_[j], stomp::STOMP_ACCELERATION,
-                         tmp_joint_angles_acc_[j], dt);
-  }
-  for (int c=0; c<num_collision_points; ++c)
+void StompOptimizationTask::allocateRolloutData(PerThreadData& data)
+{
+  // rollout data only holds results, so it shares the models of the first thread
+  // and never owns a kinematic state
+  data.robot_model_ = per_thread_data_[0].robot_model_;
+  data.planning_group_ = per_thread_data_[0].planning_group_;
+  data.collision_models_ = per_thread_data_[0].collision_models_;
+  data.kinematic_state_ = NULL;
+  data.joint_state_group_ = NULL;
+  if ((int)data.cost_function_input_.size() != num_time_steps_)
   {
-    for (int d=0; d<3; ++d)
+    data.cost_function_input_.resize(num_time_steps_);
+    for (int t=0; t<num_time_steps_; ++t)
     {
-      stomp::differentiate(tmp_collision_point_pos_[c][d], stomp::STOMP_VELOCITY,
-                           tmp_collision_point_vel_[c][d], dt);
-      stomp::differentiate(tmp_collision_point_pos_[c][d], stomp::STOMP_ACCELERATION,
-                           tmp_collision_point_acc_[c][d], dt);
+      data.cost_function_input_[t].reset(new StompCostFunctionInput(
+          collision_space_, data.robot_model_, data.planning_group_));
     }
   }
+  data.features_.resize(num_time_steps_, num_split_features_);
+}
+
+void StompOptimizationTask::PerThreadData::differentiate(double dt)
+{
+  int num_time_steps = cost_function_input_.size();
+  int num_joint_angles = planning_group_->num_joints_;
+  int num_collision_points = planning_group_->collision_points_.size();
+
+  // differentiate all trajectories at once, positions were filled in during FK
+  stomp::differentiate(tmp_joint_angles_, stomp::STOMP_VELOCITY, tmp_joint_angles_vel_, dt);
+  stomp::differentiate(tmp_joint_angles_, stomp::STOMP_ACCELERATION, tmp_joint_angles_acc_, dt);
+  stomp::differentiate(tmp_collision_point_pos_, stomp::STOMP_VELOCITY, tmp_collision_point_vel_, dt);
+  stomp::differentiate(tmp_collision_point_pos_, stomp::STOMP_ACCELERATION, tmp_collision_point_acc_, dt);
 
   // copy the differentiated data back
   for (int t=0; t<num_time_steps; ++t)
   {
+    StompCostFunctionInput& input = *cost_function_input_[t];
     for (int c=0; c<num_collision_points; ++c)
     {
-      for (int d=0; d<3; ++d)
-      {
-        cost_function_input_[t]->collision_point_vel_[c][d] = tmp_collision_point_vel_[c][d](t);
-        cost_function_input_[t]->collision_point_acc_[c][d] = tmp_collision_point_acc_[c][d](t);
-      }
+      input.collision_point_vel_[c] = KDL::Vector(tmp_collision_point_vel_(t,3*c),
+                                                  tmp_collision_point_vel_(t,3*c+1),
+                                                  tmp_collision_point_vel_(t,3*c+2));
+      input.collision_point_acc_[c] = KDL::Vector(tmp_collision_point_acc_(t,3*c),
+                                                  tmp_collision_point_acc_(t,3*c+1),
+                                                  tmp_collision_point_acc_(t,3*c+2));
     }
     for (int j=0; j<num_joint_angles; ++j)
     {
-      cost_function_input_[t]->joint_angles_vel_(j) = tmp_joint_angles_vel_[j](t);
-      cost_function_input_[t]->joint_angles_acc_(j) = tmp_joint_angles_acc_[j](t);
+      input.joint_angles_vel_(j) = tmp_joint_angles_vel_(t,j);
+      input.joint_angles_acc_(j) = tmp_joint_angles_acc_(t,j);
     }
   }
 }
@@ -248,20 +249,44 @@ void StompOptimizationTask::computeFeatures(std::vector<Eigen::VectorXd>& parame
   // prepare the cost function input
   std::vector<double> temp_features(feature_set_->getNumValues());
   std::vector<Eigen::VectorXd> temp_gradients(feature_set_->getNumValues());
-  std::vector<double> joint_angles(num_dimensions_);
 
-  // do all forward kinematics
+  // do all forward kinematics, consecutive time steps share the unchanged part of the chain
+  PerThreadData& data = per_thread_data_[thread_id];
+  int num_collision_points = data.planning_group_->collision_points_.size();
   validity = true;
   bool state_validity;
+  for (int d=0; d<num_dimensions_; ++d)
+  {
+    data.tmp_joint_angles_.col(d) = parameters[d];
+  }
   for (int t=0; t<num_time_steps_; ++t)
   {
+    StompCostFunctionInput& input = *data.cost_function_input_[t];
+    if (input.planning_group_ != data.planning_group_)
+    {
+      // this buffer was handed over from the rollout storage, bind it to this thread's models
+      input.robot_model_ = data.robot_model_;
+      input.planning_group_ = data.planning_group_;
+    }
     for (int d=0; d<num_dimensions_; ++d)
     {
-      per_thread_data_[thread_id].cost_function_input_[t]->joint_angles_(d) = parameters[d](t);
-      joint_angles[d] = parameters[d](t);
+      input.joint_angles_(d) = parameters[d](t);
+    }
+    input.doFK(data.planning_group_->fk_solver_, (t > 0) ? data.cost_function_input_[t-1].get() : NULL);
+    input.per_thread_data_ = &data;
+    if (num_collision_points > 0)
+    {
+      // look up the distance field for all collision points at once, KDL::Vector stores x,y,z contiguously
+      collision_space_->getInterpolatedDistanceGradients(input.collision_point_pos_[0].data, num_collision_points,
+                                                         &input.collision_point_distance_[0], NULL);
+    }
+    for (int c=0; c<num_collision_points; ++c)
+    {
+      for (int d=0; d<3; ++d)
+      {
+        data.tmp_collision_point_pos_(t,3*c+d) = input.collision_point_pos_[c][d];
+      }
     }
-    per_thread_data_[thread_id].cost_function_input_[t]->doFK(per_thread_data_[thread_id].planning_group_->fk_solver_);
-    per_thread_data_[thread_id].cost_function_input_[t]->per_thread_data_ = &(per_thread_data_[thread_id]);
   }
 
   per_thread_data_[thread_id].differentiate(dt_);
@@ -388,14 +413,19 @@ void StompOptimizationTask::setMotionPlanRequest(const arm_navigation_msgs::Moti
     }
     per_thread_data_[i].features_ = Eigen::MatrixXd(num_time_steps_, num_split_features_);
 
-    per_thread_data_[i].tmp_joint_angles_.resize(num_dimensions_, Eigen::VectorXd(num_time_steps_));
-    per_thread_data_[i].tmp_joint_angles_vel_.resize(num_dimensions_, Eigen::VectorXd(num_time_steps_));
-    per_thread_data_[i].tmp_joint_angles_acc_.resize(num_dimensions_, Eigen::VectorXd(num_time_steps_));
-    std::vector<Eigen::VectorXd> v(3, Eigen::VectorXd(num_time_steps_));
+    per_thread_data_[i].tmp_joint_angles_ = Eigen::MatrixXd::Zero(num_time_steps_, num_dimensions_);
+    per_thread_data_[i].tmp_joint_angles_vel_ = Eigen::MatrixXd::Zero(num_time_steps_, num_dimensions_);
+    per_thread_data_[i].tmp_joint_angles_acc_ = Eigen::MatrixXd::Zero(num_time_steps_, num_dimensions_);
     int nc = per_thread_data_[i].planning_group_->collision_points_.size();
-    per_thread_data_[i].tmp_collision_point_pos_.resize(nc, v);
-    per_thread_data_[i].tmp_collision_point_vel_.resize(nc, v);
-    per_thread_data_[i].tmp_collision_point_acc_.resize(nc, v);
+    per_thread_data_[i].tmp_collision_point_pos_ = Eigen::MatrixXd::Zero(num_time_steps_, 3*nc);
+    per_thread_data_[i].tmp_collision_point_vel_ = Eigen::MatrixXd::Zero(num_time_steps_, 3*nc);
+    per_thread_data_[i].tmp_collision_point_acc_ = Eigen::MatrixXd::Zero(num_time_steps_, 3*nc);
+  }
+  allocateRolloutData(noiseless_rollout_data_);
+  if (max_rollouts_ > 0)
+  {
+    // adapt the rollout pool to the new number of time steps
+    setMaxRollouts(max_rollouts_);
   }
 
   // create the derivative costs
@@ -67,6 +67,7 @@ TreeFkSolverJointPosAxisPartial::TreeFkSolverJointPosAxisPartial(const Tree& tre
   segment_evaluation_order_.clear();
   joint_calc_pos_axis_.clear();
   joint_calc_pos_axis_.resize(num_joints_, false);
+  segment_changed_.resize(num_segments_, false);
   full_fk_done_ = false;
 }
 
@@ -120,6 +121,7 @@ int TreeFkSolverJointPosAxisPartial::JntToCartFull(const JntArray& q_in, std::ve
   }
 
   segment_frames_ = segment_frames;
+  full_fk_done_ = true;
 
   return 0;
 }
@@ -158,6 +160,57 @@ int TreeFkSolverJointPosAxisPartial::JntToCartPartial(const JntArray& q_in, std:
   return 0;
 }
 
+int TreeFkSolverJointPosAxisPartial::JntToCartPartial(const JntArray& q_in, const JntArray& q_prev, const std::vector<Frame>& prev_segment_frames,
+                                                      std::vector<Vector>& joint_pos, std::vector<Vector>& joint_axis, std::vector<Frame>& segment_frames)
+{
+  if (!full_fk_done_)
+    return JntToCartFull(q_in, joint_pos, joint_axis, segment_frames);
+
+  joint_pos.resize(num_joints_);
+  joint_axis.resize(num_joints_);
+  segment_frames.resize(num_segments_);
+
+  // segments are evaluated parents first, so a segment is unchanged if its parent and joint are
+  for (size_t i=0; i<segment_evaluation_order_.size(); ++i)
+  {
+    int segment_nr = segment_evaluation_order_[i];
+    int parent_frame_nr = segment_parent_frame_nr_[segment_nr];
+    const TreeElement* parent_segment = segment_parent_[segment_nr];
+    double jnt_p = 0;
+    bool changed = segment_changed_[parent_frame_nr];
+    if (parent_segment->segment.getJoint().getType() != Joint::None)
+    {
+      jnt_p = q_in(parent_segment->q_nr);
+      if (jnt_p != q_prev(parent_segment->q_nr))
+        changed = true;
+    }
+    segment_changed_[segment_nr] = changed;
+
+    if (changed)
+      segment_frames[segment_nr] =  segment_frames[parent_frame_nr] * parent_segment->segment.pose(jnt_p);
+    else
+      segment_frames[segment_nr] = prev_segment_frames[segment_nr];
+  }
+
+  // now solve for joint positions and axes:
+  for (int i=0; i<num_joints_; ++i)
+  {
+    if (joint_calc_pos_axis_[i])
+    {
+      Frame& frame = segment_frames[joint_parent_frame_nr_[i]];
+      const TreeElement* parent_segment = joint_parent_[i];
+      joint_pos[i] = frame * parent_segment->segment.getJoint().JointOrigin();
+      joint_axis[i] = frame.M * parent_segment->segment.getJoint().JointAxis();
+    }
+  }
+
+  // reset the scratch space for the next call, inactive segments never change
+  for (size_t i=0; i<segment_evaluation_order_.size(); ++i)
+    segment_changed_[segment_evaluation_order_[i]] = false;
+
+  return 0;
+}
+
 int TreeFkSolverJointPosAxisPartial::treeRecursiveFK(const JntArray& q_in, std::vector<Vector>& joint_pos, std::vector<Vector>& joint_axis, std::vector<Frame>& segment_frames,
     const Frame& previous_frame, const SegmentMap::const_iterator this_segment, int segment_nr, int parent_segment_nr, bool active)
 {
@@ -35,7 +35,6 @@
 #include "kdl/chainfksolverpos_recursive.hpp"
 
 #include <Eigen/Geometry>
-#include <Eigen/LU>
 #include <Eigen/Core>
 
 #include <geometry_msgs/Twist.h>
@@ -45,8 +44,11 @@
 
 #include <filters/transfer_function.h>
 
+#include <usc_utilities/latency_monitor.h>
+
 // local includes
 #include <pr2_dynamic_movement_primitive_controller/joint_position_controller.h>
+#include <pr2_dynamic_movement_primitive_controller/nullspace_ik_solver.h>
 
 #include <pr2_dynamic_movement_primitive_controller/JointPositionVelocityStamped.h>
 #include <pr2_dynamic_movement_primitive_controller/PoseTwistStamped.h>
@@ -62,6 +64,15 @@ class CartesianTwistControllerIkWithNullspaceOptimization : public pr2_controlle
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
+  /*! For now, the chain is required to have exactly NUM_JOINTS joints
+   */
+  enum
+  {
+    NUM_CART = 6,
+    NUM_JOINTS = 7
+  };
+  typedef NullspaceIkSolver<NUM_CART, NUM_JOINTS> IkSolver;
+
   /*!
    */
   CartesianTwistControllerIkWithNullspaceOptimization();
@@ -105,7 +116,7 @@ public:
 
   /*! input to the controller for the nullspace optimization part
    */
-  Eigen::VectorXd rest_posture_joint_configuration_;
+  IkSolver::JointVector rest_posture_joint_configuration_;
 
 private:
 
@@ -184,21 +195,17 @@ private:
    */
   int num_joints_;
 
-  Eigen::VectorXd eigen_desired_cartesian_velocities_;
-
-  Eigen::VectorXd eigen_desired_joint_positions_;
-  Eigen::VectorXd eigen_desired_joint_velocities_;
+  IkSolver::CartesianVector eigen_desired_cartesian_velocities_;
 
-  Eigen::MatrixXd eigen_chain_jacobian_;
+  IkSolver::JointVector eigen_desired_joint_positions_;
+  IkSolver::JointVector eigen_desired_joint_velocities_;
 
-  Eigen::MatrixXd eigen_jac_times_jac_transpose_;
-  Eigen::MatrixXd eigen_jjt_inverse_;
-  Eigen::MatrixXd eigen_jac_pseudo_inverse_;
-  Eigen::MatrixXd eigen_identity_;
+  /*! damped pseudo inverse and nullspace projection
+   */
+  IkSolver ik_solver_;
 
-  Eigen::VectorXd eigen_nullspace_term_;
-  Eigen::MatrixXd eigen_nullspace_projector_;
-  Eigen::VectorXd eigen_nullspace_error_;
+  IkSolver::JointVector eigen_nullspace_term_;
+  IkSolver::JointVector eigen_nullspace_error_;
 
   /*!
    */
@@ -230,6 +237,11 @@ private:
   boost::shared_ptr<rosrt::Publisher<pr2_dynamic_movement_primitive_controller::NullspaceTermStamped> > nullspace_term_publisher_;
   // boost::shared_ptr<rosrt::Publisher<pr2_dynamic_movement_primitive_controller::ControllerStatus> > controller_status_publisher_;
 
+  /*! Latency of update()
+   */
+  usc_utilities::LatencyMonitor latency_monitor_;
+  usc_utilities::LatencyHistogram* update_latency_;
+
   /*!
    */
   void publish();
@@ -28,6 +28,7 @@
 #include <usc_utilities/assert.h>
 #include <usc_utilities/constants.h>
 #include <usc_utilities/param_server.h>
+#include <usc_utilities/latency_monitor.h>
 
 #include <dynamic_movement_primitive/dynamic_movement_primitive.h>
 #include <dynamic_movement_primitive/icra2009_dynamic_movement_primitive.h>
@@ -47,7 +48,8 @@ template<class DMPType>
 
     /*! Constructor
      */
-    DMPControllerImplementation() {};
+    DMPControllerImplementation() :
+      is_running_latency_(NULL), propagate_step_latency_(NULL) {};
 
     /*! Destructor
      */
@@ -161,7 +163,7 @@ template<class DMPType>
      */
     bool setDMP(typename DMPType::DMPPtr dmp, bool strict = true);
 
-    /*!
+    /*! Applies all goals received since the last call, in the order they were received
      * @return True on success, otherwise False
      * REAL-TIME REQUIREMENTS
      */
@@ -177,7 +179,13 @@ template<class DMPType>
 
     /*!
      */
-    rosrt::Subscriber<geometry_msgs::PoseStamped> dmp_goal_subscriber_;
+    rosrt::QueuedSubscriber<geometry_msgs::PoseStamped> dmp_goal_subscriber_;
+
+    /*! Latencies of isRunning() and of the propagateStep() call inside it
+     */
+    usc_utilities::LatencyMonitor latency_monitor_;
+    usc_utilities::LatencyHistogram* is_running_latency_;
+    usc_utilities::LatencyHistogram* propagate_step_latency_;
 
   };
 
@@ -221,6 +229,13 @@ template<class DMPType>
     dynamic_movement_primitive::ControllerStatusMsg dmp_status_msg;
     dmp_status_publisher_.initialize(publisher, 10, dmp_status_msg);
 
+    if (!is_running_latency_)
+    {
+      ROS_VERIFY(latency_monitor_.initialize(controller_node_handle));
+      is_running_latency_ = latency_monitor_.addHistogram("is_running");
+      propagate_step_latency_ = latency_monitor_.addHistogram("propagate_step");
+    }
+
     dmp_is_being_executed_ = false;
     dmp_is_set_ = false;
 
@@ -347,11 +362,17 @@ template<class DMPType>
                                                        Eigen::VectorXd& desired_velocities,
                                                        Eigen::VectorXd& desired_accelerations)
   {
+    usc_utilities::ScopedLatencyProbe is_running_probe(is_running_latency_);
     if(dmp_is_set_)
     {
       ROS_VERIFY(changeGoal());
       bool movement_finished = false;
-      if (!dmp_->propagateStep(entire_desired_positions_, entire_desired_velocities_, entire_desired_accelerations_, movement_finished))
+      bool propagated = false;
+      {
+        usc_utilities::ScopedLatencyProbe propagate_step_probe(propagate_step_latency_);
+        propagated = dmp_->propagateStep(entire_desired_positions_, entire_desired_velocities_, entire_desired_accelerations_, movement_finished);
+      }
+      if (!propagated)
       {
         // something went wrong
         publishStatus(dynamic_movement_primitive::ControllerStatusMsg::FAILED, false, ros::Time::now());
@@ -379,8 +400,8 @@ template<class DMPType>
 template<class DMPType>
   bool DMPControllerImplementation<DMPType>::changeGoal()
   {
-    geometry_msgs::PoseStamped::ConstPtr goal_pose = dmp_goal_subscriber_.poll();
-    if (goal_pose)
+    geometry_msgs::PoseStamped::ConstPtr goal_pose;
+    while ((goal_pose = dmp_goal_subscriber_.poll()))
     {
       for (int i = 0; i < num_variables_used_; ++i)
       {
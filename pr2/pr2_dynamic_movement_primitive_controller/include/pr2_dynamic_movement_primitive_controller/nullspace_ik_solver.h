@@ -0,0 +1,107 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks    ...
+
+  \file   nullspace_ik_solver.h
+
+  \date   Oct 17, 2026
+
+ *********************************************************************/
+
+#ifndef NULLSPACE_IK_SOLVER_H_
+#define NULLSPACE_IK_SOLVER_H_
+
+// system includes
+#include <Eigen/Core>
+#include <Eigen/Cholesky>
+
+namespace pr2_dynamic_movement_primitive_controller
+{
+
+/*! Damped least squares velocity IK with nullspace optimization on fixed-size matrices.
+ *
+ * All members are fixed-size, such that neither setJacobian() nor solve() touch the heap.
+ * Instead of explicitly inverting (J*J^T + damping*I), setJacobian() factorizes it (LDLT) and solves
+ * for the transposed pseudo inverse X = (J*J^T + damping*I)^-1 * J. The nullspace projection
+ * (I - J^+ * J) * e is applied as e - X^T * (J * e), which avoids forming the projector.
+ */
+template<int NumCart, int NumJoints>
+  class NullspaceIkSolver
+  {
+
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<double, NumCart, NumJoints> JacobianMatrix;
+    typedef Eigen::Matrix<double, NumCart, NumCart> CartesianMatrix;
+    typedef Eigen::Matrix<double, NumCart, 1> CartesianVector;
+    typedef Eigen::Matrix<double, NumJoints, 1> JointVector;
+
+    /*!
+     */
+    NullspaceIkSolver()
+    {
+      jacobian_.setZero();
+      pseudo_inverse_transpose_.setZero();
+      jac_times_jac_transpose_.setZero();
+      projected_error_.setZero();
+    };
+    virtual ~NullspaceIkSolver() {};
+
+    /*! Computes the damped pseudo inverse of the provided jacobian
+     * @param jacobian
+     * @param damping
+     * REAL-TIME REQUIREMENTS
+     */
+    template<typename Derived>
+      void setJacobian(const Eigen::MatrixBase<Derived>& jacobian,
+                       const double damping)
+      {
+        jacobian_ = jacobian;
+        jac_times_jac_transpose_ = jacobian_ * jacobian_.transpose();
+        for (int i = 0; i < NumCart; ++i)
+        {
+          jac_times_jac_transpose_(i, i) += damping;
+        }
+        ldlt_.compute(jac_times_jac_transpose_);
+        pseudo_inverse_transpose_ = jacobian_;
+        ldlt_.solveInPlace(pseudo_inverse_transpose_);
+      }
+
+    /*!
+     * @param desired_cartesian_velocities
+     * @param nullspace_error
+     * @param nullspace_term (I - J^+ * J) * nullspace_error
+     * @param desired_joint_velocities J^+ * desired_cartesian_velocities + nullspace_term
+     * REAL-TIME REQUIREMENTS
+     */
+    void solve(const CartesianVector& desired_cartesian_velocities,
+               const JointVector& nullspace_error,
+               JointVector& nullspace_term,
+               JointVector& desired_joint_velocities)
+    {
+      projected_error_ = jacobian_ * nullspace_error;
+      nullspace_term = nullspace_error;
+      nullspace_term -= pseudo_inverse_transpose_.transpose() * projected_error_;
+      desired_joint_velocities = pseudo_inverse_transpose_.transpose() * desired_cartesian_velocities;
+      desired_joint_velocities += nullspace_term;
+    }
+
+  private:
+
+    /*!
+     */
+    JacobianMatrix jacobian_;
+    JacobianMatrix pseudo_inverse_transpose_;
+    CartesianMatrix jac_times_jac_transpose_;
+    Eigen::LDLT<CartesianMatrix> ldlt_;
+    CartesianVector projected_error_;
+
+  };
+
+}
+
+#endif /* NULLSPACE_IK_SOLVER_H_ */
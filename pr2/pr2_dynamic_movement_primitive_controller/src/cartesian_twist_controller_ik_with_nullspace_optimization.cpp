@@ -37,12 +37,9 @@ using namespace Eigen;
 namespace pr2_dynamic_movement_primitive_controller
 {
 
-static const int NUM_JOINTS = 7;
-static const int NUM_CART = 6;
-
 CartesianTwistControllerIkWithNullspaceOptimization::CartesianTwistControllerIkWithNullspaceOptimization() :
   robot_state_(NULL), jnt_to_twist_solver_(NULL), jnt_to_pose_solver_(NULL), jnt_to_jac_solver_(NULL), num_joints_(0), publisher_counter_(0),
-      publisher_buffer_size_(0), header_sequence_number_(0)
+      publisher_buffer_size_(0), header_sequence_number_(0), update_latency_(NULL)
 {
 }
 
@@ -54,26 +51,14 @@ bool CartesianTwistControllerIkWithNullspaceOptimization::init(pr2_mechanism_mod
   robot_state_ = robot_state;
   node_handle_ = node_handle;
 
-  rest_posture_joint_configuration_ = VectorXd::Zero(NUM_JOINTS, 1);
-
-  eigen_desired_cartesian_velocities_ = VectorXd::Zero(NUM_CART, 1);
-  eigen_desired_joint_positions_ = VectorXd::Zero(NUM_JOINTS, 1);
-  eigen_desired_joint_velocities_ = VectorXd::Zero(NUM_JOINTS, 1);
-
-  eigen_chain_jacobian_ = MatrixXd::Zero(NUM_CART, NUM_JOINTS);
-
-  eigen_jac_times_jac_transpose_ = MatrixXd::Zero(NUM_CART, NUM_CART);
-  eigen_jjt_inverse_ = MatrixXd::Zero(NUM_CART, NUM_CART);
-  eigen_jac_pseudo_inverse_ = MatrixXd::Zero(NUM_CART, NUM_JOINTS);
-  eigen_identity_ = MatrixXd::Zero(NUM_JOINTS, NUM_JOINTS);
-  eigen_identity_.setIdentity(NUM_JOINTS, NUM_JOINTS);
+  rest_posture_joint_configuration_.setZero();
 
-  eigen_desired_cartesian_velocities_.setZero(NUM_CART, 1);
-  eigen_desired_joint_velocities_.setZero(NUM_JOINTS, 1);
+  eigen_desired_cartesian_velocities_.setZero();
+  eigen_desired_joint_positions_.setZero();
+  eigen_desired_joint_velocities_.setZero();
 
-  eigen_nullspace_projector_ = MatrixXd::Zero(NUM_JOINTS, NUM_JOINTS);
-  eigen_nullspace_term_ = VectorXd::Zero(NUM_JOINTS, 1);
-  eigen_nullspace_error_ = VectorXd::Zero(NUM_JOINTS, 1);
+  eigen_nullspace_term_.setZero();
+  eigen_nullspace_error_.setZero();
 
   ROS_VERIFY(readParameters());
 
@@ -235,6 +220,13 @@ bool CartesianTwistControllerIkWithNullspaceOptimization::initRTPublisher()
   nullspace_term_publisher_.reset(
       new rosrt::Publisher<pr2_dynamic_movement_primitive_controller::NullspaceTermStamped>(node_handle_.advertise<pr2_dynamic_movement_primitive_controller::NullspaceTermStamped> (std::string("nullspace_term"), 1), publisher_buffer_size_, nullspace_term_msg));
 
+  if (!update_latency_)
+  {
+    ROS_VERIFY(latency_monitor_.initialize(node_handle_));
+    // the controller runs at 1kHz
+    update_latency_ = latency_monitor_.addHistogram("update", 1000.0);
+  }
+
   //    pr2_dynamic_movement_primitive_controller::ControllerStatus controller_status_msg;
   //    controller_status_msg.actual_pose.resize(NUM_JOINTS);
   //    controller_status_msg.desired_pose.resize(NUM_JOINTS);
@@ -299,6 +291,7 @@ void CartesianTwistControllerIkWithNullspaceOptimization::starting()
 
 void CartesianTwistControllerIkWithNullspaceOptimization::update()
 {
+  usc_utilities::ScopedLatencyProbe update_probe(update_latency_);
 
   // get time
   ros::Time time = robot_state_->getTime();
@@ -323,20 +316,8 @@ void CartesianTwistControllerIkWithNullspaceOptimization::update()
   // jnt_to_jac_solver_->JntToJac(kdl_current_joint_positions_, kdl_chain_jacobian_);
   jnt_to_jac_solver_->JntToJac(kdl_desired_joint_positions_, kdl_chain_jacobian_);
 
-  // convert to (plain) eigen for easier math
-  eigen_chain_jacobian_ = kdl_chain_jacobian_.data;
-
-  // compute the pseudo inverse
-  // eigen_jac_times_jac_transpose_ = eigen_chain_jacobian_ * eigen_chain_jacobian_.transpose();
-  eigen_jac_times_jac_transpose_ = eigen_chain_jacobian_ * eigen_chain_jacobian_.transpose() + MatrixXd::Identity(NUM_CART, NUM_CART) * damping_;
-
-  eigen_jac_times_jac_transpose_.computeInverse(&eigen_jjt_inverse_);
-
-  eigen_jac_pseudo_inverse_ = eigen_chain_jacobian_.transpose() * eigen_jjt_inverse_;
-
-  // compute the nullspace projector
-  eigen_identity_.setIdentity();
-  eigen_nullspace_projector_ = eigen_identity_ - (eigen_jac_pseudo_inverse_ * eigen_chain_jacobian_);
+  // factorize the damped J*J^T (fixed size, no explicit inverse)
+  ik_solver_.setJacobian(kdl_chain_jacobian_.data, damping_);
 
   // get cartesian pose
   jnt_to_pose_solver_->JntToCart(kdl_current_joint_positions_, kdl_real_pose_measured_);
@@ -366,9 +347,6 @@ void CartesianTwistControllerIkWithNullspaceOptimization::update()
     eigen_desired_cartesian_velocities_(i) = (kdl_twist_desired_(i) * ff_rot_) + cartesian_fb_pid_controllers_[i].updatePid(kdl_twist_error_(i), dt_);
   }
 
-  // compute desired joint velocities
-  eigen_desired_joint_velocities_ = eigen_jac_pseudo_inverse_ * eigen_desired_cartesian_velocities_;
-
   double error;
   for (int i = 0; i < num_joints_; ++i)
   {
@@ -382,11 +360,12 @@ void CartesianTwistControllerIkWithNullspaceOptimization::update()
     }
     eigen_nullspace_error_(i) = nullspace_fb_pid_controllers_[i].updatePid(error, dt_);
   }
-  eigen_nullspace_term_ = eigen_nullspace_projector_ * eigen_nullspace_error_;
-  eigen_desired_joint_velocities_ += eigen_nullspace_term_;
+
+  // compute desired joint velocities (pseudo inverse solution plus projected nullspace term)
+  ik_solver_.solve(eigen_desired_cartesian_velocities_, eigen_nullspace_error_, eigen_nullspace_term_, eigen_desired_joint_velocities_);
 
   // integrate desired joint velocities to get desired joint positions
-  eigen_desired_joint_positions_ = eigen_desired_joint_positions_ + eigen_desired_joint_velocities_ * dt_.toSec();
+  eigen_desired_joint_positions_ += eigen_desired_joint_velocities_ * dt_.toSec();
 
   // added by schorfi/mrinal (clip the joint limits)
   for (int i = 0; i < num_joints_; ++i)
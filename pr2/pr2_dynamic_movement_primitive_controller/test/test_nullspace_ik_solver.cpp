@@ -0,0 +1,125 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks    Compares the NullspaceIkSolver against the explicit damped
+              pseudo inverse and nullspace projector it replaced.
+
+  \file   test_nullspace_ik_solver.cpp
+
+  \date   Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <Eigen/LU>
+
+// local includes
+#include <pr2_dynamic_movement_primitive_controller/nullspace_ik_solver.h>
+
+using namespace pr2_dynamic_movement_primitive_controller;
+
+static const int NUM_CART = 6;
+static const int NUM_JOINTS = 7;
+
+typedef NullspaceIkSolver<NUM_CART, NUM_JOINTS> IkSolver;
+
+class TestNullspaceIkSolver : public testing::Test
+{
+protected:
+
+  /*! Solves with the IkSolver as well as with the explicit inverse of (J*J^T + damping*I) and
+   * the explicit nullspace projector (I - J^+ * J), and compares both results.
+   */
+  void compare(const IkSolver::JacobianMatrix& jacobian,
+               const double damping,
+               const double tolerance)
+  {
+    Eigen::Matrix<double, NUM_CART, NUM_CART> jac_times_jac_transpose = jacobian * jacobian.transpose()
+        + Eigen::Matrix<double, NUM_CART, NUM_CART>::Identity() * damping;
+    Eigen::Matrix<double, NUM_JOINTS, NUM_CART> pseudo_inverse = jacobian.transpose() * jac_times_jac_transpose.inverse();
+    Eigen::Matrix<double, NUM_JOINTS, NUM_JOINTS> nullspace_projector = Eigen::Matrix<double, NUM_JOINTS, NUM_JOINTS>::Identity()
+        - pseudo_inverse * jacobian;
+
+    ik_solver_.setJacobian(jacobian, damping);
+    for (int i = 0; i < 20; ++i)
+    {
+      IkSolver::CartesianVector desired_cartesian_velocities = IkSolver::CartesianVector::Random();
+      IkSolver::JointVector nullspace_error = IkSolver::JointVector::Random();
+
+      IkSolver::JointVector expected_nullspace_term = nullspace_projector * nullspace_error;
+      IkSolver::JointVector expected_joint_velocities = pseudo_inverse * desired_cartesian_velocities + expected_nullspace_term;
+
+      IkSolver::JointVector nullspace_term;
+      IkSolver::JointVector desired_joint_velocities;
+      ik_solver_.solve(desired_cartesian_velocities, nullspace_error, nullspace_term, desired_joint_velocities);
+
+      for (int j = 0; j < NUM_JOINTS; ++j)
+      {
+        EXPECT_NEAR(expected_nullspace_term(j), nullspace_term(j), tolerance);
+        EXPECT_NEAR(expected_joint_velocities(j), desired_joint_velocities(j), tolerance);
+      }
+    }
+  }
+
+  IkSolver ik_solver_;
+};
+
+TEST_F(TestNullspaceIkSolver, TestWellConditioned)
+{
+  srand(0);
+  for (int i = 0; i < 10; ++i)
+  {
+    IkSolver::JacobianMatrix jacobian = IkSolver::JacobianMatrix::Random();
+    compare(jacobian, 0.0, 1e-9);
+    compare(jacobian, 0.01, 1e-9);
+  }
+}
+
+TEST_F(TestNullspaceIkSolver, TestUndampedProperties)
+{
+  srand(1);
+  IkSolver::JacobianMatrix jacobian = IkSolver::JacobianMatrix::Random();
+  ik_solver_.setJacobian(jacobian, 0.0);
+
+  IkSolver::CartesianVector desired_cartesian_velocities = IkSolver::CartesianVector::Random();
+  IkSolver::JointVector nullspace_error = IkSolver::JointVector::Random();
+  IkSolver::JointVector nullspace_term;
+  IkSolver::JointVector desired_joint_velocities;
+  ik_solver_.solve(desired_cartesian_velocities, nullspace_error, nullspace_term, desired_joint_velocities);
+
+  // the nullspace term does not move the end effector, the joint velocities realize the desired twist
+  IkSolver::CartesianVector nullspace_motion = jacobian * nullspace_term;
+  IkSolver::CartesianVector cartesian_velocities = jacobian * desired_joint_velocities;
+  for (int i = 0; i < NUM_CART; ++i)
+  {
+    EXPECT_NEAR(0.0, nullspace_motion(i), 1e-9);
+    EXPECT_NEAR(desired_cartesian_velocities(i), cartesian_velocities(i), 1e-9);
+  }
+}
+
+TEST_F(TestNullspaceIkSolver, TestNearSingularDamped)
+{
+  srand(2);
+  for (int i = 0; i < 10; ++i)
+  {
+    // the last row differs from the first one by 1e-8, i.e. the jacobian is (almost) rank deficient
+    IkSolver::JacobianMatrix jacobian = IkSolver::JacobianMatrix::Random();
+    jacobian.row(NUM_CART - 1) = jacobian.row(0) + 1e-8 * IkSolver::JacobianMatrix::Random().row(0);
+    compare(jacobian, 1e-3, 1e-7);
+    compare(jacobian, 0.1, 1e-9);
+
+    // exactly singular
+    jacobian.row(NUM_CART - 1) = jacobian.row(0);
+    compare(jacobian, 1e-3, 1e-7);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -63,6 +63,12 @@ namespace lockfree
  *
  * Indices are stored as 32-bits with a 64-bit head index whose upper 32-bits are tagged
  * to avoid ABA problems
+ *
+ * Optionally a set of per-thread caches ("magazines") can be placed in front of the shared list.
+ * A thread then allocates from and frees into its own cache, and only touches the shared head
+ * to refill or drain half a cache at once, with a single CAS per batch.  A cache is claimed with
+ * a single exchange and a thread that cannot claim its cache falls back to the shared list,
+ * so allocate() and free() stay lock-free.
  */
 class FreeList
 {
@@ -75,20 +81,26 @@ public:
    * \brief Constructor with initialization
    * \param block_size The size of each block allocate() will return
    * \param block_count The number of blocks to allocate
+   * \param thread_cache_size The number of blocks each per-thread cache holds.  0 disables the caches
    */
-  FreeList(uint32_t block_size, uint32_t block_count);
+  FreeList(uint32_t block_size, uint32_t block_count, uint32_t thread_cache_size = 0);
   ~FreeList();
 
   /**
    * \brief Initialize this FreeList.  Only use if you used to default constructor
    * \param block_size The size of each block allocate() will return
    * \param block_count The number of blocks to allocate
+   * \param thread_cache_size The number of blocks each per-thread cache holds.  0 disables the caches
    */
-  void initialize(uint32_t block_size, uint32_t block_count);
+  void initialize(uint32_t block_size, uint32_t block_count, uint32_t thread_cache_size = 0);
 
   /**
    * \brief Allocate a single block from this FreeList
    * \return 0 if all blocks are allocated, a pointer to a memory block of size block_size_ otherwise
+   *
+   * \note With thread caches enabled, blocks held in the caches of other threads are only taken back
+   * if those caches are not in use at the time, so allocate() may return 0 while another thread is
+   * in the middle of an allocate() or free()
    */
   void* allocate();
   /**
@@ -168,6 +180,41 @@ public:
 
 private:
 
+  enum
+  {
+    /// Number of per-thread caches. Threads beyond this count share caches
+    THREAD_CACHE_COUNT = 32
+  };
+
+  /**
+   * \brief A per-thread cache of free block indices.  Each cache lives on its own cache line
+   */
+  struct ThreadCache
+  {
+    /// 1 while a thread is using this cache
+    ros::atomic_uint32_t busy;
+    /// Allocations minus frees done through this cache, read by hasOutstandingAllocations()
+    ros::atomic_uint32_t alloc_count;
+    /// Number of valid entries in indices
+    uint32_t count;
+    /// thread_cache_size_ block indices
+    uint32_t* indices;
+  };
+
+  void* allocateFromList();
+  void freeToList(uint32_t index);
+  uint32_t popChain(uint32_t* indices, uint32_t max_count);
+  void pushChain(uint32_t const* indices, uint32_t count);
+
+  ThreadCache* acquireThreadCache();
+  void releaseThreadCache(ThreadCache* cache);
+  void stealFromThreadCaches(ThreadCache* cache);
+
+  inline ThreadCache* getThreadCache(uint32_t i)
+  {
+    return reinterpret_cast<ThreadCache*>(thread_caches_ + (i * ROSRT_CACHELINE_SIZE));
+  }
+
   inline uint32_t getTag(uint64_t val)
   {
     return (uint32_t)(val >> 32);
@@ -196,6 +243,10 @@ private:
   uint32_t block_size_;
   uint32_t block_count_;
 
+  uint8_t* thread_caches_;
+  uint32_t* thread_cache_indices_;
+  uint32_t thread_cache_size_;
+
 #if FREE_LIST_DEBUG
   struct Debug
   {
@@ -234,11 +234,13 @@ public:
    * \brief Constructor with initialization.
    * \param count The number of objects in the pool
    * \param tmpl The object template to use to construct the objects
+   * \param thread_cache_size The number of objects each per-thread cache holds.  0 disables the caches.
+   * See FreeList
    */
-  ObjectPool(uint32_t count, const T& tmpl)
+  ObjectPool(uint32_t count, const T& tmpl, uint32_t thread_cache_size = 0)
   : initialized_(false)
   {
-    initialize(count, tmpl);
+    initialize(count, tmpl, thread_cache_size);
   }
 
   ~ObjectPool()
@@ -259,13 +261,15 @@ public:
    * \brief initialize the pool.  Only use with the default constructor
    * \param count The number of objects in the pool
    * \param tmpl The object template to use to construct the objects
+   * \param thread_cache_size The number of objects each per-thread cache holds.  0 disables the caches.
+   * See FreeList
    */
-  void initialize(uint32_t count, const T& tmpl)
+  void initialize(uint32_t count, const T& tmpl, uint32_t thread_cache_size = 0)
   {
     ROS_ASSERT(!initialized_);
-    freelist_.initialize(sizeof(T), count);
+    freelist_.initialize(sizeof(T), count, thread_cache_size);
     freelist_.template constructAll<T>(tmpl);
-    sp_storage_freelist_.initialize(sizeof(detail::SPStorage), count);
+    sp_storage_freelist_.initialize(sizeof(detail::SPStorage), count, thread_cache_size);
     sp_storage_freelist_.template constructAll<detail::SPStorage>();
     initialized_ = true;
   }
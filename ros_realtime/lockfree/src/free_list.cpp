@@ -36,26 +36,77 @@
 #include <lockfree/free_list.h>
 #include <allocators/aligned.h>
 
+#include <algorithm>
+#include <cstring>
+
+#if defined(WIN32)
+#define STATIC_TLS_KW __declspec(thread)
+#define HAS_TLS_KW 1
+#elif defined(__APPLE__)
+#define HAS_TLS_KW 0
+#else
+#define STATIC_TLS_KW __thread
+#define HAS_TLS_KW 1
+#endif
+
+#if !HAS_TLS_KW
+#include <pthread.h>
+#endif
+
 using namespace ros;
 
 namespace lockfree
 {
 
+namespace
+{
+
+#if HAS_TLS_KW
+atomic_uint32_t g_next_thread_index(0);
+STATIC_TLS_KW uint32_t g_thread_index = 0xffffffffUL;
+#endif
+
+/**
+ * \brief Returns a small per-thread number used to pick a thread cache
+ */
+uint32_t getThreadIndex()
+{
+#if HAS_TLS_KW
+  if (g_thread_index == 0xffffffffUL)
+  {
+    g_thread_index = g_next_thread_index.fetch_add(1);
+  }
+
+  return g_thread_index;
+#else
+  uintptr_t id = (uintptr_t)pthread_self();
+  return (uint32_t)(id ^ (id >> 12) ^ (id >> 24));
+#endif
+}
+
+} // namespace
+
 FreeList::FreeList()
 : blocks_(0)
 , next_(0)
 , block_size_(0)
 , block_count_(0)
+, thread_caches_(0)
+, thread_cache_indices_(0)
+, thread_cache_size_(0)
 {
 }
 
-FreeList::FreeList(uint32_t block_size, uint32_t block_count)
+FreeList::FreeList(uint32_t block_size, uint32_t block_count, uint32_t thread_cache_size)
 : blocks_(0)
 , next_(0)
 , block_size_(0)
 , block_count_(0)
+, thread_caches_(0)
+, thread_cache_indices_(0)
+, thread_cache_size_(0)
 {
-  initialize(block_size, block_count);
+  initialize(block_size, block_count, thread_cache_size);
 }
 
 FreeList::~FreeList()
@@ -65,11 +116,21 @@ FreeList::~FreeList()
     next_[i].~atomic_uint32_t();
   }
 
+  if (thread_caches_)
+  {
+    for (uint32_t i = 0; i < THREAD_CACHE_COUNT; ++i)
+    {
+      getThreadCache(i)->~ThreadCache();
+    }
+  }
+
   allocators::alignedFree(blocks_);
   allocators::alignedFree(next_);
+  allocators::alignedFree(thread_caches_);
+  allocators::alignedFree(thread_cache_indices_);
 }
 
-void FreeList::initialize(uint32_t block_size, uint32_t block_count)
+void FreeList::initialize(uint32_t block_size, uint32_t block_count, uint32_t thread_cache_size)
 {
   ROS_ASSERT(!blocks_);
   ROS_ASSERT(!next_);
@@ -98,21 +159,217 @@ void FreeList::initialize(uint32_t block_size, uint32_t block_count)
       next_[i].store(i + 1);
     }
   }
+
+  if (thread_cache_size > 0)
+  {
+    ROS_ASSERT(sizeof(ThreadCache) <= ROSRT_CACHELINE_SIZE);
+
+    thread_cache_size_ = thread_cache_size;
+    thread_caches_ = (uint8_t*)allocators::alignedMalloc(ROSRT_CACHELINE_SIZE * THREAD_CACHE_COUNT, ROSRT_CACHELINE_SIZE);
+    thread_cache_indices_ = (uint32_t*)allocators::alignedMalloc(sizeof(uint32_t) * thread_cache_size * THREAD_CACHE_COUNT, ROSRT_CACHELINE_SIZE);
+
+    for (uint32_t i = 0; i < THREAD_CACHE_COUNT; ++i)
+    {
+      ThreadCache* cache = new (getThreadCache(i)) ThreadCache();
+      cache->busy.store(0);
+      cache->alloc_count.store(0);
+      cache->count = 0;
+      cache->indices = thread_cache_indices_ + (i * thread_cache_size);
+    }
+  }
 }
 
 bool FreeList::hasOutstandingAllocations()
 {
-  return alloc_count_.load() == 0;
+  // Counts are unsigned and wrap, a block allocated through one cache and freed through
+  // another (or through the shared list) still sums to zero
+  uint32_t count = alloc_count_.load();
+  if (thread_caches_)
+  {
+    for (uint32_t i = 0; i < THREAD_CACHE_COUNT; ++i)
+    {
+      count += getThreadCache(i)->alloc_count.load();
+    }
+  }
+
+  return count == 0;
 }
 
 void* FreeList::allocate()
+{
+  ROS_ASSERT(blocks_);
+
+  ThreadCache* cache = acquireThreadCache();
+  if (!cache)
+  {
+    return allocateFromList();
+  }
+
+  if (cache->count == 0)
+  {
+    // Refill half the cache so the following frees do not immediately drain it again
+    cache->count = popChain(cache->indices, std::max(thread_cache_size_ / 2, 1U));
+    if (cache->count == 0)
+    {
+      stealFromThreadCaches(cache);
+    }
+  }
+
+  void* mem = 0;
+  if (cache->count > 0)
+  {
+    uint32_t index = cache->indices[--cache->count];
+    cache->alloc_count.store(cache->alloc_count.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    mem = static_cast<void*>(blocks_ + (block_size_ * index));
+  }
+
+  releaseThreadCache(cache);
+  return mem;
+}
+
+void FreeList::free(void const* mem)
+{
+  if (!mem)
+  {
+    return;
+  }
+
+  uint32_t index = (static_cast<uint8_t const*>(mem) - blocks_) / block_size_;
+
+  ROS_ASSERT(((static_cast<uint8_t const*>(mem) - blocks_) % block_size_) == 0);
+  ROS_ASSERT(owns(mem));
+
+  ThreadCache* cache = acquireThreadCache();
+  if (!cache)
+  {
+    freeToList(index);
+    return;
+  }
+
+  if (cache->count == thread_cache_size_)
+  {
+    // Drain the older half back to the shared list, keeping the most recently freed blocks
+    uint32_t drain = std::max(thread_cache_size_ / 2, 1U);
+    pushChain(cache->indices, drain);
+    cache->count -= drain;
+    std::memmove(cache->indices, cache->indices + drain, sizeof(uint32_t) * cache->count);
+  }
+
+  cache->indices[cache->count++] = index;
+  cache->alloc_count.store(cache->alloc_count.load(memory_order_relaxed) - 1, memory_order_relaxed);
+
+  releaseThreadCache(cache);
+}
+
+FreeList::ThreadCache* FreeList::acquireThreadCache()
+{
+  if (!thread_caches_)
+  {
+    return 0;
+  }
+
+  ThreadCache* cache = getThreadCache(getThreadIndex() % THREAD_CACHE_COUNT);
+  if (cache->busy.exchange(1, memory_order_acquire) != 0)
+  {
+    // Another thread shares this cache and is using it, go to the shared list instead of waiting
+    return 0;
+  }
+
+  return cache;
+}
+
+void FreeList::releaseThreadCache(ThreadCache* cache)
+{
+  cache->busy.store(0, memory_order_release);
+}
+
+void FreeList::stealFromThreadCaches(ThreadCache* cache)
+{
+  // The shared list is empty, take blocks back from caches of other threads that are not in use
+  uint32_t wanted = std::max(thread_cache_size_ / 2, 1U);
+  for (uint32_t i = 0; i < THREAD_CACHE_COUNT && cache->count < wanted; ++i)
+  {
+    ThreadCache* other = getThreadCache(i);
+    if (other == cache || other->busy.exchange(1, memory_order_acquire) != 0)
+    {
+      continue;
+    }
+
+    uint32_t count = std::min(other->count, wanted - cache->count);
+    other->count -= count;
+    std::memcpy(cache->indices + cache->count, other->indices + other->count, sizeof(uint32_t) * count);
+    cache->count += count;
+
+    releaseThreadCache(other);
+  }
+}
+
+uint32_t FreeList::popChain(uint32_t* indices, uint32_t max_count)
+{
+  while (true)
+  {
+    uint64_t head = head_.load(memory_order_consume);
+
+    // Walk up to max_count blocks from the head.  If anyone pushes or pops in the meantime the
+    // tag changes and the CAS below fails, so a chain read from a changing list is never used
+    uint32_t count = 0;
+    uint32_t index = getVal(head);
+    while (index != 0xffffffffUL && count < max_count)
+    {
+      indices[count++] = index;
+      index = next_[index].load();
+    }
+
+    if (count == 0)
+    {
+      return 0;
+    }
+
+    uint64_t new_head = index;
+    // Increment the tag to avoid ABA
+    setTag(new_head, getTag(head) + 1);
+
+    if (head_.compare_exchange_strong(head, new_head))
+    {
+      return count;
+    }
+  }
+}
+
+void FreeList::pushChain(uint32_t const* indices, uint32_t count)
+{
+  ROS_ASSERT(count > 0);
+
+  // Link the blocks together, they are owned by this thread until the CAS below succeeds
+  for (uint32_t i = 0; i + 1 < count; ++i)
+  {
+    next_[indices[i]].store(indices[i + 1]);
+  }
+
+  while (true)
+  {
+    uint64_t head = head_.load(memory_order_consume);
+
+    uint64_t new_head = head;
+    setVal(new_head, indices[0]);
+    // Increment the tag to avoid ABA
+    setTag(new_head, getTag(new_head) + 1);
+
+    next_[indices[count - 1]].store(getVal(head));
+
+    if (head_.compare_exchange_strong(head, new_head))
+    {
+      return;
+    }
+  }
+}
+
+void* FreeList::allocateFromList()
 {
 #if FREE_LIST_DEBUG
   initDebug();
 #endif
 
-  ROS_ASSERT(blocks_);
-
   while (true)
   {
     uint64_t head = head_.load(memory_order_consume);
@@ -167,22 +424,12 @@ void* FreeList::allocate()
   }
 }
 
-void FreeList::free(void const* mem)
+void FreeList::freeToList(uint32_t index)
 {
-  if (!mem)
-  {
-    return;
-  }
-
 #if FREE_LIST_DEBUG
   initDebug();
 #endif
 
-  uint32_t index = (static_cast<uint8_t const*>(mem) - blocks_) / block_size_;
-
-  ROS_ASSERT(((static_cast<uint8_t const*>(mem) - blocks_) % block_size_) == 0);
-  ROS_ASSERT(owns(mem));
-
   while (true)
   {
     // Load head
@@ -0,0 +1,141 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2010, Willow Garage, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "lockfree/free_list.h"
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "ros/time.h"
+
+using namespace lockfree;
+
+// Allocations each thread holds at once
+const uint32_t g_batch_size = 16;
+// Allocate/free rounds per thread
+const uint32_t g_rounds = 200000;
+
+void benchmarkThread(FreeList& pool, boost::barrier& b, ros::atomic<uint32_t>& failures)
+{
+  void* vals[g_batch_size];
+  uint32_t failed = 0;
+
+  b.wait();
+
+  for (uint32_t r = 0; r < g_rounds; ++r)
+  {
+    for (uint32_t i = 0; i < g_batch_size; ++i)
+    {
+      vals[i] = pool.allocate();
+      if (!vals[i])
+      {
+        ++failed;
+      }
+    }
+
+    for (uint32_t i = 0; i < g_batch_size; ++i)
+    {
+      pool.free(vals[i]);
+    }
+  }
+
+  failures.fetch_add(failed);
+}
+
+/**
+ * \brief Runs thread_count threads against a single FreeList and returns the number of
+ * allocate()+free() pairs per second over all threads
+ */
+double runBenchmark(uint32_t thread_count, uint32_t thread_cache_size)
+{
+  FreeList pool(64, thread_count * (g_batch_size + thread_cache_size), thread_cache_size);
+  ros::atomic<uint32_t> failures(0);
+  boost::barrier bar(thread_count + 1);
+  boost::thread_group tg;
+  for (uint32_t i = 0; i < thread_count; ++i)
+  {
+    tg.create_thread(boost::bind(benchmarkThread, boost::ref(pool), boost::ref(bar), boost::ref(failures)));
+  }
+
+  bar.wait();
+  ros::WallTime start = ros::WallTime::now();
+  tg.join_all();
+  double elapsed = (ros::WallTime::now() - start).toSec();
+
+  if (failures.load() > 0)
+  {
+    fprintf(stderr, "%u threads, cache size %u: %u failed allocations\n", thread_count, thread_cache_size, failures.load());
+  }
+
+  if (!pool.hasOutstandingAllocations())
+  {
+    fprintf(stderr, "%u threads, cache size %u: allocations outstanding after the run\n", thread_count, thread_cache_size);
+  }
+
+  return (double)thread_count * g_rounds * g_batch_size / elapsed;
+}
+
+int main(int argc, char** argv)
+{
+  uint32_t max_threads = boost::thread::hardware_concurrency() * 2;
+  if (argc > 1)
+  {
+    max_threads = atoi(argv[1]);
+  }
+
+  const uint32_t cache_sizes[] = {0, 8, 32, 128};
+  const uint32_t num_cache_sizes = sizeof(cache_sizes) / sizeof(cache_sizes[0]);
+
+  printf("%8s", "threads");
+  for (uint32_t c = 0; c < num_cache_sizes; ++c)
+  {
+    printf("   cache %4u (Mops/s)", cache_sizes[c]);
+  }
+  printf("\n");
+
+  for (uint32_t thread_count = 1; thread_count <= max_threads; thread_count *= 2)
+  {
+    printf("%8u", thread_count);
+    for (uint32_t c = 0; c < num_cache_sizes; ++c)
+    {
+      printf("   %20.2f", runBenchmark(thread_count, cache_sizes[c]) / 1e6);
+    }
+    printf("\n");
+  }
+
+  return 0;
+}
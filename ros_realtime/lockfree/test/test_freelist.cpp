@@ -264,6 +264,127 @@ TEST(FreeList, hasOutstandingAllocations)
   ASSERT_TRUE(pool.hasOutstandingAllocations());
 }
 
+TEST(FreeList, threadCacheMultipleElements)
+{
+  const uint32_t count = 5;
+  FreeList pool(4, count, 2);
+  pool.constructAll<uint32_t>(5);
+
+  std::vector<uint32_t*> items;
+  items.reserve(count);
+
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    items.push_back(static_cast<uint32_t*>(pool.allocate()));
+    ASSERT_TRUE(items[i]);
+    EXPECT_EQ(*items[i], 5UL);
+    *items[i] = i;
+  }
+
+  ASSERT_FALSE(pool.allocate());
+
+  // Fill the cache past its size so it drains back to the shared list, then allocate everything again
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    pool.free(items[i]);
+  }
+  items.clear();
+
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    items.push_back(static_cast<uint32_t*>(pool.allocate()));
+    ASSERT_TRUE(items[i]);
+  }
+
+  ASSERT_FALSE(pool.allocate());
+
+  std::set<uint32_t*> set;
+  set.insert(items.begin(), items.end());
+  EXPECT_EQ(set.size(), count);
+}
+
+void allocateFunc(FreeList& pool, std::vector<uint32_t*>& items, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    items.push_back(static_cast<uint32_t*>(pool.allocate()));
+  }
+}
+
+void freeFunc(FreeList& pool, std::vector<uint32_t*>& items)
+{
+  for (size_t i = 0; i < items.size(); ++i)
+  {
+    pool.free(items[i]);
+  }
+}
+
+TEST(FreeList, threadCacheAcrossThreads)
+{
+  const uint32_t count = 8;
+  FreeList pool(4, count, 4);
+
+  // Blocks parked in the cache of a thread that no longer allocates must still be reachable
+  std::vector<uint32_t*> items;
+  boost::thread(boost::bind(allocateFunc, boost::ref(pool), boost::ref(items), count)).join();
+  ASSERT_EQ(items.size(), count);
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    ASSERT_TRUE(items[i]);
+  }
+  ASSERT_FALSE(pool.allocate());
+  ASSERT_FALSE(pool.hasOutstandingAllocations());
+
+  boost::thread(boost::bind(freeFunc, boost::ref(pool), boost::ref(items))).join();
+  ASSERT_TRUE(pool.hasOutstandingAllocations());
+
+  items.clear();
+  allocateFunc(pool, items, count);
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    ASSERT_TRUE(items[i]);
+  }
+  ASSERT_FALSE(pool.allocate());
+
+  std::set<uint32_t*> set;
+  set.insert(items.begin(), items.end());
+  EXPECT_EQ(set.size(), count);
+
+  freeFunc(pool, items);
+  ASSERT_TRUE(pool.hasOutstandingAllocations());
+}
+
+TEST(FreeList, threadCacheMultipleThreads)
+{
+  const uint32_t thread_count = boost::thread::hardware_concurrency() * 2;
+  // Leave enough blocks for every thread to hold its 10 values plus a full cache
+  FreeList pool(4, thread_count * (10 + 8), 8);
+  ros::atomic<bool> done(false);
+  ros::atomic<bool> failed(false);
+  boost::thread_group tg;
+  boost::barrier bar(thread_count);
+  for (uint32_t i = 0; i < thread_count; ++i)
+  {
+    tg.create_thread(boost::bind(threadFunc, boost::ref(pool), boost::ref(done), boost::ref(failed), boost::ref(bar)));
+  }
+
+  ros::WallTime start = ros::WallTime::now();
+  while (ros::WallTime::now() - start < ros::WallDuration(10.0))
+  {
+    ros::WallDuration(0.01).sleep();
+
+    if (failed.load())
+    {
+      break;
+    }
+  }
+  done.store(true);
+  tg.join_all();
+
+  ASSERT_TRUE(!failed.load());
+  ASSERT_TRUE(pool.hasOutstandingAllocations());
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -45,6 +45,10 @@
 #include <rosrt/detail/mutex.h>
 #include <rosrt/detail/condition_variable.h>
 
+#include <boost/shared_ptr.hpp>
+#include <vector>
+#include <string>
+
 namespace rosrt
 {
 
@@ -61,23 +65,28 @@ public:
     VoidConstPtr msg;
     PublishFunc pub_func;
     CloneFunc clone_func;
+    // Non-zero if the message may be published without a clone
+    std::type_info const* zero_copy_type;
   };
 
   PublishQueue(uint32_t size);
 
-  bool push(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func);
+  bool push(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func, std::type_info const* zero_copy_type);
   uint32_t publishAll();
 
 private:
   MWSRQueue<PubItem> queue_;
 };
 
-class PublisherManager
+/**
+ * \brief A thread publishing the messages of its own PublishQueue
+ */
+class PublishWorker
 {
 public:
-  PublisherManager(const InitOptions& ops);
-  ~PublisherManager();
-  bool publish(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func);
+  PublishWorker(uint32_t queue_size, const std::string& name);
+  ~PublishWorker();
+  bool publish(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func, std::type_info const* zero_copy_type);
 
 private:
   void publishThread();
@@ -87,8 +96,25 @@ private:
   rosrt::mutex cond_mutex_;
   ros::atomic<uint32_t> pub_count_;
   volatile bool running_;
+  std::string name_;
   rosrt::thread pub_thread_;
 };
+typedef boost::shared_ptr<PublishWorker> PublishWorkerPtr;
+
+/**
+ * \brief Distributes messages over InitOptions::pubmanager_thread_count PublishWorkers, by publisher shard
+ */
+class PublisherManager
+{
+public:
+  PublisherManager(const InitOptions& ops);
+  ~PublisherManager();
+  bool publish(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func,
+               std::type_info const* zero_copy_type, uint32_t shard);
+
+private:
+  std::vector<PublishWorkerPtr> workers_;
+};
 
 } // namespace detail
 } // namespace rosrt
@@ -0,0 +1,161 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2010, Willow Garage, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef ROSRT_DETAIL_SPSC_QUEUE_H
+#define ROSRT_DETAIL_SPSC_QUEUE_H
+
+#include "lockfree/free_list.h"
+#include <ros/assert.h>
+#include <ros/atomic.h>
+
+namespace rosrt
+{
+namespace detail
+{
+
+/**
+ * \brief A fixed-capacity, wait-free, single-producer single-consumer ring buffer.
+ *
+ * push() may only be called from one thread and pop() from one (other) thread.  The read and
+ * write indices live on separate cache lines, and each side keeps a cached copy of the other
+ * side's index so it only touches the shared one when the queue looks full (or empty).
+ */
+template<typename T>
+class SPSCQueue
+{
+public:
+  SPSCQueue(uint32_t capacity)
+  : size_(capacity + 1)
+  , buffer_(new T[capacity + 1])
+  , tail_cache_(0)
+  , head_cache_(0)
+  {
+    ROS_ASSERT(capacity > 0);
+    head_.store(0);
+    tail_.store(0);
+  }
+
+  ~SPSCQueue()
+  {
+    delete [] buffer_;
+  }
+
+  /**
+   * \brief Push a value.  Producer only.
+   * \return false if the queue is full
+   */
+  bool push(const T& val)
+  {
+    uint32_t tail = tail_.load(ros::memory_order_relaxed);
+    uint32_t next = increment(tail);
+    if (next == head_cache_)
+    {
+      head_cache_ = head_.load(ros::memory_order_acquire);
+      if (next == head_cache_)
+      {
+        return false;
+      }
+    }
+
+    buffer_[tail] = val;
+    tail_.store(next, ros::memory_order_release);
+    return true;
+  }
+
+  /**
+   * \brief Pop the oldest value.  Consumer only.
+   * \return false if the queue is empty
+   */
+  bool pop(T& val)
+  {
+    uint32_t head = head_.load(ros::memory_order_relaxed);
+    if (head == tail_cache_)
+    {
+      tail_cache_ = tail_.load(ros::memory_order_acquire);
+      if (head == tail_cache_)
+      {
+        return false;
+      }
+    }
+
+    val = buffer_[head];
+    head_.store(increment(head), ros::memory_order_release);
+    return true;
+  }
+
+  /**
+   * \brief Number of values in the queue.  Only exact when called from the producer or the consumer
+   * while the other side is idle
+   */
+  uint32_t size() const
+  {
+    uint32_t head = head_.load(ros::memory_order_acquire);
+    uint32_t tail = tail_.load(ros::memory_order_acquire);
+    return (tail >= head) ? (tail - head) : (size_ - head + tail);
+  }
+
+  uint32_t capacity() const
+  {
+    return size_ - 1;
+  }
+
+private:
+  inline uint32_t increment(uint32_t index) const
+  {
+    return (index + 1 == size_) ? 0 : index + 1;
+  }
+
+  // One slot is always left empty to tell a full queue from an empty one
+  const uint32_t size_;
+  T* buffer_;
+
+  uint8_t pad0_[ROSRT_CACHELINE_SIZE];
+  // Written by the consumer
+  ros::atomic_uint32_t head_;
+  // Consumer's copy of tail_
+  uint32_t tail_cache_;
+
+  uint8_t pad1_[ROSRT_CACHELINE_SIZE];
+  // Written by the producer
+  ros::atomic_uint32_t tail_;
+  // Producer's copy of head_
+  uint32_t head_cache_;
+
+  uint8_t pad2_[ROSRT_CACHELINE_SIZE];
+};
+
+} // namespace detail
+} // namespace rosrt
+
+#endif // ROSRT_DETAIL_SPSC_QUEUE_H
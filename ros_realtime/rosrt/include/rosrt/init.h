@@ -46,11 +46,15 @@ struct InitOptions
 {
   InitOptions()
   : pubmanager_queue_size(10000)
+  , pubmanager_thread_count(1)
   , gc_queue_size(1000)
   , gc_period(0.1)
   {}
 
+  /// Queue size of each publisher thread
   uint32_t pubmanager_queue_size;
+  /// Number of threads publishing for realtime publishers.  Each Publisher is always served by the same thread
+  uint32_t pubmanager_thread_count;
   uint32_t gc_queue_size;
   ros::WallDuration gc_period;
 };
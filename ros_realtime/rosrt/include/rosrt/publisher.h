@@ -42,6 +42,8 @@
 #include <ros/node_handle.h>
 #include <boost/utility.hpp>
 
+#include <typeinfo>
+
 namespace rosrt
 {
 
@@ -67,13 +69,25 @@ VoidConstPtr cloneMessage(const VoidConstPtr& msg)
   return clone;
 }
 
-bool publish(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func);
+/**
+ * \brief Queue a message for publishing on a publisher thread
+ * \param zero_copy_type If non-zero, the message is published without a clone as long as the topic has
+ * no intraprocess subscribers of this type
+ * \param shard Selects the publisher thread.  Messages with the same shard are published in order
+ */
+bool publish(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func,
+             std::type_info const* zero_copy_type = 0, uint32_t shard = 0);
 
 template<typename M>
-bool publish(const ros::Publisher& pub, const VoidConstPtr& msg)
+bool publish(const ros::Publisher& pub, const VoidConstPtr& msg, bool zero_copy = false, uint32_t shard = 0)
 {
-  return publish(pub, msg, publishMessage<M>, cloneMessage<M>);
+  return publish(pub, msg, publishMessage<M>, cloneMessage<M>, zero_copy ? &typeid(M) : 0, shard);
 }
+
+/**
+ * \brief Returns a new shard index for a Publisher, used to spread publishers over the publisher threads
+ */
+uint32_t nextPublisherShard();
 } // namespace detail
 
 /**
@@ -90,6 +104,9 @@ public:
    * for anything else
    */
   Publisher()
+  : pool_(0)
+  , shard_(detail::nextPublisherShard())
+  , zero_copy_(false)
   {
   }
 
@@ -100,6 +117,9 @@ public:
    * \param tmpl A template object to intialize all the messages in the message pool with
    */
   Publisher(const ros::Publisher& pub, uint32_t message_pool_size, const M& tmpl)
+  : pool_(0)
+  , shard_(detail::nextPublisherShard())
+  , zero_copy_(false)
   {
     initialize(pub, message_pool_size, tmpl);
   }
@@ -113,6 +133,9 @@ public:
    * \param tmpl A template object to intialize all the messages in the message pool with
    */
   Publisher(ros::NodeHandle& nh, const std::string& topic, uint32_t ros_publisher_queue_size, uint32_t message_pool_size, const M& tmpl)
+  : pool_(0)
+  , shard_(detail::nextPublisherShard())
+  , zero_copy_(false)
   {
     initialize(nh, topic, ros_publisher_queue_size, message_pool_size, tmpl);
   }
@@ -153,7 +176,21 @@ public:
    */
   bool publish(const MConstPtr& msg)
   {
-    return detail::publish<M>(pub_, msg);
+    return detail::publish<M>(pub_, msg, zero_copy_, shard_);
+  }
+
+  /**
+   * \brief Enable or disable zero-copy publishing.
+   *
+   * By default every message is cloned on the publisher thread before it is handed to ros::Publisher,
+   * so that a non-realtime intraprocess subscriber holding on to messages cannot starve the message pool.
+   * With zero-copy enabled the message from the pool is published directly whenever the topic has no
+   * intraprocess subscribers of type M, and is only cloned otherwise.  The message must not be
+   * modified after it has been published.
+   */
+  void setZeroCopy(bool zero_copy)
+  {
+    zero_copy_ = zero_copy;
   }
 
   /**
@@ -173,6 +210,8 @@ public:
 private:
   ros::Publisher pub_;
   lockfree::ObjectPool<M>* pool_;
+  uint32_t shard_;
+  bool zero_copy_;
 };
 
 } // namespace rosrt
@@ -0,0 +1,305 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2010, Willow Garage, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef ROSRT_QUEUED_SUBSCRIBER_H
+#define ROSRT_QUEUED_SUBSCRIBER_H
+
+#include <lockfree/object_pool.h>
+#include "detail/pool_gc.h"
+#include "detail/spsc_queue.h"
+
+#include <ros/atomic.h>
+#include <ros/ros.h>
+#include <rosrt/subscriber.h>
+
+#include <boost/utility.hpp>
+
+namespace rosrt
+{
+
+/**
+ * \brief A lock-free, queueing subscriber.  Allows you to receive every ROS message inside a realtime thread.
+ *
+ * Unlike Subscriber, which only keeps the newest message, QueuedSubscriber keeps all received messages
+ * in a fixed-capacity single-producer single-consumer ring, in the order they were received.  Messages
+ * are only dropped if the ring or the message pool is full, which is counted (see getOverflowCount()
+ * and getAllocationFailureCount()).
+ *
+ * Messages are taken out either one by one with poll(), or all at once with pollAll(), which hands
+ * each message to a functor without creating a shared_ptr for it, e.g.:
+\verbatim
+struct Handler
+{
+  void operator()(const Msg& msg)
+  {
+    // do something with msg
+  }
+};
+
+QueuedSubscriber<Msg> sub(100, nh, "my_topic");
+Handler handler;
+while (true)
+{
+  sub.pollAll(handler);
+  ...
+}
+\endverbatim
+ *
+ * poll() and pollAll() must only be called from a single thread.
+ */
+template<typename M>
+class QueuedSubscriber : public boost::noncopyable
+{
+public:
+  /**
+   * \brief Default constructor.  You must call initialize() before doing anything else if you use this constructor.
+   */
+  QueuedSubscriber()
+  : pool_(0)
+  , queue_(0)
+  {
+  }
+
+  /**
+   * \brief Constructor with initialization.  Call subscribe() to subscribe to a topic.
+   * \param message_pool_size The size of the message pool to use.  This is also the number of messages
+   * that can be queued.
+   */
+  QueuedSubscriber(uint32_t message_pool_size)
+  : pool_(0)
+  , queue_(0)
+  {
+    initialize(message_pool_size);
+  }
+
+  /**
+   * \brief Constructor with initialization and subscription
+   * \param message_pool_size The size of the message pool to use.  This is also the number of messages
+   * that can be queued.
+   * \param nh The ros::NodeHandle to use to subscribe
+   * \param topic The topic to subscribe on
+   * \param [optional] transport_hints the transport hints to use
+   */
+  QueuedSubscriber(uint32_t message_pool_size, ros::NodeHandle& nh, const std::string& topic, const ros::TransportHints& transport_hints = ros::TransportHints())
+  : pool_(0)
+  , queue_(0)
+  {
+    initialize(message_pool_size);
+    subscribe(nh, topic, transport_hints);
+  }
+
+  ~QueuedSubscriber()
+  {
+    // Make sure the callback is not running anymore before emptying the queue
+    sub_.shutdown();
+
+    if (queue_)
+    {
+      M const* msg = 0;
+      while (queue_->pop(msg))
+      {
+        pool_->free(msg);
+      }
+
+      delete queue_;
+    }
+
+    // Messages returned by poll() may still be alive, so the pool is deleted by the gc
+    detail::addPoolToGC((void*)pool_, detail::deletePool<M>, detail::poolIsDeletable<M>);
+  }
+
+  /**
+   * \brief Initialize this subscriber.  Only use with the default constructor.
+   * \param message_pool_size The size of the message pool to use.  This is also the number of messages
+   * that can be queued.
+   */
+  void initialize(uint32_t message_pool_size)
+  {
+    ROS_ASSERT(message_pool_size > 1);
+    ROS_ASSERT(!pool_);
+    pool_ = new lockfree::ObjectPool<M>();
+    pool_->initialize(message_pool_size, M());
+    queue_ = new detail::SPSCQueue<M const*>(message_pool_size);
+    overflow_count_.store(0);
+    allocation_failure_count_.store(0);
+  }
+
+  /**
+   * \brief Initialize this subscriber.  Only use with the default constructor.
+   * \param message_pool_size The size of the message pool to use.  This is also the number of messages
+   * that can be queued.
+   * \param nh The ros::NodeHandle to use to subscribe
+   * \param topic The topic to subscribe on
+   * \param [optional] transport_hints the transport hints to use
+   * \return Whether or not we successfully subscribed
+   */
+  bool initialize(uint32_t message_pool_size, ros::NodeHandle& nh, const std::string& topic, const ros::TransportHints& transport_hints = ros::TransportHints())
+  {
+    initialize(message_pool_size);
+    return subscribe(nh, topic, transport_hints);
+  }
+
+  /**
+   * \brief Subscribe to a topic.  The ROS-side queue is as large as the message pool, so bursts are
+   * not dropped before they reach this subscriber.
+   * \param nh The ros::NodeHandle to use to subscribe
+   * \param topic The topic to subscribe on
+   * \param [optional] transport_hints the transport hints to use
+   * \return Whether or not we successfully subscribed
+   */
+  bool subscribe(ros::NodeHandle& nh, const std::string& topic, const ros::TransportHints& transport_hints = ros::TransportHints())
+  {
+    ros::SubscribeOptions ops;
+#ifdef ROS_NEW_SERIALIZATION_API
+    ops.template init<M>(topic, queue_->capacity(), boost::bind(&QueuedSubscriber::callback, this, _1), boost::bind(&lockfree::ObjectPool<M>::allocateShared, pool_));
+#else
+    ops.template init<M>(topic, queue_->capacity(), boost::bind(&QueuedSubscriber::callback, this, _1));
+#endif
+    ops.transport_hints = transport_hints;
+    ops.callback_queue = detail::getSubscriberCallbackQueue();
+    sub_ = nh.subscribe(ops);
+    return (bool)sub_;
+  }
+
+  /**
+   * \brief Retrieve the oldest message received that has not been returned yet.
+   * \return An empty pointer if no message is queued
+   */
+  boost::shared_ptr<M const> poll()
+  {
+    M const* msg = 0;
+    if (!queue_->pop(msg))
+    {
+      return boost::shared_ptr<M const>();
+    }
+
+    boost::shared_ptr<M const> ptr = pool_->makeShared(msg);
+    if (!ptr)
+    {
+      pool_->free(msg);
+      return boost::shared_ptr<M const>();
+    }
+
+    return ptr;
+  }
+
+  /**
+   * \brief Hand every queued message to f, oldest first.  The messages are returned to the pool right
+   * after f returns, so f must not keep references to them.
+   * \param f A functor callable as f(const M&)
+   * \param [optional] max_count The maximum number of messages to process
+   * \return The number of messages processed
+   */
+  template<typename F>
+  uint32_t pollAll(F& f, uint32_t max_count = 0xffffffffUL)
+  {
+    uint32_t count = 0;
+    M const* msg = 0;
+    while (count < max_count && queue_->pop(msg))
+    {
+      f(*msg);
+      pool_->free(msg);
+      ++count;
+    }
+
+    return count;
+  }
+
+  /**
+   * \brief Number of messages currently queued.  Only exact when called from the polling thread.
+   */
+  uint32_t getQueueSize() const
+  {
+    return queue_->size();
+  }
+
+  /**
+   * \brief Number of messages dropped because the queue was full
+   */
+  uint32_t getOverflowCount() const
+  {
+    return overflow_count_.load();
+  }
+
+  /**
+   * \brief Number of messages dropped because no message could be allocated from the pool
+   */
+  uint32_t getAllocationFailureCount() const
+  {
+    return allocation_failure_count_.load();
+  }
+
+private:
+  void callback(const boost::shared_ptr<M const>& msg)
+  {
+    M const* m = 0;
+    // If our pool doesn't own this message (due to multiple subscribers on the same topic)
+    // make a copy
+    if (!pool_->owns(msg.get()))
+    {
+      M* copy = pool_->allocate();
+
+      if (!copy)
+      {
+        allocation_failure_count_.fetch_add(1);
+        return;
+      }
+
+      *copy = *msg;
+      m = copy;
+    }
+    else
+    {
+      m = pool_->removeShared(msg);
+    }
+
+    if (!queue_->push(m))
+    {
+      overflow_count_.fetch_add(1);
+      pool_->free(m);
+    }
+  }
+
+  lockfree::ObjectPool<M>* pool_;
+  detail::SPSCQueue<M const*>* queue_;
+
+  ros::atomic_uint32_t overflow_count_;
+  ros::atomic_uint32_t allocation_failure_count_;
+
+  ros::Subscriber sub_;
+};
+
+} // namespace rosrt
+
+#endif // ROSRT_QUEUED_SUBSCRIBER_H
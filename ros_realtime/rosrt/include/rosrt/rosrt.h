@@ -38,6 +38,7 @@
 #include "publisher.h"
 #include "subscriber.h"
 #include "filtered_subscriber.h"
+#include "queued_subscriber.h"
 #include "malloc_wrappers.h"
 #include "init.h"
 
@@ -37,11 +37,16 @@
 #include <rosrt/detail/managers.h>
 #include <rosrt/init.h>
 #include <ros/debug.h>
+#include <ros/topic_manager.h>
+#include <ros/publication.h>
 
 #include <lockfree/object_pool.h>
 
 #include <boost/thread.hpp>
 
+#include <algorithm>
+#include <sstream>
+
 #ifdef __XENO__
 #include <native/task.h>
 #endif
@@ -51,9 +56,34 @@ namespace rosrt
 namespace detail
 {
 
-bool publish(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func)
+bool publish(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func,
+             std::type_info const* zero_copy_type, uint32_t shard)
+{
+  return detail::getPublisherManager()->publish(pub, msg, pub_func, clone_func, zero_copy_type, shard);
+}
+
+static ros::atomic<uint32_t> g_next_publisher_shard(0);
+
+uint32_t nextPublisherShard()
+{
+  return g_next_publisher_shard.fetch_add(1);
+}
+
+/**
+ * \brief Returns whether ros::Publisher would hand the message pointer itself to an intraprocess subscriber
+ */
+static bool hasIntraprocessSubscribers(const ros::Publisher& pub, const std::type_info& ti)
 {
-  return detail::getPublisherManager()->publish(pub, msg, pub_func, clone_func);
+  ros::PublicationPtr p = ros::TopicManager::instance()->lookupPublication(pub.getTopic());
+  if (!p)
+  {
+    return false;
+  }
+
+  bool serialize = false;
+  bool nocopy = false;
+  p->getPublishTypes(serialize, nocopy, ti);
+  return nocopy;
 }
 
 PublishQueue::PublishQueue(uint32_t size)
@@ -61,13 +91,14 @@ PublishQueue::PublishQueue(uint32_t size)
 {
 }
 
-bool PublishQueue::push(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func)
+bool PublishQueue::push(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func, std::type_info const* zero_copy_type)
 {
   PubItem i;
   i.pub = pub;
   i.msg = msg;
   i.pub_func = pub_func;
   i.clone_func = clone_func;
+  i.zero_copy_type = zero_copy_type;
   return queue_.push(i);
 }
 
@@ -78,10 +109,18 @@ uint32_t PublishQueue::publishAll()
   MWSRQueue<PubItem>::Node* it = queue_.popAll();
   while (it)
   {
-    // Always clone the message before publishing.  Otherwise, if there's an intraprocess non-realtime subscriber that stores off the messages
-    // it could starve the realtime publisher for messages.
-    VoidConstPtr clone = it->val.clone_func(it->val.msg);
-    it->val.pub_func(it->val.pub, clone);
+    // Clone the message before publishing unless the publisher opted out of it and nobody in this process
+    // would keep a reference to it.  Otherwise, if there's an intraprocess non-realtime subscriber that stores
+    // off the messages it could starve the realtime publisher for messages.
+    if (it->val.zero_copy_type && !hasIntraprocessSubscribers(it->val.pub, *it->val.zero_copy_type))
+    {
+      it->val.pub_func(it->val.pub, it->val.msg);
+    }
+    else
+    {
+      VoidConstPtr clone = it->val.clone_func(it->val.msg);
+      it->val.pub_func(it->val.pub, clone);
+    }
     it->val.msg.reset();
     it->val.pub = ros::Publisher();
     MWSRQueue<PubItem>::Node* tmp = it;
@@ -96,14 +135,41 @@ uint32_t PublishQueue::publishAll()
 }
 
 PublisherManager::PublisherManager(const InitOptions& ops)
-: queue_(ops.pubmanager_queue_size)
+{
+  uint32_t thread_count = std::max(ops.pubmanager_thread_count, 1U);
+  for (uint32_t i = 0; i < thread_count; ++i)
+  {
+    std::stringstream name;
+    name << "rosrt_publisher";
+    if (thread_count > 1)
+    {
+      name << "_" << i;
+    }
+    workers_.push_back(PublishWorkerPtr(new PublishWorker(ops.pubmanager_queue_size, name.str())));
+  }
+}
+
+PublisherManager::~PublisherManager()
+{
+  workers_.clear();
+}
+
+bool PublisherManager::publish(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func,
+                               std::type_info const* zero_copy_type, uint32_t shard)
+{
+  return workers_[shard % workers_.size()]->publish(pub, msg, pub_func, clone_func, zero_copy_type);
+}
+
+PublishWorker::PublishWorker(uint32_t queue_size, const std::string& name)
+: queue_(queue_size)
 , pub_count_(0)
 , running_(true)
-, pub_thread_(boost::bind(&PublisherManager::publishThread, this), "rosrt_publisher")
+, name_(name)
+, pub_thread_(boost::bind(&PublishWorker::publishThread, this), name_.c_str())
 {
 }
 
-PublisherManager::~PublisherManager()
+PublishWorker::~PublishWorker()
 {
   cond_mutex_.lock();
   running_ = false;
@@ -112,7 +178,7 @@ PublisherManager::~PublisherManager()
   pub_thread_.join();
 }
 
-void PublisherManager::publishThread()
+void PublishWorker::publishThread()
 {
   while (running_)
   {
@@ -138,9 +204,10 @@ void PublisherManager::publishThread()
   }
 }
 
-bool PublisherManager::publish(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func)
+bool PublishWorker::publish(const ros::Publisher& pub, const VoidConstPtr& msg, PublishFunc pub_func, CloneFunc clone_func,
+                            std::type_info const* zero_copy_type)
 {
-  if (!queue_.push(pub, msg, pub_func, clone_func))
+  if (!queue_.push(pub, msg, pub_func, clone_func, zero_copy_type))
   {
     return false;
   }
@@ -93,6 +93,43 @@ TEST(Publisher, singlePublisher)
   ASSERT_EQ(h.latest->data, 5UL);
 }
 
+TEST(Publisher, zeroCopyWithIntraprocessSubscriber)
+{
+  ros::NodeHandle nh;
+
+  Publisher<std_msgs::UInt32> pub(nh.advertise<std_msgs::UInt32>("test_zero_copy", 0), 1, std_msgs::UInt32());
+  pub.setZeroCopy(true);
+
+  Helper h;
+  ros::Subscriber sub = nh.subscribe("test_zero_copy", 0, &Helper::cb, &h);
+
+  std_msgs::UInt32Ptr msg = pub.allocate();
+  ASSERT_TRUE(msg);
+  msg->data = 5;
+  pub.publish(msg);
+  msg.reset();
+
+  while (h.count == 0)
+  {
+    ros::WallDuration(0.001).sleep();
+    ros::spinOnce();
+  }
+
+  ASSERT_EQ(h.count, 1UL);
+  ASSERT_EQ(h.latest->data, 5UL);
+
+  // The intraprocess subscriber must have received a clone, so the only message in the pool is free again
+  // once the publisher thread has let go of it
+  std_msgs::UInt32Ptr again = pub.allocate();
+  ros::WallTime start = ros::WallTime::now();
+  while (!again && ros::WallTime::now() - start < ros::WallDuration(1.0))
+  {
+    ros::WallDuration(0.001).sleep();
+    again = pub.allocate();
+  }
+  ASSERT_TRUE(again);
+}
+
 TEST(Publisher, simpleInitializeCompile)
 {
   ros::NodeHandle nh;
@@ -240,7 +277,11 @@ int main(int argc, char** argv)
   testing::InitGoogleTest(&argc, argv);
 
   ros::NodeHandle nh;
-  rosrt::init();
+
+  // Use more than one publisher thread so the tests also cover publishers being spread over them
+  rosrt::InitOptions ops;
+  ops.pubmanager_thread_count = 2;
+  rosrt::init(ops);
 
 
   return RUN_ALL_TESTS();
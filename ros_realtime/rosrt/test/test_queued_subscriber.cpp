@@ -0,0 +1,172 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2010, Willow Garage, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "rosrt/rosrt.h"
+
+#include <ros/ros.h>
+
+#include <std_msgs/UInt32.h>
+
+#include <boost/thread.hpp>
+
+#ifdef __XENO__
+#include <native/task.h>
+#include <sys/mman.h>
+#endif
+
+using namespace rosrt;
+
+void publishThread(ros::Publisher& pub, uint32_t count)
+{
+  while (pub.getNumSubscribers() == 0)
+  {
+    ros::WallDuration(0.01).sleep();
+  }
+
+  std_msgs::UInt32 msg;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    msg.data = i;
+    pub.publish(msg);
+    ros::WallDuration(0.0001).sleep();
+  }
+}
+
+struct SequenceChecker
+{
+  SequenceChecker()
+  : next(0)
+  , failed(false)
+  {}
+
+  void operator()(const std_msgs::UInt32& msg)
+  {
+    if (msg.data != next)
+    {
+      failed = true;
+    }
+    next = msg.data + 1;
+  }
+
+  uint32_t next;
+  bool failed;
+};
+
+TEST(QueuedSubscriber, pollAllReceivesEveryMessage)
+{
+  const uint32_t count = 10000;
+
+  ros::NodeHandle nh;
+  ros::Publisher pub = nh.advertise<std_msgs::UInt32>("test_queued", count);
+
+  QueuedSubscriber<std_msgs::UInt32> sub(1000, nh, "test_queued");
+  boost::thread t(boost::bind(publishThread, boost::ref(pub), count));
+
+  resetThreadAllocInfo();
+
+  SequenceChecker checker;
+  uint32_t received = 0;
+  ros::WallTime start = ros::WallTime::now();
+  while (received < count && ros::WallTime::now() - start < ros::WallDuration(30.0))
+  {
+    received += sub.pollAll(checker);
+    ros::WallDuration(0.002).sleep();
+  }
+
+  ASSERT_EQ(getThreadAllocInfo().total_ops, 0UL);
+
+  t.join();
+
+  EXPECT_FALSE(checker.failed);
+  EXPECT_EQ(received, count);
+  EXPECT_EQ(sub.getOverflowCount(), 0UL);
+  EXPECT_EQ(sub.getAllocationFailureCount(), 0UL);
+}
+
+TEST(QueuedSubscriber, pollReturnsMessagesInOrder)
+{
+  const uint32_t count = 1000;
+
+  ros::NodeHandle nh;
+  ros::Publisher pub = nh.advertise<std_msgs::UInt32>("test_queued_poll", count);
+
+  QueuedSubscriber<std_msgs::UInt32> sub(100, nh, "test_queued_poll");
+  boost::thread t(boost::bind(publishThread, boost::ref(pub), count));
+
+  resetThreadAllocInfo();
+
+  int32_t last = -1;
+  uint32_t received = 0;
+  ros::WallTime start = ros::WallTime::now();
+  while (last < (int32_t)count - 1 && ros::WallTime::now() - start < ros::WallDuration(30.0))
+  {
+    std_msgs::UInt32ConstPtr msg = sub.poll();
+    if (msg)
+    {
+      ASSERT_GT((int32_t)msg->data, last);
+      last = msg->data;
+      ++received;
+    }
+    else
+    {
+      ros::WallDuration(0.0001).sleep();
+    }
+  }
+
+  ASSERT_EQ(getThreadAllocInfo().total_ops, 0UL);
+
+  t.join();
+
+  EXPECT_EQ(last, (int32_t)count - 1);
+  EXPECT_EQ(received, count);
+  EXPECT_EQ(sub.getOverflowCount(), 0UL);
+}
+
+int main(int argc, char** argv)
+{
+#ifdef __XENO__
+  mlockall(MCL_CURRENT | MCL_FUTURE);
+  rt_task_shadow(NULL, "test_rt_queued_subscriber", 0, 0);
+#endif
+
+  ros::init(argc, argv, "test_rt_queued_subscriber");
+  testing::InitGoogleTest(&argc, argv);
+
+  ros::NodeHandle nh;
+  rosrt::init();
+
+  return RUN_ALL_TESTS();
+}
@@ -38,6 +38,7 @@
 
 // system includes
 #include <vector>
+#include <Eigen/Core>
 
 // ros includes
 #include <bspline/BSpline.h>
@@ -79,6 +80,33 @@ bool resample(const std::vector<double>& input_vector,
               bool compute_slope,
               bool verbose = false);
 
+/*! Methods supported by the multi-channel resample function
+ */
+enum ResamplingMethod
+{
+  LINEAR_RESAMPLING = 0, BSPLINE_RESAMPLING
+};
+
+/*! Resamples all channels (columns) of target_matrix, which share the same input_vector (e.g. time stamps).
+ * For BSPLINE_RESAMPLING, invalid data points are removed once for all channels and the knot vector as well
+ * as the factorization of the banded normal equations are computed once and shared among all channels.
+ * @param input_vector (num_rows)
+ * @param target_matrix (num_rows x num_channels)
+ * @param cutoff_wave_length (only used for BSPLINE_RESAMPLING)
+ * @param input_querry (num_samples)
+ * @param output_matrix (num_samples x num_channels)
+ * @param method
+ * @param compute_slope (only used for BSPLINE_RESAMPLING)
+ * @return True on success, otherwise False
+ */
+bool resample(const std::vector<double>& input_vector,
+              const Eigen::MatrixXd& target_matrix,
+              const double cutoff_wave_length,
+              const std::vector<double>& input_querry,
+              Eigen::MatrixXd& output_matrix,
+              const ResamplingMethod method = BSPLINE_RESAMPLING,
+              bool compute_slope = false);
+
 /**
  * Given input samples of input_y = f(input_x), calculates output_y = f(output_x) using linear interpolation
  * Assumes that input_x and output_x are sorted!
@@ -88,6 +116,15 @@ bool resampleLinearNoBounds(const std::vector<double>& input_x,
                             const std::vector<double>& output_x,
                             std::vector<double>& output_y);
 
+/**
+ * Same as above for all channels (columns) of input_y at once, the interpolation intervals are only searched once.
+ * Assumes that input_x and output_x are sorted!
+ */
+bool resampleLinearNoBounds(const std::vector<double>& input_x,
+                            const Eigen::MatrixXd& input_y,
+                            const std::vector<double>& output_x,
+                            Eigen::MatrixXd& output_y);
+
 /**
  * Given input samples of input_y = f(input_x), calculates output_y = f(output_x) using linear interpolation
  * Assumes that input_x and output_x are sorted!
@@ -268,6 +305,104 @@ inline bool resample(const std::vector<double>& input_vector,
   return true;
 }
 
+inline bool resample(const std::vector<double>& input_vector,
+                     const Eigen::MatrixXd& target_matrix,
+                     const double cutoff_wave_length,
+                     const std::vector<double>& input_querry,
+                     Eigen::MatrixXd& output_matrix,
+                     const ResamplingMethod method,
+                     bool compute_slope)
+{
+  ROS_ASSERT_MSG(!input_vector.empty(), "Input vector is empty. Cannot resample trajectory.");
+  ROS_ASSERT_MSG(!input_querry.empty(), "Input querry is empty. Cannot resample trajectory.");
+  ROS_VERIFY(static_cast<int> (input_vector.size()) == static_cast<int> (target_matrix.rows()));
+
+  if (method == LINEAR_RESAMPLING)
+  {
+    return resampleLinearNoBounds(input_vector, target_matrix, input_querry, output_matrix);
+  }
+  ROS_ASSERT_MSG(method == BSPLINE_RESAMPLING, "Unknown resampling method >%i<.", (int)method);
+
+  const int num_rows = static_cast<int> (input_vector.size());
+  const int num_channels = static_cast<int> (target_matrix.cols());
+  const int num_samples = static_cast<int> (input_querry.size());
+
+  // remove invalid data points of all channels in a single pass
+  std::vector<int> valid_indices;
+  valid_indices.reserve(num_rows);
+  for (int i = 0; i < num_rows; ++i)
+  {
+    if (input_vector[i] >= 1e-6)
+    {
+      valid_indices.push_back(i);
+    }
+  }
+  const int num_valid_rows = static_cast<int> (valid_indices.size());
+  const int invalid_data_counter = num_rows - num_valid_rows;
+  if (invalid_data_counter > num_valid_rows)
+  {
+    ROS_WARN("Found >%i< invalid data points when resampling the trajectory.", invalid_data_counter);
+  }
+  if (num_valid_rows == 0)
+  {
+    ROS_ERROR("No valid data points left. Cannot resample trajectory using a bspline.");
+    return false;
+  }
+
+  std::vector<double> x_vector(num_valid_rows);
+  for (int i = 0; i < num_valid_rows; ++i)
+  {
+    x_vector[i] = input_vector[valid_indices[i]];
+  }
+  const Eigen::MatrixXd* y_matrix = &target_matrix;
+  Eigen::MatrixXd compacted_target_matrix;
+  if (invalid_data_counter > 0)
+  {
+    compacted_target_matrix.resize(num_valid_rows, num_channels);
+    for (int c = 0; c < num_channels; ++c)
+    {
+      for (int i = 0; i < num_valid_rows; ++i)
+      {
+        compacted_target_matrix(i, c) = target_matrix(valid_indices[i], c);
+      }
+    }
+    y_matrix = &compacted_target_matrix;
+  }
+
+  // setup (and factorize) the normal equations once, they only depend on the input vector
+  BSpline<double>::Debug(0);
+  BSplineBase<double> b_spline_base(&(x_vector[0]), num_valid_rows, cutoff_wave_length);
+  if (!b_spline_base.ok())
+  {
+    ROS_ERROR("Could not create b-spline base from >%i< input values with cutoff >%f<.", num_valid_rows, cutoff_wave_length);
+    return false;
+  }
+
+  output_matrix.resize(num_samples, num_channels);
+  for (int c = 0; c < num_channels; ++c)
+  {
+    // columns are stored contiguously
+    BSpline<double> b_spline(b_spline_base, y_matrix->col(c).data());
+    if (!b_spline.ok())
+    {
+      ROS_ERROR("Could not create b-spline for channel >%i<.", c);
+      return false;
+    }
+    for (int s = 0; s < num_samples; ++s)
+    {
+      if (compute_slope)
+      {
+        output_matrix(s, c) = b_spline.slope(input_querry[s]);
+      }
+      else
+      {
+        output_matrix(s, c) = b_spline.evaluate(input_querry[s]);
+      }
+    }
+  }
+  return true;
+}
+
 //inline bool resample(const std::vector<ros::Time>& time_stamps,
 //                     const std::vector<std::vector<double> >& values,
 //                     const int num_samples,
@@ -327,6 +462,45 @@ inline bool resampleLinearNoBounds(const std::vector<double>& input_x,
   return true;
 }
 
+inline bool resampleLinearNoBounds(const std::vector<double>& input_x,
+                                   const Eigen::MatrixXd& input_y,
+                                   const std::vector<double>& output_x,
+                                   Eigen::MatrixXd& output_y)
+{
+  ROS_ASSERT(static_cast<int> (input_x.size()) == static_cast<int> (input_y.rows()));
+  ROS_ASSERT(input_x.size() > 1);
+
+  const int num_outputs = static_cast<int> (output_x.size());
+  const int num_inputs = static_cast<int> (input_x.size());
+  output_y.resize(num_outputs, input_y.cols());
+
+  int input_index = 0;
+  for (int i = 0; i < num_outputs; ++i)
+  {
+    if (output_x[i] < input_x[0])
+    {
+      output_y.row(i) = input_y.row(0);
+    }
+    else if (output_x[i] > input_x[num_inputs - 1])
+    {
+      output_y.row(i) = input_y.row(num_inputs - 1);
+    }
+    else
+    {
+      while (input_index < num_inputs - 2 && input_x[input_index + 1] < output_x[i])
+      {
+        input_index++;
+      }
+      ROS_ASSERT_MSG(input_x[input_index + 1] > input_x[input_index], "Input invalid. Time stamp at >%i< is >%f< and time stamp at >%i< is >%f<.",
+                     input_index + 1, input_x[input_index + 1], input_index, input_x[input_index]);
+      // same interpolation weight for all channels
+      const double weight = (output_x[i] - input_x[input_index]) / (input_x[input_index + 1] - input_x[input_index]);
+      output_y.row(i) = input_y.row(input_index) + weight * (input_y.row(input_index + 1) - input_y.row(input_index));
+    }
+  }
+  return true;
+}
+
 inline bool resampleLinear(const std::vector<double>& input_x,
                            const std::vector<double>& input_y,
                            const std::vector<double>& output_x,
@@ -0,0 +1,227 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks    ...
+
+  \file   latency_histogram.h
+
+  \date   Oct 17, 2026
+
+ *********************************************************************/
+
+#ifndef USC_UTILITIES_LATENCY_HISTOGRAM_H_
+#define USC_UTILITIES_LATENCY_HISTOGRAM_H_
+
+// system includes
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#ifdef __XENO__
+#include <native/timer.h>
+#else
+#include <time.h>
+#endif
+
+// ros includes
+#include <ros/atomic.h>
+
+namespace usc_utilities
+{
+
+/*! Returns a monotonic time stamp in nanoseconds, usable from real-time code
+ */
+inline uint64_t getLatencyClockNanoSeconds()
+{
+#ifdef __XENO__
+  return static_cast<uint64_t> (rt_timer_tsc2ns(rt_timer_tsc()));
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<uint64_t> (now.tv_sec) * 1000000000ULL + static_cast<uint64_t> (now.tv_nsec);
+#endif
+}
+
+/*! Latency statistics of one histogram over the samples recorded since the previous snapshot.
+ * All times are in microseconds.
+ */
+struct LatencySnapshot
+{
+  LatencySnapshot() :
+    count(0), num_overruns(0), mean(0.0), p50(0.0), p99(0.0), max(0.0) {};
+
+  uint32_t count;
+  uint32_t num_overruns;
+  double mean;
+  double p50;
+  double p99;
+  double max;
+};
+
+/*! A fixed-bucket, lock-free latency histogram.
+ *
+ * Buckets are log-linear: every power of two of nanoseconds is split into 8 linear buckets, which
+ * bounds the relative error of a percentile to 12.5%. add() only performs relaxed atomic increments
+ * and never allocates or locks, so it can be called from real-time code (also from several threads).
+ * takeSnapshot() is meant to be called periodically from a single non real-time thread. It computes
+ * the statistics of the samples added since its previous call without ever resetting the counters
+ * the writers touch.
+ */
+class LatencyHistogram
+{
+
+public:
+
+  enum
+  {
+    NUM_SUB_BUCKETS_LOG2 = 3,
+    NUM_SUB_BUCKETS = 1 << NUM_SUB_BUCKETS_LOG2,
+    /// Latencies of 2^MAX_LOG2_NANO_SECONDS ns (about 18 minutes) and more end up in the last bucket
+    MAX_LOG2_NANO_SECONDS = 40,
+    NUM_BUCKETS = (MAX_LOG2_NANO_SECONDS - NUM_SUB_BUCKETS_LOG2 + 1) * NUM_SUB_BUCKETS
+  };
+
+  /*! Constructor
+   * @param name
+   * @param deadline_us Samples longer than this are counted as overruns. 0 disables the overrun count
+   */
+  LatencyHistogram(const std::string& name, const double deadline_us = 0.0);
+
+  /*! Destructor
+   */
+  virtual ~LatencyHistogram() {};
+
+  /*! Records a single latency
+   * @param latency_ns
+   * REAL-TIME REQUIREMENTS
+   */
+  inline void add(const uint64_t latency_ns)
+  {
+    buckets_[getBucketIndex(latency_ns)].fetch_add(1, ros::memory_order_relaxed);
+    sum_ns_.fetch_add(latency_ns, ros::memory_order_relaxed);
+    if (deadline_ns_ > 0 && latency_ns > deadline_ns_)
+    {
+      num_overruns_.fetch_add(1, ros::memory_order_relaxed);
+    }
+    uint64_t max_ns = max_ns_.load(ros::memory_order_relaxed);
+    while (latency_ns > max_ns && !max_ns_.compare_exchange_weak(max_ns, latency_ns, ros::memory_order_relaxed))
+    {
+    }
+  }
+
+  /*! Computes the statistics of all samples added since the previous call
+   * @param snapshot
+   * NOT REAL-TIME SAFE, call from a single thread only
+   */
+  void takeSnapshot(LatencySnapshot& snapshot);
+
+  /*!
+   * @return
+   */
+  const std::string& getName() const
+  {
+    return name_;
+  }
+
+  /*!
+   * @return deadline in microseconds, 0 if none is set
+   */
+  double getDeadline() const
+  {
+    return static_cast<double> (deadline_ns_) / 1000.0;
+  }
+
+  /*!
+   * @param latency_ns
+   * @return Index of the bucket latency_ns falls into
+   */
+  static inline int getBucketIndex(const uint64_t latency_ns)
+  {
+    if (latency_ns < static_cast<uint64_t> (NUM_SUB_BUCKETS))
+    {
+      return static_cast<int> (latency_ns);
+    }
+    if (latency_ns >= (1ULL << MAX_LOG2_NANO_SECONDS))
+    {
+      return NUM_BUCKETS - 1;
+    }
+    const int msb = 63 - __builtin_clzll(latency_ns);
+    const int shift = msb - NUM_SUB_BUCKETS_LOG2;
+    return (shift + 1) * NUM_SUB_BUCKETS + static_cast<int> ((latency_ns >> shift) & (NUM_SUB_BUCKETS - 1));
+  }
+
+  /*!
+   * @param bucket_index
+   * @return Smallest latency (in ns) that falls into bucket bucket_index
+   */
+  static inline uint64_t getBucketLowerBound(const int bucket_index)
+  {
+    if (bucket_index < NUM_SUB_BUCKETS)
+    {
+      return static_cast<uint64_t> (bucket_index);
+    }
+    const int shift = bucket_index / NUM_SUB_BUCKETS - 1;
+    return static_cast<uint64_t> (NUM_SUB_BUCKETS + bucket_index % NUM_SUB_BUCKETS) << shift;
+  }
+
+private:
+
+  /*!
+   */
+  std::string name_;
+  uint64_t deadline_ns_;
+
+  /*! Written by add()
+   */
+  ros::atomic_uint32_t buckets_[NUM_BUCKETS];
+  ros::atomic_uint64_t sum_ns_;
+  ros::atomic_uint32_t num_overruns_;
+  ros::atomic_uint64_t max_ns_;
+
+  /*! Counter values at the previous snapshot, only used by takeSnapshot()
+   */
+  std::vector<uint32_t> last_buckets_;
+  uint64_t last_sum_ns_;
+  uint32_t last_num_overruns_;
+
+};
+
+/*! Records the time spent in the enclosing scope into a LatencyHistogram, e.g.:
+\verbatim
+void update()
+{
+  usc_utilities::ScopedLatencyProbe probe(update_latency_);
+  ...
+}
+\endverbatim
+ * A NULL histogram disables the probe.
+ * REAL-TIME REQUIREMENTS
+ */
+class ScopedLatencyProbe
+{
+
+public:
+
+  explicit ScopedLatencyProbe(LatencyHistogram* histogram) :
+    histogram_(histogram), start_ns_(histogram ? getLatencyClockNanoSeconds() : 0) {};
+
+  ~ScopedLatencyProbe()
+  {
+    if (histogram_)
+    {
+      histogram_->add(getLatencyClockNanoSeconds() - start_ns_);
+    }
+  }
+
+private:
+
+  LatencyHistogram* histogram_;
+  uint64_t start_ns_;
+
+};
+
+}
+
+#endif /* USC_UTILITIES_LATENCY_HISTOGRAM_H_ */
@@ -0,0 +1,102 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks    ...
+
+  \file   latency_monitor.h
+
+  \date   Oct 17, 2026
+
+ *********************************************************************/
+
+#ifndef USC_UTILITIES_LATENCY_MONITOR_H_
+#define USC_UTILITIES_LATENCY_MONITOR_H_
+
+// system includes
+#include <string>
+#include <vector>
+
+// ros includes
+#include <ros/ros.h>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+// local includes
+#include <usc_utilities/latency_histogram.h>
+#include <usc_utilities/LatencyStatistics.h>
+
+namespace usc_utilities
+{
+
+/*! Owns a set of LatencyHistograms and publishes their statistics (count, mean, p50, p99, max and
+ * deadline overruns) from a non real-time thread on the topic "latency_statistics".
+ *
+ * Real-time code only ever touches the histograms returned by addHistogram(), usually through a
+ * ScopedLatencyProbe, so it never waits for the publishing thread.
+ */
+class LatencyMonitor
+{
+
+public:
+
+  /*! Constructor
+   */
+  LatencyMonitor() :
+    initialized_(false), publish_period_(1.0) {};
+
+  /*! Destructor
+   */
+  virtual ~LatencyMonitor();
+
+  /*! Advertises the statistics topic and starts the publishing thread
+   * @param node_handle
+   * @param publish_period in seconds
+   * @return True on success, otherwise False
+   */
+  bool initialize(ros::NodeHandle& node_handle,
+                  const double publish_period = 1.0);
+
+  /*! Adds a new histogram. The returned pointer stays valid as long as this monitor exists.
+   * @param name
+   * @param deadline_us Samples longer than this are counted as overruns. 0 disables the overrun count
+   * @return
+   * NOT REAL-TIME SAFE
+   */
+  LatencyHistogram* addHistogram(const std::string& name,
+                                 const double deadline_us = 0.0);
+
+  /*! Takes a snapshot of all histograms
+   * @param latency_statistics
+   * @return True on success, otherwise False
+   * NOT REAL-TIME SAFE
+   */
+  bool getLatencyStatistics(usc_utilities::LatencyStatistics& latency_statistics);
+
+private:
+
+  /*!
+   */
+  bool initialized_;
+  double publish_period_;
+
+  /*!
+   */
+  boost::mutex histograms_mutex_;
+  std::vector<boost::shared_ptr<LatencyHistogram> > histograms_;
+
+  /*!
+   */
+  ros::Publisher publisher_;
+  boost::thread publisher_thread_;
+
+  /*!
+   */
+  void publishThread();
+
+};
+
+}
+
+#endif /* USC_UTILITIES_LATENCY_MONITOR_H_ */
@@ -0,0 +1,86 @@
+/*********************************************************************
+ Computational Learning and Motor Control Lab
+ University of Southern California
+ Prof. Stefan Schaal
+ *********************************************************************
+ \remarks    ...
+
+ \file   latency_histogram.cpp
+
+ \date   Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <algorithm>
+
+// local includes
+#include <usc_utilities/latency_histogram.h>
+
+namespace usc_utilities
+{
+
+LatencyHistogram::LatencyHistogram(const std::string& name,
+                                   const double deadline_us) :
+  name_(name), deadline_ns_(static_cast<uint64_t> (std::max(deadline_us, 0.0) * 1000.0)),
+  last_buckets_(NUM_BUCKETS, 0), last_sum_ns_(0), last_num_overruns_(0)
+{
+  for (int i = 0; i < NUM_BUCKETS; ++i)
+  {
+    buckets_[i].store(0);
+  }
+  sum_ns_.store(0);
+  num_overruns_.store(0);
+  max_ns_.store(0);
+}
+
+void LatencyHistogram::takeSnapshot(LatencySnapshot& snapshot)
+{
+  // counters only ever increase (and wrap), the samples since the last snapshot are the differences
+  std::vector<uint32_t> counts(NUM_BUCKETS, 0);
+  uint32_t count = 0;
+  for (int i = 0; i < NUM_BUCKETS; ++i)
+  {
+    const uint32_t current = buckets_[i].load(ros::memory_order_relaxed);
+    counts[i] = current - last_buckets_[i];
+    last_buckets_[i] = current;
+    count += counts[i];
+  }
+  const uint64_t sum_ns = sum_ns_.load(ros::memory_order_relaxed);
+  const uint32_t num_overruns = num_overruns_.load(ros::memory_order_relaxed);
+  const uint64_t max_ns = max_ns_.exchange(0, ros::memory_order_relaxed);
+
+  snapshot = LatencySnapshot();
+  snapshot.count = count;
+  snapshot.num_overruns = num_overruns - last_num_overruns_;
+  if (count > 0)
+  {
+    snapshot.mean = static_cast<double> (sum_ns - last_sum_ns_) / (1000.0 * count);
+    snapshot.max = static_cast<double> (max_ns) / 1000.0;
+
+    // percentiles are reported as the upper bound of the bucket they fall into, but never above the max
+    const uint32_t rank_p50 = std::max((count + 1) / 2, 1u);
+    const uint32_t rank_p99 = std::max(static_cast<uint32_t> (0.99 * count + 0.5), 1u);
+    uint32_t cumulative = 0;
+    bool found_p50 = false;
+    for (int i = 0; i < NUM_BUCKETS; ++i)
+    {
+      cumulative += counts[i];
+      const double upper_bound_us = std::min(static_cast<double> (getBucketLowerBound(i + 1)) / 1000.0, snapshot.max);
+      if (!found_p50 && cumulative >= rank_p50)
+      {
+        snapshot.p50 = upper_bound_us;
+        found_p50 = true;
+      }
+      if (cumulative >= rank_p99)
+      {
+        snapshot.p99 = upper_bound_us;
+        break;
+      }
+    }
+  }
+  last_sum_ns_ = sum_ns;
+  last_num_overruns_ = num_overruns;
+}
+
+}
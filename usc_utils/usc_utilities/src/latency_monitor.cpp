@@ -0,0 +1,98 @@
+/*********************************************************************
+ Computational Learning and Motor Control Lab
+ University of Southern California
+ Prof. Stefan Schaal
+ *********************************************************************
+ \remarks    ...
+
+ \file   latency_monitor.cpp
+
+ \date   Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <boost/bind.hpp>
+
+// local includes
+#include <usc_utilities/latency_monitor.h>
+
+namespace usc_utilities
+{
+
+LatencyMonitor::~LatencyMonitor()
+{
+  publisher_thread_.interrupt();
+  publisher_thread_.join();
+}
+
+bool LatencyMonitor::initialize(ros::NodeHandle& node_handle,
+                                const double publish_period)
+{
+  if (initialized_)
+  {
+    ROS_WARN("Latency monitor already initialized.");
+    return true;
+  }
+  if (publish_period <= 0.0)
+  {
+    ROS_ERROR("Invalid latency publish period >%f<.", publish_period);
+    return false;
+  }
+  publish_period_ = publish_period;
+  publisher_ = node_handle.advertise<usc_utilities::LatencyStatistics> ("latency_statistics", 10);
+  publisher_thread_ = boost::thread(boost::bind(&LatencyMonitor::publishThread, this));
+  return (initialized_ = true);
+}
+
+LatencyHistogram* LatencyMonitor::addHistogram(const std::string& name,
+                                               const double deadline_us)
+{
+  boost::shared_ptr<LatencyHistogram> histogram(new LatencyHistogram(name, deadline_us));
+  boost::mutex::scoped_lock lock(histograms_mutex_);
+  histograms_.push_back(histogram);
+  return histogram.get();
+}
+
+bool LatencyMonitor::getLatencyStatistics(usc_utilities::LatencyStatistics& latency_statistics)
+{
+  boost::mutex::scoped_lock lock(histograms_mutex_);
+  latency_statistics.header.stamp = ros::Time::now();
+  latency_statistics.probes.resize(histograms_.size());
+  for (int i = 0; i < (int)histograms_.size(); ++i)
+  {
+    LatencySnapshot snapshot;
+    histograms_[i]->takeSnapshot(snapshot);
+    usc_utilities::LatencyProbeStatistics& probe = latency_statistics.probes[i];
+    probe.name = histograms_[i]->getName();
+    probe.count = snapshot.count;
+    probe.num_overruns = snapshot.num_overruns;
+    probe.deadline = histograms_[i]->getDeadline();
+    probe.mean = snapshot.mean;
+    probe.p50 = snapshot.p50;
+    probe.p99 = snapshot.p99;
+    probe.max = snapshot.max;
+  }
+  return true;
+}
+
+void LatencyMonitor::publishThread()
+{
+  usc_utilities::LatencyStatistics latency_statistics;
+  try
+  {
+    while (true)
+    {
+      boost::this_thread::sleep(boost::posix_time::microseconds(static_cast<long> (publish_period_ * 1e6)));
+      if (getLatencyStatistics(latency_statistics) && !latency_statistics.probes.empty())
+      {
+        publisher_.publish(latency_statistics);
+      }
+    }
+  }
+  catch (boost::thread_interrupted&)
+  {
+  }
+}
+
+}
@@ -0,0 +1,155 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks		...
+
+  \file		bspline_test.cpp
+
+  \date		Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+#include <cmath>
+#include <vector>
+
+// local includes
+#include <gtest/gtest.h>
+#include <usc_utilities/bspline.h>
+
+using namespace usc_utilities;
+
+static const int NUM_ROWS = 300;
+static const int NUM_CHANNELS = 5;
+static const int NUM_SAMPLES = 100;
+
+void setupInput(std::vector<double>& input_vector,
+                Eigen::MatrixXd& target_matrix,
+                std::vector<double>& input_querry)
+{
+  input_vector.resize(NUM_ROWS);
+  target_matrix.resize(NUM_ROWS, NUM_CHANNELS);
+  for (int i = 0; i < NUM_ROWS; ++i)
+  {
+    // slightly irregular time stamps
+    input_vector[i] = 1.0 + 0.01 * static_cast<double> (i) + 0.002 * std::sin(static_cast<double> (i));
+    for (int c = 0; c < NUM_CHANNELS; ++c)
+    {
+      target_matrix(i, c) = std::sin(static_cast<double> (c + 1) * input_vector[i]) + static_cast<double> (c);
+    }
+  }
+  input_querry.resize(NUM_SAMPLES);
+  for (int s = 0; s < NUM_SAMPLES; ++s)
+  {
+    input_querry[s] = input_vector.front() + (input_vector.back() - input_vector.front()) * static_cast<double> (s) / static_cast<double> (NUM_SAMPLES - 1);
+  }
+}
+
+std::vector<double> getColumn(const Eigen::MatrixXd& matrix, const int c)
+{
+  std::vector<double> column(matrix.rows());
+  for (int i = 0; i < (int)matrix.rows(); ++i)
+  {
+    column[i] = matrix(i, c);
+  }
+  return column;
+}
+
+TEST(UscUtilitiesBSpline, multiChannelLinearMatchesSingleChannel)
+{
+  std::vector<double> input_vector;
+  Eigen::MatrixXd target_matrix;
+  std::vector<double> input_querry;
+  setupInput(input_vector, target_matrix, input_querry);
+
+  Eigen::MatrixXd output_matrix;
+  EXPECT_TRUE(resample(input_vector, target_matrix, 0.0, input_querry, output_matrix, LINEAR_RESAMPLING));
+  ASSERT_EQ(NUM_SAMPLES, (int)output_matrix.rows());
+  ASSERT_EQ(NUM_CHANNELS, (int)output_matrix.cols());
+
+  for (int c = 0; c < NUM_CHANNELS; ++c)
+  {
+    std::vector<double> output_vector;
+    EXPECT_TRUE(resampleLinearNoBounds(input_vector, getColumn(target_matrix, c), input_querry, output_vector));
+    for (int s = 0; s < NUM_SAMPLES; ++s)
+    {
+      EXPECT_NEAR(output_vector[s], output_matrix(s, c), 1e-10);
+    }
+  }
+}
+
+TEST(UscUtilitiesBSpline, multiChannelBSplineMatchesSingleChannel)
+{
+  std::vector<double> input_vector;
+  Eigen::MatrixXd target_matrix;
+  std::vector<double> input_querry;
+  setupInput(input_vector, target_matrix, input_querry);
+  const double wave_length = 2.0 * (input_querry[1] - input_querry[0]);
+
+  Eigen::MatrixXd output_matrix;
+  EXPECT_TRUE(resample(input_vector, target_matrix, wave_length, input_querry, output_matrix, BSPLINE_RESAMPLING));
+  ASSERT_EQ(NUM_SAMPLES, (int)output_matrix.rows());
+  ASSERT_EQ(NUM_CHANNELS, (int)output_matrix.cols());
+
+  for (int c = 0; c < NUM_CHANNELS; ++c)
+  {
+    std::vector<double> output_vector;
+    EXPECT_TRUE(resample(input_vector, getColumn(target_matrix, c), wave_length, input_querry, output_vector, false));
+    for (int s = 0; s < NUM_SAMPLES; ++s)
+    {
+      EXPECT_NEAR(output_vector[s], output_matrix(s, c), 1e-10);
+    }
+  }
+}
+
+TEST(UscUtilitiesBSpline, multiChannelBSplineRemovesInvalidData)
+{
+  std::vector<double> input_vector;
+  Eigen::MatrixXd target_matrix;
+  std::vector<double> input_querry;
+  setupInput(input_vector, target_matrix, input_querry);
+  const double wave_length = 2.0 * (input_querry[1] - input_querry[0]);
+
+  // invalidate a few data points (zero time stamps) and corrupt their values
+  std::vector<double> invalid_input_vector = input_vector;
+  Eigen::MatrixXd invalid_target_matrix = target_matrix;
+  const int invalid_indices[] = {0, 17, 18, 150, NUM_ROWS - 1};
+  for (int i = 0; i < (int)(sizeof(invalid_indices) / sizeof(invalid_indices[0])); ++i)
+  {
+    invalid_input_vector[invalid_indices[i]] = 0.0;
+    invalid_target_matrix.row(invalid_indices[i]).setConstant(1e6);
+  }
+
+  // reference: the valid data only
+  std::vector<double> valid_input_vector;
+  std::vector<int> valid_rows;
+  for (int i = 0; i < NUM_ROWS; ++i)
+  {
+    if (invalid_input_vector[i] > 0.0)
+    {
+      valid_input_vector.push_back(input_vector[i]);
+      valid_rows.push_back(i);
+    }
+  }
+  Eigen::MatrixXd valid_target_matrix((int)valid_rows.size(), NUM_CHANNELS);
+  for (int i = 0; i < (int)valid_rows.size(); ++i)
+  {
+    valid_target_matrix.row(i) = target_matrix.row(valid_rows[i]);
+  }
+
+  Eigen::MatrixXd output_matrix;
+  EXPECT_TRUE(resample(invalid_input_vector, invalid_target_matrix, wave_length, input_querry, output_matrix, BSPLINE_RESAMPLING));
+  Eigen::MatrixXd expected_output_matrix;
+  EXPECT_TRUE(resample(valid_input_vector, valid_target_matrix, wave_length, input_querry, expected_output_matrix, BSPLINE_RESAMPLING));
+  ASSERT_EQ(NUM_SAMPLES, (int)output_matrix.rows());
+  ASSERT_EQ(NUM_CHANNELS, (int)output_matrix.cols());
+  for (int c = 0; c < NUM_CHANNELS; ++c)
+  {
+    for (int s = 0; s < NUM_SAMPLES; ++s)
+    {
+      EXPECT_NEAR(expected_output_matrix(s, c), output_matrix(s, c), 1e-10);
+    }
+  }
+}
@@ -0,0 +1,84 @@
+/*********************************************************************
+  Computational Learning and Motor Control Lab
+  University of Southern California
+  Prof. Stefan Schaal
+ *********************************************************************
+  \remarks		...
+
+  \file		latency_histogram_test.cpp
+
+  \date		Oct 17, 2026
+
+ *********************************************************************/
+
+// system includes
+
+// local includes
+#include <gtest/gtest.h>
+#include <usc_utilities/latency_histogram.h>
+
+using namespace usc_utilities;
+
+TEST(UscUtilitiesLatencyHistogram, bucketBounds)
+{
+  // every latency falls into the bucket whose bounds enclose it
+  for (uint64_t latency_ns = 0; latency_ns < 100000; latency_ns += 7)
+  {
+    const int index = LatencyHistogram::getBucketIndex(latency_ns);
+    ASSERT_GE(index, 0);
+    ASSERT_LT(index, static_cast<int>(LatencyHistogram::NUM_BUCKETS));
+    EXPECT_LE(LatencyHistogram::getBucketLowerBound(index), latency_ns);
+    EXPECT_GT(LatencyHistogram::getBucketLowerBound(index + 1), latency_ns);
+  }
+  EXPECT_EQ(LatencyHistogram::getBucketIndex(1ULL << 62), static_cast<int>(LatencyHistogram::NUM_BUCKETS) - 1);
+}
+
+TEST(UscUtilitiesLatencyHistogram, snapshot)
+{
+  LatencyHistogram histogram("test", 500.0);
+
+  // 1..1000 us
+  for (uint64_t i = 1; i <= 1000; ++i)
+  {
+    histogram.add(i * 1000);
+  }
+
+  LatencySnapshot snapshot;
+  histogram.takeSnapshot(snapshot);
+  EXPECT_EQ(snapshot.count, 1000u);
+  EXPECT_EQ(snapshot.num_overruns, 500u);
+  EXPECT_NEAR(snapshot.mean, 500.5, 1e-9);
+  EXPECT_NEAR(snapshot.max, 1000.0, 1e-9);
+  // percentiles are accurate up to the bucket width (12.5%)
+  EXPECT_GE(snapshot.p50, 500.0);
+  EXPECT_LE(snapshot.p50, 500.0 * 1.125);
+  EXPECT_GE(snapshot.p99, 990.0);
+  EXPECT_LE(snapshot.p99, 1000.0);
+
+  // only samples added after the previous snapshot are reported
+  histogram.add(42000);
+  histogram.takeSnapshot(snapshot);
+  EXPECT_EQ(snapshot.count, 1u);
+  EXPECT_EQ(snapshot.num_overruns, 0u);
+  EXPECT_NEAR(snapshot.mean, 42.0, 1e-9);
+  EXPECT_NEAR(snapshot.max, 42.0, 1e-9);
+  EXPECT_NEAR(snapshot.p50, 42.0, 1e-9);
+  EXPECT_NEAR(snapshot.p99, 42.0, 1e-9);
+
+  histogram.takeSnapshot(snapshot);
+  EXPECT_EQ(snapshot.count, 0u);
+}
+
+TEST(UscUtilitiesLatencyHistogram, scopedProbe)
+{
+  LatencyHistogram histogram("test");
+  {
+    ScopedLatencyProbe probe(&histogram);
+  }
+  {
+    ScopedLatencyProbe disabled_probe(NULL);
+  }
+  LatencySnapshot snapshot;
+  histogram.takeSnapshot(snapshot);
+  EXPECT_EQ(snapshot.count, 1u);
+}